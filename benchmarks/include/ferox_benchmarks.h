@@ -0,0 +1,63 @@
+/*
+    Copyright (c) 2021-2025 Jaedeok Kim <jdeokkim@protonmail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a 
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation 
+    the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+    and/or sell copies of the Software, and to permit persons to whom the 
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included 
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef FEROX_BENCHMARKS_H
+#define FEROX_BENCHMARKS_H
+
+/* Includes ===============================================================> */
+
+#include "ferox.h"
+
+/* Typedefs ===============================================================> */
+
+/* A structure that represents a benchmark scene. */
+typedef struct BenchScene_ {
+    const char *name;
+    int stepCount;
+    frWorld *(*create)(frBroadPhaseType type);
+    void (*update)(frWorld *world, int step);
+} BenchScene;
+
+/* A structure that represents a microbenchmark of a single function. */
+typedef struct BenchKernel_ {
+    const char *name;
+    frShapeType type;
+    int vertexCount;
+    bool overlapping;
+    void (*setup)(const struct BenchKernel_ *kernel);
+    int (*run)(int count);
+    void (*teardown)(void);
+} BenchKernel;
+
+/* Public Function Prototypes =============================================> */
+
+/* Returns the kernels, and stores the number of kernels to `count`. */
+const BenchKernel *GetCollisionKernels(int *count);
+
+/* Returns the world scenes, and stores the number of scenes to `count`. */
+const BenchScene *GetWorldScenes(int *count);
+
+/* Releases `world` and the shapes of all bodies in `world`. */
+void ReleaseSceneWorld(frWorld *world);
+
+#endif  // `FEROX_BENCHMARKS_H`
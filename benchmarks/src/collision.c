@@ -0,0 +1,314 @@
+/*
+    Copyright (c) 2021-2025 Jaedeok Kim <jdeokkim@protonmail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a 
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation 
+    the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+    and/or sell copies of the Software, and to permit persons to whom the 
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included 
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/* Includes ===============================================================> */
+
+#include "ferox_benchmarks.h"
+
+/* Macros =================================================================> */
+
+#define CASE_COUNT  256
+
+/* Constants ==============================================================> */
+
+static const frMaterial MATERIAL = { .density = 1.0f, .friction = 0.5f };
+
+/* Private Variables ======================================================> */
+
+static unsigned int seed = 0x5EEDu;
+
+static frBody *bodies[2][CASE_COUNT];
+
+static frRay rays[CASE_COUNT];
+
+static frVertices vertices[CASE_COUNT];
+
+/* Private Function Prototypes ============================================> */
+
+static void SetupCollision(const BenchKernel *kernel);
+
+static void SetupRaycast(const BenchKernel *kernel);
+
+static void SetupShapes(const BenchKernel *kernel);
+
+static int RunCollision(int count);
+
+static int RunRaycast(int count);
+
+static int RunShapeAABB(int count);
+
+static int RunPolygonVertices(int count);
+
+static void Teardown(void);
+
+static frBody *CreateRandomBody(frShapeType type,
+                                int vertexCount,
+                                frVector2 position);
+
+static void GetRandomVertices(frVertices *vertices, int vertexCount);
+
+static float GetRandomValue(float min, float max);
+
+/* Public Functions =======================================================> */
+
+/* Returns the kernels, and stores the number of kernels to `count`. */
+const BenchKernel *GetCollisionKernels(int *count) {
+#define COLLISION_KERNEL(name_, type_, vertexCount_, overlapping_)  \
+    { .name = "collision." name_,                                    \
+      .type = (type_),                                               \
+      .vertexCount = (vertexCount_),                                 \
+      .overlapping = (overlapping_),                                 \
+      .setup = SetupCollision,                                       \
+      .run = RunCollision,                                           \
+      .teardown = Teardown }
+
+    // NOTE: A polygon kernel with no vertex count uses 3 to 8 vertices
+    static const BenchKernel kernels[] = {
+        COLLISION_KERNEL("circle_circle.overlap", FR_SHAPE_CIRCLE, 0, true),
+        COLLISION_KERNEL("circle_circle.separated", FR_SHAPE_CIRCLE, 0, false),
+        COLLISION_KERNEL("circle_poly.overlap", FR_SHAPE_UNKNOWN, 0, true),
+        COLLISION_KERNEL("circle_poly.separated", FR_SHAPE_UNKNOWN, 0, false),
+        COLLISION_KERNEL("poly3_poly3.overlap", FR_SHAPE_POLYGON, 3, true),
+        COLLISION_KERNEL("poly3_poly3.separated", FR_SHAPE_POLYGON, 3, false),
+        COLLISION_KERNEL("poly4_poly4.overlap", FR_SHAPE_POLYGON, 4, true),
+        COLLISION_KERNEL("poly4_poly4.separated", FR_SHAPE_POLYGON, 4, false),
+        COLLISION_KERNEL("poly5_poly5.overlap", FR_SHAPE_POLYGON, 5, true),
+        COLLISION_KERNEL("poly5_poly5.separated", FR_SHAPE_POLYGON, 5, false),
+        COLLISION_KERNEL("poly6_poly6.overlap", FR_SHAPE_POLYGON, 6, true),
+        COLLISION_KERNEL("poly6_poly6.separated", FR_SHAPE_POLYGON, 6, false),
+        COLLISION_KERNEL("poly7_poly7.overlap", FR_SHAPE_POLYGON, 7, true),
+        COLLISION_KERNEL("poly7_poly7.separated", FR_SHAPE_POLYGON, 7, false),
+        COLLISION_KERNEL("poly8_poly8.overlap", FR_SHAPE_POLYGON, 8, true),
+        COLLISION_KERNEL("poly8_poly8.separated", FR_SHAPE_POLYGON, 8, false),
+        { .name = "raycast.circle",
+          .type = FR_SHAPE_CIRCLE,
+          .setup = SetupRaycast,
+          .run = RunRaycast,
+          .teardown = Teardown },
+        { .name = "raycast.polygon",
+          .type = FR_SHAPE_POLYGON,
+          .setup = SetupRaycast,
+          .run = RunRaycast,
+          .teardown = Teardown },
+        { .name = "aabb.circle",
+          .type = FR_SHAPE_CIRCLE,
+          .setup = SetupShapes,
+          .run = RunShapeAABB,
+          .teardown = Teardown },
+        { .name = "aabb.polygon",
+          .type = FR_SHAPE_POLYGON,
+          .setup = SetupShapes,
+          .run = RunShapeAABB,
+          .teardown = Teardown },
+        { .name = "vertices.polygon",
+          .type = FR_SHAPE_POLYGON,
+          .setup = SetupShapes,
+          .run = RunPolygonVertices,
+          .teardown = Teardown }
+    };
+
+#undef COLLISION_KERNEL
+
+    if (count != NULL) *count = sizeof kernels / sizeof *kernels;
+
+    return kernels;
+}
+
+/* Private Functions ======================================================> */
+
+static void SetupCollision(const BenchKernel *kernel) {
+    seed = 0x5EEDu;
+
+    for (int i = 0; i < CASE_COUNT; i++) {
+        frShapeType type1 = kernel->type, type2 = kernel->type;
+
+        // NOTE: Circle-polygon pairs are tested in both orders
+        if (type1 == FR_SHAPE_UNKNOWN) {
+            type1 = (i & 1) ? FR_SHAPE_CIRCLE : FR_SHAPE_POLYGON;
+            type2 = (i & 1) ? FR_SHAPE_POLYGON : FR_SHAPE_CIRCLE;
+        }
+
+        bodies[0][i] = CreateRandomBody(type1,
+                                        kernel->vertexCount,
+                                        frStructZero(frVector2));
+
+        /*
+            NOTE: The bounding circle of every shape has a radius 
+            between 0.5 and 1.0, so two shapes whose centers are closer 
+            than 0.5 always overlap, and those farther than 2.0 never do.
+        */
+        float distance = kernel->overlapping ? GetRandomValue(0.0f, 0.5f)
+                                             : GetRandomValue(2.5f, 4.0f);
+
+        float angle = GetRandomValue(0.0f, 2.0f * M_PI);
+
+        bodies[1][i] = CreateRandomBody(type2,
+                                        kernel->vertexCount,
+                                        (frVector2) {
+                                            .x = distance * cosf(angle),
+                                            .y = distance * sinf(angle) });
+    }
+}
+
+static void SetupRaycast(const BenchKernel *kernel) {
+    seed = 0x5EEDu;
+
+    for (int i = 0; i < CASE_COUNT; i++) {
+        bodies[0][i] = CreateRandomBody(kernel->type,
+                                        kernel->vertexCount,
+                                        frStructZero(frVector2));
+
+        float angle = GetRandomValue(0.0f, 2.0f * M_PI);
+
+        // NOTE: About half of the rays miss the shape
+        rays[i] = (frRay) {
+            .origin = { .x = -4.0f * cosf(angle), .y = -4.0f * sinf(angle) },
+            .direction = { .x = cosf(angle) + GetRandomValue(-0.2f, 0.2f),
+                           .y = sinf(angle) + GetRandomValue(-0.2f, 0.2f) },
+            .maxDistance = 8.0f
+        };
+    }
+}
+
+static void SetupShapes(const BenchKernel *kernel) {
+    seed = 0x5EEDu;
+
+    for (int i = 0; i < CASE_COUNT; i++) {
+        bodies[0][i] = CreateRandomBody(kernel->type,
+                                        kernel->vertexCount,
+                                        frStructZero(frVector2));
+
+        GetRandomVertices(&vertices[i], 3 + (i % 6));
+    }
+}
+
+static int RunCollision(int count) {
+    int result = 0;
+
+    for (int i = 0; i < count; i++) {
+        frCollision collision = { .count = 0 };
+
+        int j = i & (CASE_COUNT - 1);
+
+        (void) frComputeCollision(bodies[0][j], bodies[1][j], &collision);
+
+        result += collision.count;
+    }
+
+    return result;
+}
+
+static int RunRaycast(int count) {
+    int result = 0;
+
+    for (int i = 0; i < count; i++) {
+        frRaycastHit raycastHit = { .distance = 0.0f };
+
+        int j = i & (CASE_COUNT - 1);
+
+        result += frComputeRaycast(bodies[0][j], rays[j], &raycastHit);
+    }
+
+    return result;
+}
+
+static int RunShapeAABB(int count) {
+    float result = 0.0f;
+
+    for (int i = 0; i < count; i++) {
+        const frBody *b = bodies[0][i & (CASE_COUNT - 1)];
+
+        result += frGetShapeAABB(frGetBodyShape(b), frGetBodyTransform(b))
+                      .width;
+    }
+
+    return (int) result;
+}
+
+static int RunPolygonVertices(int count) {
+    for (int i = 0; i < count; i++) {
+        int j = i & (CASE_COUNT - 1);
+
+        frSetPolygonVertices(frGetBodyShape(bodies[0][j]), &vertices[j]);
+    }
+
+    return count;
+}
+
+static void Teardown(void) {
+    for (int i = 0; i < 2; i++)
+        for (int j = 0; j < CASE_COUNT; j++) {
+            if (bodies[i][j] == NULL) continue;
+
+            frReleaseShape(frGetBodyShape(bodies[i][j]));
+            frReleaseBody(bodies[i][j]);
+
+            bodies[i][j] = NULL;
+        }
+}
+
+static frBody *CreateRandomBody(frShapeType type,
+                                int vertexCount,
+                                frVector2 position) {
+    frShape *s = NULL;
+
+    if (type == FR_SHAPE_CIRCLE) {
+        s = frCreateCircle(MATERIAL, GetRandomValue(0.5f, 1.0f));
+    } else {
+        frVertices vertices = { .count = 0 };
+
+        GetRandomVertices(&vertices,
+                          (vertexCount > 0) ? vertexCount
+                                            : 3 + (seed >> 16) % 6);
+
+        s = frCreatePolygon(MATERIAL, &vertices);
+    }
+
+    frBody *b = frCreateBodyFromShape(FR_BODY_DYNAMIC, position, s);
+
+    frSetBodyAngle(b, GetRandomValue(0.0f, 2.0f * M_PI));
+
+    return b;
+}
+
+static void GetRandomVertices(frVertices *vertices, int vertexCount) {
+    vertices->count = vertexCount;
+
+    float radius = GetRandomValue(0.5f, 1.0f);
+
+    // NOTE: Points on a circle always form a convex polygon
+    for (int i = 0; i < vertexCount; i++) {
+        float angle = (2.0f * M_PI * (i + GetRandomValue(0.0f, 0.5f)))
+                      / vertexCount;
+
+        vertices->data[i] = (frVector2) { .x = radius * cosf(angle),
+                                          .y = radius * sinf(angle) };
+    }
+}
+
+static float GetRandomValue(float min, float max) {
+    // NOTE: https://en.wikipedia.org/wiki/Linear_congruential_generator
+    seed = (1103515245u * seed) + 12345u;
+
+    return min + (max - min) * ((seed >> 16) & 0x7FFF) / 32767.0f;
+}
@@ -0,0 +1,414 @@
+/*
+    Copyright (c) 2021-2025 Jaedeok Kim <jdeokkim@protonmail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a 
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation 
+    the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+    and/or sell copies of the Software, and to permit persons to whom the 
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included 
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/* Includes ===============================================================> */
+
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+    #define PSAPI_VERSION 2
+
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+#include "ferox_benchmarks.h"
+
+/* Macros =================================================================> */
+
+#define KERNEL_CALL_COUNT    (1 << 16)
+#define KERNEL_REPEAT_COUNT  5
+#define MAX_BASELINE_COUNT   256
+#define MAX_FILTER_COUNT     64
+#define MAX_NAME_LENGTH      64
+
+/* Typedefs ===============================================================> */
+
+/* A structure that represents the result of a benchmark scene. */
+typedef struct BenchResult_ {
+    const char *name;
+    frBroadPhaseType type;
+    int bodyCount, stepCount;
+    double totalTime, maxStepTime;
+    long peakMemory;
+} BenchResult;
+
+/* A structure that represents the result of a kernel. */
+typedef struct KernelResult_ {
+    const char *name;
+    double nsPerCall, baselineNsPerCall;
+    bool regressed;
+} KernelResult;
+
+/* A structure that represents the cost of a kernel in a baseline file. */
+typedef struct BaselineEntry_ {
+    char name[MAX_NAME_LENGTH];
+    double nsPerCall;
+} BaselineEntry;
+
+/* Constants ==============================================================> */
+
+static const float DELTA_TIME = 1.0f / 60.0f;
+
+static const char *BROAD_PHASE_NAMES[] = { "unknown",
+                                           "spatial_hash",
+                                           "dynamic_tree",
+                                           "sweep_and_prune" };
+
+/* Private Variables ======================================================> */
+
+static const char *filters[MAX_FILTER_COUNT];
+
+static int filterCount;
+
+static BaselineEntry baseline[MAX_BASELINE_COUNT];
+
+static int baselineCount;
+
+// NOTE: A kernel that got slower by more than this percentage is flagged
+static double threshold = 10.0;
+
+// NOTE: Keeps the compiler from removing the calls to each kernel
+static volatile int sink;
+
+/* Private Function Prototypes ============================================> */
+
+/* Steps a `scene` with the broad-phase `type`, then returns its result. */
+static BenchResult RunScene(const BenchScene *scene, frBroadPhaseType type);
+
+/* Times a `kernel`, then returns its result. */
+static KernelResult RunKernel(const BenchKernel *kernel);
+
+/* Prints `result` as a JSON object. */
+static void PrintResult(const BenchResult *result, bool last);
+
+/* Prints the `result` of a kernel as a JSON object. */
+static void PrintKernelResult(const KernelResult *result, bool last);
+
+/* 
+    Reads the cost of each kernel from a file at `path`, 
+    which must be the output of a previous run.
+*/
+static bool LoadBaseline(const char *path);
+
+/* 
+    Returns `true` if a `name` in the given `category` 
+    matches any of the filters. 
+*/
+static bool IsSelected(const char *category, const char *name);
+
+/* Returns the peak memory usage of this process, in kilobytes. */
+static long GetPeakMemoryUsage(void);
+
+/* Public Functions =======================================================> */
+
+/*
+    Usage: `ferox_benchmarks.out [--baseline <file>] [--threshold <percent>] 
+                                 [scenes | kernels | <name prefix>...]`
+*/
+int main(int argc, char *argv[]) {
+    const char *baselinePath = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc)
+            baselinePath = argv[++i];
+        else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc)
+            threshold = atof(argv[++i]);
+        else if (filterCount < MAX_FILTER_COUNT)
+            filters[filterCount++] = argv[i];
+    }
+
+    if (baselinePath != NULL && !LoadBaseline(baselinePath)) {
+        fprintf(stderr, "could not read the baseline '%s'\n", baselinePath);
+
+        return 1;
+    }
+
+    int sceneCount = 0, kernelCount = 0;
+
+    const BenchScene *scenes = GetWorldScenes(&sceneCount);
+    const BenchKernel *kernels = GetCollisionKernels(&kernelCount);
+
+    int selectedSceneCount = 0, selectedKernelCount = 0;
+
+    for (int i = 0; i < sceneCount; i++)
+        if (IsSelected("scenes", scenes[i].name)) selectedSceneCount++;
+
+    for (int i = 0; i < kernelCount; i++)
+        if (IsSelected("kernels", kernels[i].name)) selectedKernelCount++;
+
+    printf("{\n");
+    printf("  \"version\": \"%s\",\n", FR_API_VERSION);
+    printf("  \"results\": [\n");
+
+    for (int i = 0, k = 0; i < sceneCount; i++) {
+        if (!IsSelected("scenes", scenes[i].name)) continue;
+
+        k++;
+
+        for (frBroadPhaseType type = FR_BROAD_PHASE_SPATIAL_HASH;
+             type <= FR_BROAD_PHASE_SWEEP_AND_PRUNE;
+             type++) {
+            fprintf(stderr,
+                    "running '%s' (%s)...\n",
+                    scenes[i].name,
+                    BROAD_PHASE_NAMES[type]);
+
+            BenchResult result = RunScene(&scenes[i], type);
+
+            PrintResult(&result,
+                        (k == selectedSceneCount)
+                            && (type == FR_BROAD_PHASE_SWEEP_AND_PRUNE));
+        }
+    }
+
+    printf("  ],\n");
+    printf("  \"kernels\": [\n");
+
+    int regressionCount = 0;
+
+    for (int i = 0, k = 0; i < kernelCount; i++) {
+        if (!IsSelected("kernels", kernels[i].name)) continue;
+
+        k++;
+
+        fprintf(stderr, "running '%s'...\n", kernels[i].name);
+
+        KernelResult result = RunKernel(&kernels[i]);
+
+        if (result.regressed) {
+            fprintf(stderr,
+                    "'%s' got slower: %.2f ns -> %.2f ns\n",
+                    result.name,
+                    result.baselineNsPerCall,
+                    result.nsPerCall);
+
+            regressionCount++;
+        }
+
+        PrintKernelResult(&result, k == selectedKernelCount);
+    }
+
+    printf("  ],\n");
+    printf("  \"threshold_percent\": %.2f,\n", threshold);
+    printf("  \"regressions\": %d\n", regressionCount);
+    printf("}\n");
+
+    return (regressionCount > 0) ? 1 : 0;
+}
+
+/* Private Functions ======================================================> */
+
+/* Steps a `scene` with the broad-phase `type`, then returns its result. */
+static BenchResult RunScene(const BenchScene *scene, frBroadPhaseType type) {
+    BenchResult result = { .name = scene->name,
+                           .type = type,
+                           .stepCount = scene->stepCount };
+
+    frWorld *world = scene->create(type);
+
+    // NOTE: The bodies of a scene will be added at the end of the first step
+    frStepWorld(world, DELTA_TIME);
+
+    result.bodyCount = frGetBodyCountInWorld(world);
+
+    for (int i = 0; i < scene->stepCount; i++) {
+        unsigned long long startTicks = frGetCurrentTicks();
+
+        if (scene->update != NULL) scene->update(world, i);
+
+        frStepWorld(world, DELTA_TIME);
+
+        double stepTime = 1e-6 * (frGetCurrentTicks() - startTicks);
+
+        if (result.maxStepTime < stepTime) result.maxStepTime = stepTime;
+
+        result.totalTime += stepTime;
+    }
+
+    result.peakMemory = GetPeakMemoryUsage();
+
+    ReleaseSceneWorld(world);
+
+    return result;
+}
+
+/* Times a `kernel`, then returns its result. */
+static KernelResult RunKernel(const BenchKernel *kernel) {
+    KernelResult result = { .name = kernel->name, .nsPerCall = DBL_MAX };
+
+    kernel->setup(kernel);
+
+    // NOTE: Warms up the caches and the branch predictor first
+    sink += kernel->run(KERNEL_CALL_COUNT >> 4);
+
+    // NOTE: The fastest run is the one least disturbed by other processes
+    for (int i = 0; i < KERNEL_REPEAT_COUNT; i++) {
+        unsigned long long startTicks = frGetCurrentTicks();
+
+        sink += kernel->run(KERNEL_CALL_COUNT);
+
+        double nsPerCall = (double) (frGetCurrentTicks() - startTicks)
+                           / KERNEL_CALL_COUNT;
+
+        if (result.nsPerCall > nsPerCall) result.nsPerCall = nsPerCall;
+    }
+
+    kernel->teardown();
+
+    for (int i = 0; i < baselineCount; i++) {
+        if (strcmp(baseline[i].name, kernel->name) != 0) continue;
+
+        result.baselineNsPerCall = baseline[i].nsPerCall;
+
+        result.regressed = result.nsPerCall
+                           > result.baselineNsPerCall
+                                 * (1.0 + 0.01 * threshold);
+
+        break;
+    }
+
+    return result;
+}
+
+/* Prints `result` as a JSON object. */
+static void PrintResult(const BenchResult *result, bool last) {
+    double msPerStep = result->totalTime / result->stepCount;
+
+    printf("    {\n");
+    printf("      \"scene\": \"%s\",\n", result->name);
+    printf("      \"broad_phase\": \"%s\",\n",
+           BROAD_PHASE_NAMES[result->type]);
+    printf("      \"bodies\": %d,\n", result->bodyCount);
+    printf("      \"steps\": %d,\n", result->stepCount);
+    printf("      \"ms_per_step\": %.4f,\n", msPerStep);
+    printf("      \"max_ms_per_step\": %.4f,\n", result->maxStepTime);
+    printf("      \"steps_per_sec\": %.2f,\n",
+           (msPerStep > 0.0) ? 1000.0 / msPerStep : 0.0);
+    printf("      \"peak_memory_kb\": %ld\n", result->peakMemory);
+    printf("    }%s\n", last ? "" : ",");
+}
+
+/* Prints the `result` of a kernel as a JSON object. */
+static void PrintKernelResult(const KernelResult *result, bool last) {
+    printf("    {\n");
+    printf("      \"kernel\": \"%s\",\n", result->name);
+    printf("      \"calls\": %d,\n", KERNEL_CALL_COUNT);
+
+    if (result->baselineNsPerCall > 0.0) {
+        printf("      \"baseline_ns_per_call\": %.4f,\n",
+               result->baselineNsPerCall);
+        printf("      \"change_percent\": %.2f,\n",
+               100.0 * (result->nsPerCall / result->baselineNsPerCall - 1.0));
+    }
+
+    printf("      \"regressed\": %s,\n", result->regressed ? "true" : "false");
+    printf("      \"ns_per_call\": %.4f\n", result->nsPerCall);
+    printf("    }%s\n", last ? "" : ",");
+}
+
+/* 
+    Reads the cost of each kernel from a file at `path`, 
+    which must be the output of a previous run.
+*/
+static bool LoadBaseline(const char *path) {
+    FILE *fp = fopen(path, "r");
+
+    if (fp == NULL) return false;
+
+    char line[256], name[MAX_NAME_LENGTH] = "";
+
+    double nsPerCall = 0.0;
+
+    /*
+        NOTE: Each kernel is printed as a JSON object with one field 
+        per line, and its name always comes before its cost.
+    */
+    while (fgets(line, sizeof line, fp) != NULL
+           && baselineCount < MAX_BASELINE_COUNT) {
+        if (sscanf(line, " \"kernel\": \"%63[^\"]\"", name) == 1) continue;
+
+        if (sscanf(line, " \"ns_per_call\": %lf", &nsPerCall) != 1
+            || name[0] == '\0')
+            continue;
+
+        BaselineEntry *entry = &baseline[baselineCount++];
+
+        strcpy(entry->name, name), entry->nsPerCall = nsPerCall;
+
+        name[0] = '\0';
+    }
+
+    fclose(fp);
+
+    return true;
+}
+
+/* 
+    Returns `true` if a `name` in the given `category` 
+    matches any of the filters. 
+*/
+static bool IsSelected(const char *category, const char *name) {
+    // NOTE: Everything will be run if no filters are given
+    if (filterCount <= 0) return true;
+
+    for (int i = 0; i < filterCount; i++)
+        if (strcmp(filters[i], category) == 0
+            || strncmp(name, filters[i], strlen(filters[i])) == 0)
+            return true;
+
+    return false;
+}
+
+/* 
+    Returns the peak memory usage of this process, in kilobytes.
+
+    NOTE: This is the peak of the whole process so far, so each scene 
+    should be run in its own process for per-scene figures.
+*/
+static long GetPeakMemoryUsage(void) {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters = { .cb = sizeof counters };
+
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof counters))
+        return 0;
+
+    return (long) (counters.PeakWorkingSetSize / 1024);
+#else
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+
+    #if defined(__APPLE__)
+        // NOTE: macOS reports `ru_maxrss` in bytes, not in kilobytes
+        return usage.ru_maxrss / 1024;
+    #else
+        return usage.ru_maxrss;
+    #endif
+#endif
+}
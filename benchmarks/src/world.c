@@ -0,0 +1,277 @@
+/*
+    Copyright (c) 2021-2025 Jaedeok Kim <jdeokkim@protonmail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a 
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation 
+    the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+    and/or sell copies of the Software, and to permit persons to whom the 
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included 
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/* Includes ===============================================================> */
+
+#include "ferox_benchmarks.h"
+
+/* Macros =================================================================> */
+
+#define PYRAMID_ROW_COUNT   40
+#define RAIN_CIRCLE_COUNT   3000
+#define PILE_POLYGON_COUNT  1000
+#define SPARSE_BODY_COUNT   20000
+#define STORM_BODY_COUNT    2000
+#define STORM_RAY_COUNT     1024
+
+/* Constants ==============================================================> */
+
+static const frMaterial MATERIAL = { .density = 1.0f, .friction = 0.5f };
+
+static const float CELL_SIZE = 2.0f;
+
+/* Private Variables ======================================================> */
+
+static unsigned int seed = 0x5EEDu;
+
+static frRay rays[STORM_RAY_COUNT];
+
+static frRaycastHit raycastHits[STORM_RAY_COUNT];
+
+/* Private Function Prototypes ============================================> */
+
+static frWorld *CreateBoxPyramid(frBroadPhaseType type);
+
+static frWorld *CreateCircleRain(frBroadPhaseType type);
+
+static frWorld *CreatePolygonPile(frBroadPhaseType type);
+
+static frWorld *CreateSparseWorld(frBroadPhaseType type);
+
+static frWorld *CreateRaycastStorm(frBroadPhaseType type);
+
+static void UpdateRaycastStorm(frWorld *world, int step);
+
+static frWorld *CreateSceneWorld(frBroadPhaseType type, frVector2 gravity);
+
+static void AddContainer(frWorld *world, float width, float height);
+
+static float GetRandomValue(float min, float max);
+
+/* Public Functions =======================================================> */
+
+/* Returns the world scenes, and stores the number of scenes to `count`. */
+const BenchScene *GetWorldScenes(int *count) {
+    static const BenchScene scenes[] = {
+        { .name = "box_pyramid",
+          .stepCount = 300,
+          .create = CreateBoxPyramid },
+        { .name = "circle_rain",
+          .stepCount = 300,
+          .create = CreateCircleRain },
+        { .name = "polygon_pile",
+          .stepCount = 300,
+          .create = CreatePolygonPile },
+        { .name = "sparse_world",
+          .stepCount = 120,
+          .create = CreateSparseWorld },
+        { .name = "raycast_storm",
+          .stepCount = 120,
+          .create = CreateRaycastStorm,
+          .update = UpdateRaycastStorm }
+    };
+
+    if (count != NULL) *count = sizeof scenes / sizeof *scenes;
+
+    return scenes;
+}
+
+/* Releases `world` and the shapes of all bodies in `world`. */
+void ReleaseSceneWorld(frWorld *world) {
+    for (int i = 0; i < frGetBodyCountInWorld(world); i++)
+        frReleaseShape(frGetBodyShape(frGetBodyInWorld(world, i)));
+
+    frReleaseWorld(world);
+}
+
+/* Private Functions ======================================================> */
+
+static frWorld *CreateBoxPyramid(frBroadPhaseType type) {
+    frWorld *world = CreateSceneWorld(type, FR_WORLD_DEFAULT_GRAVITY);
+
+    frAddBodyToWorld(world,
+                     frCreateBodyFromShape(
+                         FR_BODY_STATIC,
+                         (frVector2) { .y = 0.5f },
+                         frCreateRectangle(MATERIAL,
+                                           2.0f * PYRAMID_ROW_COUNT,
+                                           1.0f)));
+
+    for (int i = 0; i < PYRAMID_ROW_COUNT; i++)
+        for (int j = 0; j <= i; j++)
+            frAddBodyToWorld(
+                world,
+                frCreateBodyFromShape(
+                    FR_BODY_DYNAMIC,
+                    (frVector2) { .x = j - 0.5f * i,
+                                  .y = (i - PYRAMID_ROW_COUNT) * 1.0f },
+                    frCreateRectangle(MATERIAL, 1.0f, 1.0f)));
+
+    return world;
+}
+
+static frWorld *CreateCircleRain(frBroadPhaseType type) {
+    frWorld *world = CreateSceneWorld(type, FR_WORLD_DEFAULT_GRAVITY);
+
+    AddContainer(world, 60.0f, 40.0f);
+
+    for (int i = 0; i < RAIN_CIRCLE_COUNT; i++)
+        frAddBodyToWorld(
+            world,
+            frCreateBodyFromShape(
+                FR_BODY_DYNAMIC,
+                (frVector2) { .x = -28.0f + 1.2f * (i % 48),
+                              .y = -42.0f - 1.2f * (i / 48) },
+                frCreateCircle(MATERIAL, GetRandomValue(0.25f, 0.5f))));
+
+    return world;
+}
+
+static frWorld *CreatePolygonPile(frBroadPhaseType type) {
+    frWorld *world = CreateSceneWorld(type, FR_WORLD_DEFAULT_GRAVITY);
+
+    AddContainer(world, 40.0f, 30.0f);
+
+    for (int i = 0; i < PILE_POLYGON_COUNT; i++) {
+        frVertices vertices = { .count = 3 + (i % 6) };
+
+        for (int j = 0; j < vertices.count; j++) {
+            float angle = (2.0f * M_PI * j) / vertices.count;
+
+            float radius = GetRandomValue(0.4f, 0.7f);
+
+            vertices.data[j] = (frVector2) { .x = radius * cosf(angle),
+                                             .y = radius * sinf(angle) };
+        }
+
+        frBody *b = frCreateBodyFromShape(
+            FR_BODY_DYNAMIC,
+            (frVector2) { .x = -18.0f + 1.6f * (i % 24),
+                          .y = -32.0f - 1.6f * (i / 24) },
+            frCreatePolygon(MATERIAL, &vertices));
+
+        frSetBodyAngle(b, GetRandomValue(0.0f, 2.0f * M_PI));
+        frSetBodyAngularVelocity(b, GetRandomValue(-4.0f, 4.0f));
+
+        frAddBodyToWorld(world, b);
+    }
+
+    return world;
+}
+
+static frWorld *CreateSparseWorld(frBroadPhaseType type) {
+    frWorld *world = CreateSceneWorld(type, frStructZero(frVector2));
+
+    // NOTE: Most bodies never touch each other in this scene
+    for (int i = 0; i < SPARSE_BODY_COUNT; i++) {
+        frBody *b = frCreateBodyFromShape(
+            FR_BODY_DYNAMIC,
+            (frVector2) { .x = 8.0f * (i % 128), .y = 8.0f * (i / 128) },
+            (i & 1) ? frCreateCircle(MATERIAL, 0.5f)
+                    : frCreateRectangle(MATERIAL, 1.0f, 1.0f));
+
+        frSetBodyVelocity(b,
+                          (frVector2) { .x = GetRandomValue(-4.0f, 4.0f),
+                                        .y = GetRandomValue(-4.0f, 4.0f) });
+
+        frAddBodyToWorld(world, b);
+    }
+
+    return world;
+}
+
+static frWorld *CreateRaycastStorm(frBroadPhaseType type) {
+    frWorld *world = CreateSceneWorld(type, frStructZero(frVector2));
+
+    for (int i = 0; i < STORM_BODY_COUNT; i++)
+        frAddBodyToWorld(
+            world,
+            frCreateBodyFromShape(
+                FR_BODY_STATIC,
+                (frVector2) { .x = GetRandomValue(-100.0f, 100.0f),
+                              .y = GetRandomValue(-100.0f, 100.0f) },
+                (i & 1) ? frCreateCircle(MATERIAL, GetRandomValue(0.5f, 1.5f))
+                        : frCreateRectangle(MATERIAL,
+                                            GetRandomValue(1.0f, 3.0f),
+                                            GetRandomValue(1.0f, 3.0f))));
+
+    return world;
+}
+
+static void UpdateRaycastStorm(frWorld *world, int step) {
+    for (int i = 0; i < STORM_RAY_COUNT; i++) {
+        float angle = (2.0f * M_PI * i) / STORM_RAY_COUNT + 0.01f * step;
+
+        rays[i] = (frRay) {
+            .origin = { .x = 16.0f * cosf(0.1f * (i + step)),
+                        .y = 16.0f * sinf(0.1f * (i + step)) },
+            .direction = { .x = cosf(angle), .y = sinf(angle) },
+            .maxDistance = 128.0f
+        };
+    }
+
+    (void) frComputeWorldRaycastBatch(world,
+                                      rays,
+                                      raycastHits,
+                                      STORM_RAY_COUNT);
+}
+
+static frWorld *CreateSceneWorld(frBroadPhaseType type, frVector2 gravity) {
+    // NOTE: Every scene must be the same on each run
+    seed = 0x5EEDu;
+
+    frWorld *world = frCreateWorld(gravity, CELL_SIZE);
+
+    frSetWorldBroadPhaseType(world, type);
+
+    return world;
+}
+
+static void AddContainer(frWorld *world, float width, float height) {
+    frAddBodyToWorld(world,
+                     frCreateBodyFromShape(
+                         FR_BODY_STATIC,
+                         (frVector2) { .y = 0.5f },
+                         frCreateRectangle(MATERIAL, width + 2.0f, 1.0f)));
+
+    frAddBodyToWorld(world,
+                     frCreateBodyFromShape(
+                         FR_BODY_STATIC,
+                         (frVector2) { .x = -0.5f * (width + 1.0f),
+                                       .y = -0.5f * height },
+                         frCreateRectangle(MATERIAL, 1.0f, height)));
+
+    frAddBodyToWorld(world,
+                     frCreateBodyFromShape(
+                         FR_BODY_STATIC,
+                         (frVector2) { .x = 0.5f * (width + 1.0f),
+                                       .y = -0.5f * height },
+                         frCreateRectangle(MATERIAL, 1.0f, height)));
+}
+
+static float GetRandomValue(float min, float max) {
+    // NOTE: https://en.wikipedia.org/wiki/Linear_congruential_generator
+    seed = (1103515245u * seed) + 12345u;
+
+    return min + (max - min) * ((seed >> 16) & 0x7FFF) / 32767.0f;
+}
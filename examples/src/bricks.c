@@ -269,9 +269,8 @@ static void UpdateExample(void) {
         const Font font = GetFontDefault();
 
         DrawTextEx(font,
-                   TextFormat("%d/%d bodies",
-                              frGetBodyCountInWorld(world),
-                              FR_WORLD_MAX_OBJECT_COUNT),
+                   TextFormat("%d bodies",
+                              frGetBodyCountInWorld(world)),
                    (Vector2) { .x = 8.0f, .y = 32.0f },
                    font.baseSize,
                    2.0f,
@@ -40,6 +40,11 @@ extern "C" {
 
 // clang-format off
 
+#ifndef FR_BROAD_PHASE_AABB_MARGIN
+    /* Defines the margin for the 'fat' AABBs of a dynamic AABB tree. */
+    #define FR_BROAD_PHASE_AABB_MARGIN    0.1f
+#endif
+
 #ifndef FR_GEOMETRY_MAX_VERTEX_COUNT
     /* Defines the maximum number of vertices for a convex polygon. */
     #define FR_GEOMETRY_MAX_VERTEX_COUNT  8
@@ -51,28 +56,61 @@ extern "C" {
 #endif
 
 #ifndef FR_WORLD_BAUMGARTE_FACTOR
-    /* Defines the 'bias factor' for the Baumgarte stabilization scheme. */
+    /* Defines the default 'bias factor' for the Baumgarte stabilization. */
     #define FR_WORLD_BAUMGARTE_FACTOR     0.2f
 #endif
 
 #ifndef FR_WORLD_BAUMGARTE_SLOP
-    /* Defines the 'slop' for the Baumgarte stabilization scheme. */
+    /* Defines the default 'slop' for the Baumgarte stabilization scheme. */
     #define FR_WORLD_BAUMGARTE_SLOP       0.01f
 #endif
 
+#ifndef FR_WORLD_DEFAULT_CAPACITY
+    /* Defines the number of bodies a world reserves memory for. */
+    #define FR_WORLD_DEFAULT_CAPACITY     2048
+#endif
+
 #ifndef FR_WORLD_DEFAULT_GRAVITY
     /* Defines the default gravity acceleration vector for a world. */
     #define FR_WORLD_DEFAULT_GRAVITY      ((frVector2) { .y = 9.8f })
 #endif
 
+#ifndef FR_WORLD_ENABLE_PROFILING
+    /* Defines whether each world records the profiling data of a step. */
+    #define FR_WORLD_ENABLE_PROFILING     0
+#endif
+
 #ifndef FR_WORLD_ITERATION_COUNT
-    /* Defines the iteration count for the constraint solver. */
+    /* Defines the default iteration count for the constraint solver. */
     #define FR_WORLD_ITERATION_COUNT      10
 #endif
 
-#ifndef FR_WORLD_MAX_OBJECT_COUNT
-    /* Defines the maximum number of objects in a world. */
-    #define FR_WORLD_MAX_OBJECT_COUNT     2048
+#ifndef FR_WORLD_RAYCAST_GROUP_SIZE
+    /* 
+        Defines the maximum number of cells (along each axis) that a ray 
+        can span to share a broad-phase query with other rays.
+    */
+    #define FR_WORLD_RAYCAST_GROUP_SIZE   2
+#endif
+
+#ifndef FR_WORLD_SLEEP_ANGULAR_THRESHOLD
+    /* Defines the maximum angular velocity of a resting body. */
+    #define FR_WORLD_SLEEP_ANGULAR_THRESHOLD  0.035f
+#endif
+
+#ifndef FR_WORLD_SLEEP_LINEAR_THRESHOLD
+    /* Defines the maximum velocity of a resting body. */
+    #define FR_WORLD_SLEEP_LINEAR_THRESHOLD   0.05f
+#endif
+
+#ifndef FR_WORLD_SLEEP_TIME
+    /* Defines how long a body must rest before it falls asleep, in seconds. */
+    #define FR_WORLD_SLEEP_TIME               0.5f
+#endif
+
+#ifndef FR_WORLD_SUBSTEP_COUNT
+    /* Defines the default sub-step count for the 'soft step' solver. */
+    #define FR_WORLD_SUBSTEP_COUNT            4
 #endif
 
 // clang-format on
@@ -149,6 +187,27 @@ typedef struct frContextNode_ {
     void *ctx;
 } frContextNode;
 
+/* <====================================================== [src/allocator.c] */
+
+/* A structure that represents a custom memory allocator. */
+typedef struct frAllocator_ {
+    void *(*allocate)(size_t size, void *userData);
+    void (*deallocate)(void *ptr, size_t size, void *userData);
+    void *userData;
+} frAllocator;
+
+/* A structure that represents a pool of fixed-size memory blocks. */
+typedef struct frPool_ frPool;
+
+/* 
+    A structure that represents a handle to a memory block in a pool,
+    which becomes invalid once the memory block is returned to the pool.
+*/
+typedef struct frHandle_ {
+    int index;
+    unsigned int generation;
+} frHandle;
+
 /* <==================================================== [src/broad_phase.c] */
 
 /* A structure that represents a spatial hash. */
@@ -157,6 +216,12 @@ typedef struct frSpatialHash_ frSpatialHash;
 /* A callback function type for `frQuerySpatialHash()`. */
 typedef bool (*frHashQueryFunc)(frContextNode ctxNode);
 
+/* 
+    A callback function type for `frRaycastSpatialHash()`, 
+    which returns the new maximum distance of the ray.
+*/
+typedef float (*frHashRaycastFunc)(frContextNode ctxNode, float maxDistance);
+
 /* <====================================================== [src/collision.c] */
 
 /* A structure that represents a contact point. */
@@ -168,6 +233,7 @@ typedef struct frContact_ {
     struct {
         float normalMass, normalScalar;
         float tangentMass, tangentScalar;
+        float normalVelocity;
     } cache;
 } frContact;
 
@@ -198,6 +264,27 @@ typedef struct frRaycastHit_ {
     bool inside;
 } frRaycastHit;
 
+/* <=================================================== [src/dynamic_tree.c] */
+
+/* A structure that represents a dynamic AABB tree. */
+typedef struct frDynamicTree_ frDynamicTree;
+
+/* A callback function type for `frQueryDynamicTree()`. */
+typedef bool (*frTreeQueryFunc)(frContextNode ctxNode);
+
+/* 
+    A callback function type for `frRaycastDynamicTree()`, 
+    which returns the new maximum distance of the ray.
+*/
+typedef float (*frTreeRaycastFunc)(frContextNode ctxNode, float maxDistance);
+
+/*
+    A callback function type for `frQuerySpatialHashPairs()`,
+    `frQueryDynamicTreePairs()` and `frQuerySweepAndPrunePairs()`,
+    which will be called with the values of two overlapping objects.
+*/
+typedef void (*frPairQueryFunc)(int first, int second, void *ctx);
+
 /* <======================================================= [src/geometry.c] */
 
 /* An enumeration that represents the type of a collision shape. */
@@ -235,9 +322,10 @@ typedef enum frBodyType_ {
 
 /* An enumeration that represents a property flag of a rigid body. */
 typedef enum frBodyFlag_ {
-    FR_FLAG_NONE,
-    FR_FLAG_INFINITE_MASS,
-    FR_FLAG_INFINITE_INERTIA
+    FR_FLAG_NONE = 0,
+    FR_FLAG_INFINITE_MASS = 1,
+    FR_FLAG_INFINITE_INERTIA = 2,
+    FR_FLAG_BULLET = 4
 } frBodyFlag;
 
 /* A data type that represents the property flags of a rigid body. */
@@ -255,8 +343,62 @@ typedef struct frTransform_ {
     float angle;
 } frTransform;
 
+/* 
+    A structure that represents the hot data of rigid bodies, 
+    stored in the SoA layout.
+*/
+typedef struct frBodyStorage_ frBodyStorage;
+
+/* A structure that represents a SIMD contact solver. */
+typedef struct frContactSolver_ frContactSolver;
+
+/* <================================================ [src/sweep_and_prune.c] */
+
+/* A structure that represents a sweep-and-prune structure. */
+typedef struct frSweepAndPrune_ frSweepAndPrune;
+
+/* A callback function type for `frQuerySweepAndPrune()`. */
+typedef bool (*frSweepQueryFunc)(frContextNode ctxNode);
+
+/* 
+    A callback function type for `frRaycastSweepAndPrune()`, 
+    which returns the new maximum distance of the ray.
+*/
+typedef float (*frSweepRaycastFunc)(frContextNode ctxNode, float maxDistance);
+
+/* <==================================================== [src/thread_pool.c] */
+
+/* A structure that represents a pool of worker threads. */
+typedef struct frThreadPool_ frThreadPool;
+
+/* 
+    A callback function type for `frRunThreadPool()`, which will be called
+    with the index of the calling thread and a range `[begin, end)`.
+*/
+typedef void (*frThreadTaskFunc)(int threadIndex,
+                                 int begin,
+                                 int end,
+                                 void *userData);
+
 /* <========================================================== [src/world.c] */
 
+/* An enumeration that represents the type of a broad-phase algorithm. */
+typedef enum frBroadPhaseType_ {
+    FR_BROAD_PHASE_UNKNOWN,
+    FR_BROAD_PHASE_SPATIAL_HASH,
+    FR_BROAD_PHASE_DYNAMIC_TREE,
+    FR_BROAD_PHASE_SWEEP_AND_PRUNE
+} frBroadPhaseType;
+
+/* An enumeration that represents the type of a constraint solver. */
+typedef enum frSolverType_ {
+    FR_SOLVER_UNKNOWN,
+    FR_SOLVER_SEQUENTIAL,
+    FR_SOLVER_GRAPH_COLORING,
+    FR_SOLVER_WIDE,
+    FR_SOLVER_SOFT_STEP
+} frSolverType;
+
 /* A structure that represents a pair of two rigid bodies. */
 typedef struct frBodyPair_ {
     frBody *first, *second;
@@ -273,8 +415,76 @@ typedef struct frCollisionHandler_ {
 /* A callback function type for `frComputeRaycastForWorld()`. */
 typedef void (*frRaycastQueryFunc)(frRaycastHit raycastHit, void *ctx);
 
+/* 
+    A structure that represents the profiling data of a world 
+    for a single step, where all times are in milliseconds.
+*/
+typedef struct frWorldStats_ {
+    float stepTime;
+    float broadPhaseTime, narrowPhaseTime;
+    float warmStartTime, solverTime;
+    float integrationTime, callbackTime;
+    int candidatePairCount, narrowPhaseTestCount;
+    int contactCount;
+    int cacheInsertCount, cacheDeleteCount;
+    int hashCellCount;
+    int solverIterationCount;
+} frWorldStats;
+
 /* Public Function Prototypes =============================================> */
 
+/* <====================================================== [src/allocator.c] */
+
+/* Returns the allocator for all pools created from now on. */
+frAllocator frGetAllocator(void);
+
+/* 
+    Sets the allocator for all pools created from now on to `a`. 
+    If `a` is `NULL`, it will reset the allocator to the default one.
+
+    NOTE: Each pool keeps the allocator it has been created with,
+    and the memory returned by `a` must be aligned to 16 bytes.
+*/
+void frSetAllocator(const frAllocator *a);
+
+/* Creates a pool of memory blocks of `blockSize` bytes. */
+frPool *frCreatePool(size_t blockSize);
+
+/* 
+    Creates a pool of memory blocks of `blockSize` bytes at `*p` 
+    if `*p` is `NULL`, then returns `*p`.
+*/
+frPool *frCreatePoolOnce(frPool **p, size_t blockSize);
+
+/* Releases the memory allocated for `p`, including all of its blocks. */
+void frReleasePool(frPool *p);
+
+/* 
+    Returns a zero-initialized memory block from `p`, 
+    or `NULL` if `p` has run out of memory.
+*/
+void *frAllocateFromPool(frPool *p);
+
+/* 
+    Returns the memory block at `ptr` to `p`, which invalidates 
+    all handles to the memory block.
+
+    NOTE: Memory blocks that have already been returned are ignored.
+*/
+void frFreeToPool(frPool *p, void *ptr);
+
+/* Returns the number of memory blocks in use in `p`. */
+int frGetPoolBlockCount(const frPool *p);
+
+/* Returns a handle to the memory block at `ptr` in `p`. */
+frHandle frGetPoolHandle(const frPool *p, const void *ptr);
+
+/* 
+    Returns the memory block of `handle` in `p`, or `NULL` if the memory 
+    block has been returned to `p` since `handle` was created.
+*/
+void *frGetPoolBlock(const frPool *p, frHandle handle);
+
 /* <==================================================== [src/broad_phase.c] */
 
 /* Creates a new spatial hash with the given `cellSize`. */
@@ -286,18 +496,61 @@ void frReleaseSpatialHash(frSpatialHash *sh);
 /* Erases all elements from `sh`. */
 void frClearSpatialHash(frSpatialHash *sh);
 
+/* 
+    Erases all elements from `sh`, except for the static elements 
+    marked by the last call to `frMarkSpatialHashStatic()`.
+*/
+void frClearSpatialHashDynamic(frSpatialHash *sh);
+
+/* 
+    Marks all elements in `sh` as static, so that they will be kept 
+    (along with their cells) by `frClearSpatialHashDynamic()`, 
+    and no pair of them will be reported by `frQuerySpatialHashPairs()`.
+*/
+void frMarkSpatialHashStatic(frSpatialHash *sh);
+
 /* Returns the cell size of `sh`. */
 float frGetSpatialHashCellSize(const frSpatialHash *sh);
 
+/* Returns the bounds of all cells in `sh` that contain an element. */
+frAABB frGetSpatialHashBounds(const frSpatialHash *sh);
+
+/* Returns the number of cells that contain any elements in `sh`. */
+int frGetSpatialHashCellCount(const frSpatialHash *sh);
+
 /* Inserts a `key`-`value` pair into `sh`. */
 void frInsertIntoSpatialHash(frSpatialHash *sh, frAABB key, int value);
 
+/* 
+    Moves each element of `sh` to its cell, then stores the values 
+    of each cell contiguously in the index pool of `sh`.
+*/
+void frBuildSpatialHash(frSpatialHash *sh);
+
 /* Query `sh` for any objects that overlap the given `aabb`. */
 void frQuerySpatialHash(frSpatialHash *sh,
                         frAABB aabb,
                         frHashQueryFunc func,
                         void *userData);
 
+/*
+    Query `sh` for all pairs of objects that are likely to overlap
+    each other, visiting each cell of `sh` only once.
+*/
+void frQuerySpatialHashPairs(frSpatialHash *sh,
+                             frPairQueryFunc func,
+                             void *userData);
+
+/*
+    Casts a `ray` against the cells of `sh` in the order they are crossed,
+    then calls `func` for each object in those cells, which returns 
+    the new maximum distance of `ray`.
+*/
+void frRaycastSpatialHash(frSpatialHash *sh,
+                          frRay ray,
+                          frHashRaycastFunc func,
+                          void *userData);
+
 /* <====================================================== [src/collision.c] */
 
 /* 
@@ -306,9 +559,114 @@ void frQuerySpatialHash(frSpatialHash *sh,
 */
 bool frComputeCollision(frBody *b1, frBody *b2, frCollision *collision);
 
+/* 
+    Checks whether `b1` and `b2` are colliding or closer than `margin`
+    to each other, then stores the collision information to `collision`.
+    The contacts of two bodies that are not touching yet will have 
+    a negative depth, which is the distance between them.
+*/
+bool frComputeSpeculativeCollision(frBody *b1,
+                                   frBody *b2,
+                                   float margin,
+                                   frCollision *collision);
+
 /* Casts a `ray` against `b`. */
 bool frComputeRaycast(const frBody *b, frRay ray, frRaycastHit *raycastHit);
 
+/* 
+    Casts a `ray` against `aabb`, then stores the distance 
+    from the origin of `ray` to the hit point in `distance`.
+*/
+bool frComputeAABBRaycast(frAABB aabb, frRay ray, float *distance);
+
+/* 
+    Computes the time of impact of `b1` and `b2` moving with their current
+    velocities over `dt`, as a fraction of `dt`, where `b1` and `b2` 
+    overlap by about half of `baumgarteSlop`, then stores it to `toi`.
+*/
+bool frComputeTimeOfImpact(const frBody *b1,
+                           const frBody *b2,
+                           float dt,
+                           float baumgarteSlop,
+                           float *toi);
+
+/* <=================================================== [src/dynamic_tree.c] */
+
+/*
+    Creates a new dynamic AABB tree, which will extend the AABB
+    of each object by `margin` on every side.
+*/
+frDynamicTree *frCreateDynamicTree(float margin);
+
+/* Releases the memory allocated for `dt`. */
+void frReleaseDynamicTree(frDynamicTree *dt);
+
+/* Erases all elements from `dt`. */
+void frClearDynamicTree(frDynamicTree *dt);
+
+/* Returns the 'fat' AABB of the root node of `dt`. */
+frAABB frGetDynamicTreeBounds(const frDynamicTree *dt);
+
+/*
+    Inserts a `key`-`value` pair into `dt`,
+    then returns the proxy ID of the new element.
+*/
+int frInsertIntoDynamicTree(frDynamicTree *dt, frAABB key, int value);
+
+/*
+    Inserts `count` `keys`-`values` pairs into `dt`,
+    then stores the proxy ID of each new element to `proxyIds`.
+*/
+void frInsertManyIntoDynamicTree(frDynamicTree *dt,
+                                 const frAABB *keys,
+                                 const int *values,
+                                 int count,
+                                 int *proxyIds);
+
+/* Removes an element with the given `proxyId` from `dt`. */
+void frRemoveFromDynamicTree(frDynamicTree *dt, int proxyId);
+
+/*
+    Updates the `key` of an element with the given `proxyId` in `dt`,
+    then returns `true` if the element had to be re-inserted.
+*/
+bool frUpdateDynamicTree(frDynamicTree *dt, int proxyId, frAABB key);
+
+/*
+    Checks if the 'fat' AABBs of two elements with the given
+    `proxyId1` and `proxyId2` in `dt` overlap.
+*/
+bool frCheckDynamicTreeOverlap(const frDynamicTree *dt,
+                               int proxyId1,
+                               int proxyId2);
+
+/* Sets the `value` of an element with the given `proxyId` in `dt`. */
+void frSetDynamicTreeValue(frDynamicTree *dt, int proxyId, int value);
+
+/* Query `dt` for any objects that overlap the given `aabb`. */
+void frQueryDynamicTree(frDynamicTree *dt,
+                        frAABB aabb,
+                        frTreeQueryFunc func,
+                        void *userData);
+
+/*
+    Query `dt` for any pairs of objects that started to overlap
+    since the last call to this function.
+*/
+void frQueryDynamicTreePairs(frDynamicTree *dt,
+                             frPairQueryFunc func,
+                             void *userData);
+
+/*
+    Casts a `ray` against `dt`, then calls `func` for each object 
+    whose AABB is hit by `ray`, which returns the new maximum distance 
+    of `ray`.
+*/
+void frRaycastDynamicTree(frDynamicTree *dt,
+                          frRay ray,
+                          frTreeRaycastFunc func,
+                          void *userData);
+
 /* <======================================================= [src/geometry.c] */
 
 /* Creates a 'circle' collision shape. */
@@ -323,6 +681,15 @@ frShape *frCreatePolygon(frMaterial material, const frVertices *vertices);
 /* Releases the memory allocated for `s`. */
 void frReleaseShape(frShape *s);
 
+/* Returns a handle to `s`. */
+frHandle frGetShapeHandle(const frShape *s);
+
+/* 
+    Returns the collision shape of `handle`, or `NULL` if the collision 
+    shape has been released since `handle` was created.
+*/
+frShape *frGetShapeFromHandle(frHandle handle);
+
 /* Returns the type of `s`. */
 frShapeType frGetShapeType(const frShape *s);
 
@@ -409,6 +776,15 @@ frBody *frCreateBodyFromShape(frBodyType type, frVector2 position, frShape *s);
 /* Releases the memory allocated for `b`. */
 void frReleaseBody(frBody *b);
 
+/* Returns a handle to `b`. */
+frHandle frGetBodyHandle(const frBody *b);
+
+/* 
+    Returns the rigid body of `handle`, or `NULL` if the rigid body 
+    has been released since `handle` was created.
+*/
+frBody *frGetBodyFromHandle(frHandle handle);
+
 /* Returns the type of `b`. */
 frBodyType frGetBodyType(const frBody *b);
 
@@ -460,6 +836,15 @@ frAABB frGetBodyAABB(const frBody *b);
 /* Returns the user data of `b`. */
 void *frGetBodyUserData(const frBody *b);
 
+/* 
+    Returns the amount of time `b` has been resting for, 
+    in seconds. 
+*/
+float frGetBodySleepTime(const frBody *b);
+
+/* Checks if `b` is sleeping. */
+bool frIsBodySleeping(const frBody *b);
+
 /* Sets the `type` of `b`. */
 void frSetBodyType(frBody *b, frBodyType type);
 
@@ -493,6 +878,19 @@ void frSetBodyAngularVelocity(frBody *b, float angularVelocity);
 /* Sets the user data of `b` to `userData`. */
 void frSetBodyUserData(frBody *b, void *userData);
 
+/* 
+    Sets the `flag` that will be set to `true` 
+    whenever `b` falls asleep or wakes up.
+*/
+void frSetBodySleepFlag(frBody *b, bool *flag);
+
+/* 
+    Puts `b` to sleep if `sleeping` is `true`, or wakes `b` up otherwise.
+    
+    NOTE: Only dynamic bodies can be put to sleep.
+*/
+void frSetBodySleeping(frBody *b, bool sleeping);
+
 /* Checks if the given `point` lies inside `b`. */
 bool frBodyContainsPoint(const frBody *b, frVector2 point);
 
@@ -524,17 +922,277 @@ void frIntegrateForBodyVelocity(frBody *b, float dt);
 */
 void frIntegrateForBodyPosition(frBody *b, float dt);
 
-/* Resolves the collision between `b1` and `b2`. */
-void frResolveCollision(frBody *b1,
-                        frBody *b2,
-                        frCollision *collision,
-                        float inverseDt);
+/* 
+    Resets the sleep timer of `b` if `b` is moving, 
+    or advances the sleep timer of `b` over `dt` otherwise.
+*/
+void frUpdateBodySleepTime(frBody *b, float dt);
+
+/* 
+    Resolves the collision between `b1` and `b2` with the given
+    Baumgarte stabilization parameters, then returns the largest change 
+    in the accumulated impulses of `collision`.
+*/
+float frResolveCollision(frBody *b1,
+                         frBody *b2,
+                         frCollision *collision,
+                         float inverseDt,
+                         float baumgarteFactor,
+                         float baumgarteSlop);
+
+/* 
+    Resolves the collision between `b1` and `b2` as a soft constraint 
+    over a sub-step of `1 / inverseDt` seconds, which lets `b1` and `b2` 
+    overlap by `baumgarteSlop`, or only removes the approaching velocities 
+    of `b1` and `b2` (without pushing them apart) if `useBias` is `false`.
+*/
+void frResolveCollisionSoft(frBody *b1,
+                            frBody *b2,
+                            frCollision *collision,
+                            float inverseDt,
+                            float baumgarteSlop,
+                            bool useBias);
+
+/* 
+    Moves the contact points of `collision` along with `b1` and `b2` 
+    over `dt`, then updates the depth of each contact point 
+    from the relative velocity of `b1` and `b2`.
+*/
+void frUpdateCollisionDepths(const frBody *b1,
+                             const frBody *b2,
+                             frCollision *collision,
+                             float dt);
+
+/* 
+    Stores the relative velocity of `b1` and `b2` along the normal 
+    at each contact point of `collision`, before the collision is resolved.
+*/
+void frStoreCollisionVelocities(const frBody *b1,
+                                const frBody *b2,
+                                frCollision *collision);
+
+/* 
+    Makes `b1` and `b2` bounce off each other, from the relative velocities
+    stored by `frStoreCollisionVelocities()`.
+*/
+void frApplyCollisionRestitution(frBody *b1,
+                                 frBody *b2,
+                                 frCollision *collision);
+
+/* Creates a new body storage. */
+frBodyStorage *frCreateBodyStorage(void);
+
+/* 
+    Releases the memory allocated for `bs`.
+
+    NOTE: The bodies in `bs` must be released before calling this function.
+*/
+void frReleaseBodyStorage(frBodyStorage *bs);
+
+/* 
+    Moves the data of each body in `bs` back to the body,
+    then erases all bodies from `bs`.
+*/
+void frClearBodyStorage(frBodyStorage *bs);
+
+/* 
+    Moves the data of `b` to the end of `bs`. Returns `false` 
+    if `b` has already been added to a body storage.
+*/
+bool frAddToBodyStorage(frBodyStorage *bs, frBody *b);
+
+/* 
+    Moves the data of `b` from `bs` back to `b`, then moves the data 
+    of the last body in `bs` to where the data of `b` was.
+*/
+bool frRemoveFromBodyStorage(frBodyStorage *bs, frBody *b);
+
+/* Reserves memory for at least `capacity` bodies in `bs`. */
+void frReserveBodyStorage(frBodyStorage *bs, int capacity);
+
+/* Returns the number of bodies in `bs`. */
+int frGetBodyStorageLength(const frBodyStorage *bs);
+
+/* Returns the body storage that `b` has been added to. */
+frBodyStorage *frGetBodyStorage(const frBody *b);
+
+/* 
+    Returns the index of `b` in the body storage of `b`, 
+    or `-1` if `b` has not been added to any body storage.
+*/
+int frGetBodyStorageIndex(const frBody *b);
+
+/* Clears accumulated forces on each body in `bs`. */
+void frClearBodyStorageForces(frBodyStorage *bs);
+
+/* 
+    Applies a gravity force to each awake body in `bs` with the `g`ravity 
+    acceleration vector, then calculates the acceleration of each awake 
+    body from the accumulated forces and integrates the acceleration
+    over `dt` to calculate the velocity of each awake body.
+*/
+void frIntegrateForBodyStorageVelocities(frBodyStorage *bs,
+                                         frVector2 g,
+                                         float dt);
+
+/* 
+    Integrates the velocity of each awake body in `bs` over `dt`
+    to calculate the position of each awake body, then updates 
+    the AABB of each awake body.
+*/
+void frIntegrateForBodyStoragePositions(frBodyStorage *bs, float dt);
+
+/* Creates a new SIMD contact solver. */
+frContactSolver *frCreateContactSolver(void);
+
+/* Releases the memory allocated for `cs`. */
+void frReleaseContactSolver(frContactSolver *cs);
+
+/* Erases all contact batches from `cs`. */
+void frClearContactSolver(frContactSolver *cs);
+
+/* Returns the number of contact batches in `cs`. */
+int frGetContactSolverBatchCount(const frContactSolver *cs);
+
+/* 
+    Adds the `collision` between `b1` and `b2` to the last contact batch 
+    of `cs` (or to a new contact batch if the last one is full or closed),
+    with the given Baumgarte stabilization parameters.
+
+    NOTE: `frApplyAccumulatedImpulses()` must be called for `collision`
+    before calling this function.
+*/
+void frAddToContactSolver(frContactSolver *cs,
+                          frBody *b1,
+                          frBody *b2,
+                          frCollision *collision,
+                          float inverseDt,
+                          float baumgarteFactor,
+                          float baumgarteSlop);
+
+/* 
+    Closes the last contact batch of `cs`, so that the next collision 
+    will be added to a new contact batch.
+
+    NOTE: All collisions in a contact batch will be resolved at the same 
+    time, so they must not share any dynamic body.
+*/
+void frCloseContactSolverBatch(frContactSolver *cs);
+
+/* 
+    Resolves the collisions in the contact batches of `cs`
+    within the range `[begin, end)`, then returns the largest change 
+    in the accumulated impulses of those collisions.
+*/
+float frResolveContactSolverBatches(frContactSolver *cs, int begin, int end);
+
+/* 
+    Stores the accumulated impulses of each collision in `cs` 
+    back to the collision, so that they can be used for warm starting.
+*/
+void frStoreContactSolverImpulses(frContactSolver *cs);
+
+/* <================================================ [src/sweep_and_prune.c] */
+
+/* Creates a new sweep-and-prune structure. */
+frSweepAndPrune *frCreateSweepAndPrune(void);
+
+/* Releases the memory allocated for `sap`. */
+void frReleaseSweepAndPrune(frSweepAndPrune *sap);
+
+/* Erases all elements from `sap`. */
+void frClearSweepAndPrune(frSweepAndPrune *sap);
+
+/*
+    Returns the bounds of all elements in `sap`,
+    as of the last call to `frSortSweepAndPrune()`.
+*/
+frAABB frGetSweepAndPruneBounds(const frSweepAndPrune *sap);
+
+/*
+    Inserts a `key`-`value` pair into `sap`,
+    then returns the proxy ID of the new element.
+*/
+int frInsertIntoSweepAndPrune(frSweepAndPrune *sap, frAABB key, int value);
+
+/* Removes an element with the given `proxyId` from `sap`. */
+void frRemoveFromSweepAndPrune(frSweepAndPrune *sap, int proxyId);
+
+/* Updates the `key` of an element with the given `proxyId` in `sap`. */
+void frUpdateSweepAndPrune(frSweepAndPrune *sap, int proxyId, frAABB key);
+
+/* Sets the `value` of an element with the given `proxyId` in `sap`. */
+void frSetSweepAndPruneValue(frSweepAndPrune *sap, int proxyId, int value);
+
+/*
+    Drops the endpoints of the removed elements in `sap`, copies the AABB 
+    of each element in `sap` to its endpoint, then sorts the endpoints 
+    by their minimum x-coordinates.
+*/
+void frSortSweepAndPrune(frSweepAndPrune *sap);
+
+/*
+    Query `sap` for any objects that overlap the given `aabb`,
+    as of the last call to `frSortSweepAndPrune()`.
+*/
+void frQuerySweepAndPrune(const frSweepAndPrune *sap,
+                          frAABB aabb,
+                          frSweepQueryFunc func,
+                          void *userData);
+
+/*
+    Query `sap` for all pairs of objects that overlap each other,
+    as of the last call to `frSortSweepAndPrune()`.
+*/
+void frQuerySweepAndPrunePairs(const frSweepAndPrune *sap,
+                               frPairQueryFunc func,
+                               void *userData);
+
+/*
+    Casts a `ray` against `sap`, then calls `func` for each object 
+    whose AABB is hit by `ray`, which returns the new maximum distance 
+    of `ray`, as of the last call to `frSortSweepAndPrune()`.
+*/
+void frRaycastSweepAndPrune(const frSweepAndPrune *sap,
+                            frRay ray,
+                            frSweepRaycastFunc func,
+                            void *userData);
+
+/* <==================================================== [src/thread_pool.c] */
+
+/* 
+    Creates a thread pool with `threadCount` threads, 
+    including the calling thread.
+*/
+frThreadPool *frCreateThreadPool(int threadCount);
+
+/* Releases the memory allocated for `tp`, then joins all of its threads. */
+void frReleaseThreadPool(frThreadPool *tp);
+
+/* Returns the number of threads in `tp`, including the calling thread. */
+int frGetThreadPoolSize(const frThreadPool *tp);
+
+/* 
+    Splits the range `[0, count)` into contiguous ranges, one for 
+    each thread in `tp`, then calls `func` for each range and 
+    waits for all of them to finish.
+
+    NOTE: The `i`-th range is always given to the `i`-th thread, so the 
+    ranges only depend on `count` and the number of threads in `tp`.
+*/
+void frRunThreadPool(frThreadPool *tp,
+                     int count,
+                     frThreadTaskFunc func,
+                     void *userData);
 
 /* <========================================================== [src/timer.c] */
 
 /* Returns the current time of the monotonic clock, in seconds. */
 float frGetCurrentTime(void);
 
+/* Returns the current time of the monotonic clock, in nanoseconds. */
+unsigned long long frGetCurrentTicks(void);
+
 /* <========================================================== [src/world.c] */
 
 /* 
@@ -543,18 +1201,47 @@ float frGetCurrentTime(void);
 */
 frWorld *frCreateWorld(frVector2 gravity, float cellSize);
 
+/* 
+    Creates a world with the `gravity` vector and `cellSize` 
+    for broad-phase collision detection, which reserves memory
+    for at least `capacity` rigid bodies.
+*/
+frWorld *frCreateWorldWithCapacity(frVector2 gravity, 
+                                   float cellSize, 
+                                   int capacity);
+
 /* Releases the memory allocated for `w`. */
 void frReleaseWorld(frWorld *w);
 
 /* Erases all rigid bodies from `w`. */
 void frClearWorld(frWorld *w);
 
+/* Reserves memory for at least `capacity` rigid bodies in `w`. */
+void frReserveWorld(frWorld *w, int capacity);
+
 /* Adds a rigid `b`ody to `w`. */
 bool frAddBodyToWorld(frWorld *w, frBody *b);
 
+/* 
+    Adds `count` rigid `bodies` to `w`, then returns 
+    the number of bodies that have been (or will be) added.
+
+    NOTE: Unlike `frAddBodyToWorld()`, this function adds the bodies 
+    (after all pending operations on `w`) right away, so they can be found 
+    by the queries on `w` before the next step. It only defers them 
+    to the end of the step when called in the middle of a step.
+*/
+int frAddBodiesToWorld(frWorld *w, frBody **bodies, int count);
+
 /* Removes a rigid `b`ody from `w`. */
 bool frRemoveBodyFromWorld(frWorld *w, frBody *b);
 
+/* 
+    Removes `count` rigid `bodies` from `w`, then returns 
+    the number of bodies that will be removed.
+*/
+int frRemoveBodiesFromWorld(frWorld *w, frBody **bodies, int count);
+
 /* Checks if the given `b`ody is in `w`. */
 bool frIsBodyInWorld(const frWorld *w, frBody *b);
 
@@ -564,15 +1251,118 @@ frBody *frGetBodyInWorld(const frWorld *w, int i);
 /* Returns the number of rigid bodies in `w`. */
 int frGetBodyCountInWorld(const frWorld *w);
 
+/* Returns the 'bias factor' of `w` for the Baumgarte stabilization scheme. */
+float frGetWorldBaumgarteFactor(const frWorld *w);
+
+/* Returns the 'slop' of `w` for the Baumgarte stabilization scheme. */
+float frGetWorldBaumgarteSlop(const frWorld *w);
+
+/* Returns the broad-phase algorithm type of `w`. */
+frBroadPhaseType frGetWorldBroadPhaseType(const frWorld *w);
+
+/* 
+    Returns the largest change in the accumulated impulses 
+    below which the constraint solver of `w` stops iterating.
+*/
+float frGetWorldConvergenceThreshold(const frWorld *w);
+
 /* Returns the gravity acceleration vector of `w`. */
 frVector2 frGetWorldGravity(const frWorld *w);
 
+/* Returns the iteration count of `w` for the constraint solver. */
+int frGetWorldIterationCount(const frWorld *w);
+
+/* Returns the constraint solver type of `w`. */
+frSolverType frGetWorldSolverType(const frWorld *w);
+
+/* Checks if `w` uses speculative contacts. */
+bool frGetWorldSpeculativeContacts(const frWorld *w);
+
+/* Returns the number of sub-steps of `w` for the 'soft step' solver. */
+int frGetWorldSubstepCount(const frWorld *w);
+
+/* 
+    Returns the profiling data of `w` for the last step.
+
+    NOTE: All values will be zero unless the library has been built
+    with `FR_WORLD_ENABLE_PROFILING` set to a nonzero value.
+*/
+frWorldStats frGetWorldStats(const frWorld *w);
+
+/* Returns the number of threads used by `w` on each step. */
+int frGetWorldThreadCount(const frWorld *w);
+
+/* 
+    Sets the 'bias factor' of `w` for the Baumgarte stabilization scheme,
+    which must be in the range `[0, 1]`.
+*/
+void frSetWorldBaumgarteFactor(frWorld *w, float baumgarteFactor);
+
+/* Sets the 'slop' of `w` for the Baumgarte stabilization scheme. */
+void frSetWorldBaumgarteSlop(frWorld *w, float baumgarteSlop);
+
+/* Sets the broad-phase algorithm `type` of `w`. */
+void frSetWorldBroadPhaseType(frWorld *w, frBroadPhaseType type);
+
 /* Sets the collision event `handler` of `w`. */
 void frSetWorldCollisionHandler(frWorld *w, frCollisionHandler handler);
 
+/* 
+    Sets the largest change in the accumulated impulses 
+    below which the constraint solver of `w` stops iterating.
+
+    NOTE: The constraint solver of `w` always runs all iterations 
+    if `threshold` is zero (which is the default value), and 
+    `FR_SOLVER_SOFT_STEP` does not iterate on each sub-step.
+*/
+void frSetWorldConvergenceThreshold(frWorld *w, float threshold);
+
 /* Sets the `gravity` acceleration vector of `w`. */
 void frSetWorldGravity(frWorld *w, frVector2 gravity);
 
+/* Sets the iteration count of `w` for the constraint solver. */
+void frSetWorldIterationCount(frWorld *w, int iterationCount);
+
+/* 
+    Sets the constraint solver `type` of `w`.
+
+    NOTE: `FR_SOLVER_GRAPH_COLORING` solves the pairs that do not share 
+    any dynamic body in parallel, so it will only be faster than 
+    `FR_SOLVER_SEQUENTIAL` if `w` uses more than one thread. 
+    `FR_SOLVER_WIDE` also solves 4 or 8 of those pairs at once 
+    with SIMD instructions on each thread. `FR_SOLVER_SOFT_STEP` splits 
+    each step into sub-steps with soft contact constraints instead of 
+    solving the contacts over and over, which keeps tall stacks stable 
+    without a higher iteration count.
+*/
+void frSetWorldSolverType(frWorld *w, frSolverType type);
+
+/* 
+    Enables or disables speculative contacts for `w`.
+
+    NOTE: Two bodies that are about to collide in the next step 
+    will have contacts with a negative depth (and the collision event
+    handlers will be called for them), so that larger time steps 
+    can be used without tunneling.
+*/
+void frSetWorldSpeculativeContacts(frWorld *w, bool enabled);
+
+/* 
+    Sets the number of sub-steps of `w` for the 'soft step' solver.
+
+    NOTE: The contacts are found only once in a step, and then moved 
+    along with their bodies on each sub-step.
+*/
+void frSetWorldSubstepCount(frWorld *w, int substepCount);
+
+/* 
+    Sets the number of threads used by `w` on each step, 
+    including the calling thread.
+
+    NOTE: The results of each step do not depend on `threadCount`.
+*/
+void frSetWorldThreadCount(frWorld *w, int threadCount);
+
 /* Proceeds the simulation over the time step `dt`, in seconds. */
 void frStepWorld(frWorld *w, float dt);
 
@@ -585,12 +1375,48 @@ void frUpdateWorld(frWorld *w, float dt);
 /* 
     Casts a `ray` against all objects in `w`, 
     then calls `func` for each object that collides with `ray`. 
+
+    NOTE: The broad-phase data of `w` will only be updated 
+    at the end of each step, so the objects that have been added 
+    (except by `frAddBodiesToWorld()`) or moved since the last step 
+    will not be found until the next step.
 */
 void frComputeWorldRaycast(frWorld *w,
                            frRay ray,
                            frRaycastQueryFunc func,
                            void *userData);
 
+/* 
+    Casts a `ray` against all objects in `w`, then stores 
+    the information of the closest hit to `raycastHit`.
+*/
+bool frComputeWorldRaycastClosest(frWorld *w,
+                                  frRay ray,
+                                  frRaycastHit *raycastHit);
+
+/* 
+    Casts a `ray` against all objects in `w`, then stores 
+    the information of the first hit found to `raycastHit`, 
+    which might not be the closest one.
+*/
+bool frComputeWorldRaycastAny(frWorld *w, frRay ray, frRaycastHit *raycastHit);
+
+/* 
+    Casts each of the `count` rays in `rays` against all objects in `w`, 
+    then stores the information of the closest hit of each ray 
+    to `raycastHits`, and returns the number of rays that hit an object.
+
+    NOTE: A ray that does not hit any object will have its hit information 
+    zeroed out. The short rays that start in the same cell share a single 
+    broad-phase query, and the other rays walk the cells (or nodes) 
+    they cross one by one. The rays are then cast on the thread pool 
+    of `w`, so this function must not be called while `w` is being updated.
+*/
+int frComputeWorldRaycastBatch(frWorld *w,
+                               const frRay *rays,
+                               frRaycastHit *raycastHits,
+                               int count);
+
 /* Inline Functions =======================================================> */
 
 /* Adds `v1` and `v2`. */
@@ -0,0 +1,377 @@
+/*
+    Copyright (c) 2021-2025 Jaedeok Kim <jdeokkim@protonmail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a 
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation 
+    the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+    and/or sell copies of the Software, and to permit persons to whom the 
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included 
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Includes ===============================================================> */
+
+#include "external/ferox_utils.h"
+
+#include "ferox.h"
+
+/*
+    NOTE: MSVC does not ship with POSIX threads, and this library never
+    creates any thread there, so the pools do not need a lock.
+*/
+#ifndef _MSC_VER
+    #include <pthread.h>
+
+    #define FR_ALLOCATOR_PTHREADS
+#endif
+
+/* Macros =================================================================> */
+
+// clang-format off
+
+/* The alignment of each block in a pool, in bytes. */
+#define FR_POOL_ALIGNMENT          16
+
+/* The number of blocks in each slab of a pool. */
+#define FR_POOL_SLAB_BLOCK_COUNT   64
+
+/* Rounds up `x` to the next multiple of `FR_POOL_ALIGNMENT`. */
+#define frAlignPoolSize(x)  \
+    (((x) + (FR_POOL_ALIGNMENT - 1)) & ~((size_t) FR_POOL_ALIGNMENT - 1))
+
+// clang-format on
+
+/* Typedefs ===============================================================> */
+
+/* A structure that represents the header of a block in a pool. */
+typedef struct frPoolBlock_ {
+    int index, next;
+    unsigned int generation;
+    bool used;
+} frPoolBlock;
+
+/* A structure that represents a pool of fixed-size memory blocks. */
+struct frPool_ {
+    frAllocator allocator;
+    unsigned char **slabs;
+    size_t blockSize, stride;
+    int slabCount, slabCapacity;
+    int freeIndex, blockCount;
+};
+
+/* Private Variables ======================================================> */
+
+/* The allocator for all pools created from now on. */
+static frAllocator allocator;
+
+#ifdef FR_ALLOCATOR_PTHREADS
+
+/* 
+    The lock for all pools, since rigid bodies and collision shapes 
+    can be created from any thread.
+*/
+static pthread_mutex_t poolMutex = PTHREAD_MUTEX_INITIALIZER;
+
+#endif
+
+/* Private Function Prototypes ============================================> */
+
+/* Allocates `size` bytes of memory with the standard library. */
+static void *frDefaultAllocate(size_t size, void *userData);
+
+/* Releases the memory at `ptr` with the standard library. */
+static void frDefaultDeallocate(void *ptr, size_t size, void *userData);
+
+/* Returns the header of the `i`-th block of `p`. */
+static FR_API_INLINE frPoolBlock *frGetPoolBlockHeader(const frPool *p, int i);
+
+/* Returns the header of the block that starts with `ptr`. */
+static FR_API_INLINE frPoolBlock *frGetPoolBlockHeaderOf(const void *ptr);
+
+/* Returns the memory of the block with the given `header`. */
+static FR_API_INLINE void *frGetPoolBlockMemory(frPoolBlock *header);
+
+/* Adds a new slab of blocks to `p`. */
+static bool frGrowPool(frPool *p);
+
+/* Locks all pools. */
+static FR_API_INLINE void frLockPools(void);
+
+/* Unlocks all pools. */
+static FR_API_INLINE void frUnlockPools(void);
+
+/* Public Functions =======================================================> */
+
+/* Returns the allocator for all pools created from now on. */
+frAllocator frGetAllocator(void) {
+    if (allocator.allocate == NULL || allocator.deallocate == NULL)
+        return (frAllocator) { .allocate = frDefaultAllocate,
+                               .deallocate = frDefaultDeallocate };
+
+    return allocator;
+}
+
+/* 
+    Sets the allocator for all pools created from now on to `a`. 
+    If `a` is `NULL`, it will reset the allocator to the default one.
+
+    NOTE: Each pool keeps the allocator it has been created with,
+    and the memory returned by `a` must be aligned to 16 bytes.
+*/
+void frSetAllocator(const frAllocator *a) {
+    frLockPools();
+
+    allocator = (a != NULL) ? *a : frStructZero(frAllocator);
+
+    frUnlockPools();
+}
+
+/* Creates a pool of memory blocks of `blockSize` bytes. */
+frPool *frCreatePool(size_t blockSize) {
+    if (blockSize == 0) return NULL;
+
+    frAllocator a = frGetAllocator();
+
+    frPool *result = a.allocate(sizeof *result, a.userData);
+
+    if (result == NULL) return NULL;
+
+    *result = (frPool) { .allocator = a,
+                         .blockSize = blockSize,
+                         .stride = frAlignPoolSize(sizeof(frPoolBlock))
+                                   + frAlignPoolSize(blockSize),
+                         .freeIndex = -1 };
+
+    return result;
+}
+
+/* 
+    Creates a pool of memory blocks of `blockSize` bytes at `*p` 
+    if `*p` is `NULL`, then returns `*p`.
+*/
+frPool *frCreatePoolOnce(frPool **p, size_t blockSize) {
+    if (p == NULL) return NULL;
+
+    frLockPools();
+
+    if (*p == NULL) *p = frCreatePool(blockSize);
+
+    frUnlockPools();
+
+    return *p;
+}
+
+/* Releases the memory allocated for `p`, including all of its blocks. */
+void frReleasePool(frPool *p) {
+    if (p == NULL) return;
+
+    frAllocator a = p->allocator;
+
+    for (int i = 0; i < p->slabCount; i++)
+        a.deallocate(p->slabs[i],
+                     FR_POOL_SLAB_BLOCK_COUNT * p->stride,
+                     a.userData);
+
+    if (p->slabs != NULL)
+        a.deallocate(p->slabs,
+                     p->slabCapacity * sizeof *p->slabs,
+                     a.userData);
+
+    a.deallocate(p, sizeof *p, a.userData);
+}
+
+/* 
+    Returns a zero-initialized memory block from `p`, 
+    or `NULL` if `p` has run out of memory.
+*/
+void *frAllocateFromPool(frPool *p) {
+    if (p == NULL) return NULL;
+
+    frLockPools();
+
+    if (p->freeIndex < 0 && !frGrowPool(p)) {
+        frUnlockPools();
+
+        return NULL;
+    }
+
+    frPoolBlock *header = frGetPoolBlockHeader(p, p->freeIndex);
+
+    p->freeIndex = header->next, p->blockCount++;
+
+    header->used = true;
+
+    frUnlockPools();
+
+    void *result = frGetPoolBlockMemory(header);
+
+    memset(result, 0, p->blockSize);
+
+    return result;
+}
+
+/* 
+    Returns the memory block at `ptr` to `p`, which invalidates 
+    all handles to the memory block.
+
+    NOTE: Memory blocks that have already been returned are ignored.
+*/
+void frFreeToPool(frPool *p, void *ptr) {
+    if (p == NULL || ptr == NULL) return;
+
+    frPoolBlock *header = frGetPoolBlockHeaderOf(ptr);
+
+    frLockPools();
+
+    if (header->used) {
+        header->used = false;
+
+        // NOTE: A generation of zero is reserved for invalid handles
+        if (++header->generation == 0u) header->generation = 1u;
+
+        header->next = p->freeIndex;
+
+        p->freeIndex = header->index, p->blockCount--;
+    }
+
+    frUnlockPools();
+}
+
+/* Returns the number of memory blocks in use in `p`. */
+int frGetPoolBlockCount(const frPool *p) {
+    return (p != NULL) ? p->blockCount : 0;
+}
+
+/* Returns a handle to the memory block at `ptr` in `p`. */
+frHandle frGetPoolHandle(const frPool *p, const void *ptr) {
+    if (p == NULL || ptr == NULL) return frStructZero(frHandle);
+
+    const frPoolBlock *header = frGetPoolBlockHeaderOf(ptr);
+
+    return (frHandle) { .index = header->index,
+                        .generation = header->generation };
+}
+
+/* 
+    Returns the memory block of `handle` in `p`, or `NULL` if the memory 
+    block has been returned to `p` since `handle` was created.
+*/
+void *frGetPoolBlock(const frPool *p, frHandle handle) {
+    if (p == NULL || handle.generation == 0u || handle.index < 0) return NULL;
+
+    void *result = NULL;
+
+    frLockPools();
+
+    if (handle.index < p->slabCount * FR_POOL_SLAB_BLOCK_COUNT) {
+        frPoolBlock *header = frGetPoolBlockHeader(p, handle.index);
+
+        if (header->used && header->generation == handle.generation)
+            result = frGetPoolBlockMemory(header);
+    }
+
+    frUnlockPools();
+
+    return result;
+}
+
+/* Private Functions ======================================================> */
+
+/* Allocates `size` bytes of memory with the standard library. */
+static void *frDefaultAllocate(size_t size, void *userData) {
+    return malloc(size);
+}
+
+/* Releases the memory at `ptr` with the standard library. */
+static void frDefaultDeallocate(void *ptr, size_t size, void *userData) {
+    free(ptr);
+}
+
+/* Returns the header of the `i`-th block of `p`. */
+static FR_API_INLINE frPoolBlock *frGetPoolBlockHeader(const frPool *p,
+                                                       int i) {
+    return (frPoolBlock *) (p->slabs[i / FR_POOL_SLAB_BLOCK_COUNT]
+                            + (i % FR_POOL_SLAB_BLOCK_COUNT) * p->stride);
+}
+
+/* Returns the header of the block that starts with `ptr`. */
+static FR_API_INLINE frPoolBlock *frGetPoolBlockHeaderOf(const void *ptr) {
+    return (frPoolBlock *) ((const unsigned char *) ptr
+                            - frAlignPoolSize(sizeof(frPoolBlock)));
+}
+
+/* Returns the memory of the block with the given `header`. */
+static FR_API_INLINE void *frGetPoolBlockMemory(frPoolBlock *header) {
+    return (unsigned char *) header + frAlignPoolSize(sizeof *header);
+}
+
+/* Adds a new slab of blocks to `p`. */
+static bool frGrowPool(frPool *p) {
+    frAllocator a = p->allocator;
+
+    if (p->slabCount >= p->slabCapacity) {
+        int newCapacity = (p->slabCapacity > 0) ? 2 * p->slabCapacity : 8;
+
+        unsigned char **newSlabs = a.allocate(newCapacity * sizeof *newSlabs,
+                                              a.userData);
+
+        if (newSlabs == NULL) return false;
+
+        if (p->slabs != NULL) {
+            memcpy(newSlabs, p->slabs, p->slabCount * sizeof *newSlabs);
+
+            a.deallocate(p->slabs,
+                         p->slabCapacity * sizeof *p->slabs,
+                         a.userData);
+        }
+
+        p->slabs = newSlabs, p->slabCapacity = newCapacity;
+    }
+
+    unsigned char *slab = a.allocate(FR_POOL_SLAB_BLOCK_COUNT * p->stride,
+                                     a.userData);
+
+    if (slab == NULL) return false;
+
+    p->slabs[p->slabCount++] = slab;
+
+    // NOTE: The first block of the new slab will be allocated first
+    for (int i = FR_POOL_SLAB_BLOCK_COUNT - 1; i >= 0; i--) {
+        frPoolBlock *header = (frPoolBlock *) (slab + i * p->stride);
+
+        header->index = ((p->slabCount - 1) * FR_POOL_SLAB_BLOCK_COUNT) + i;
+        header->next = p->freeIndex;
+
+        header->generation = 1u;
+        header->used = false;
+
+        p->freeIndex = header->index;
+    }
+
+    return true;
+}
+
+/* Locks all pools. */
+static FR_API_INLINE void frLockPools(void) {
+#ifdef FR_ALLOCATOR_PTHREADS
+    pthread_mutex_lock(&poolMutex);
+#endif
+}
+
+/* Unlocks all pools. */
+static FR_API_INLINE void frUnlockPools(void) {
+#ifdef FR_ALLOCATOR_PTHREADS
+    pthread_mutex_unlock(&poolMutex);
+#endif
+}
@@ -23,10 +23,13 @@
 /* Includes ===============================================================> */
 
 #include "external/ferox_utils.h"
-#include "external/stb_ds.h"
 
 #include "ferox.h"
 
+/* Macros =================================================================> */
+
+#define FR_SPATIAL_HASH_MIN_CELL_COUNT  16
+
 /* Typedefs ===============================================================> */
 
 /* 
@@ -37,20 +40,55 @@ typedef struct frVector2i_ {
     int x, y;
 } frVector2i;
 
-/* A structure that represents the key-value pair of a spatial hash.*/
-typedef struct frSpatialHashEntry_ {
+/* A structure that represents a cell-value pair of a spatial hash. */
+typedef struct frSpatialHashRecord_ {
+    frVector2i key;
+    int value, cellIndex;
+} frSpatialHashRecord;
+
+/* 
+    A structure that represents a cell of a spatial hash, 
+    whose values are stored in `[offset, offset + count)` of the index pool.
+*/
+typedef struct frSpatialHashCell_ {
     frVector2i key;
-    frDynArray(int) value;
-} frSpatialHashEntry;
+    int offset, count;
+} frSpatialHashCell;
 
 /* A struct that represents a spatial hash. */
 struct frSpatialHash_ {
-    frSpatialHashEntry *entries;
+    frDynArray(frSpatialHashRecord) records;
+    frDynArray(frSpatialHashCell) cells;
+    frDynArray(int) cellIndices;
+    frDynArray(int) indexPool;
     float cellSize, inverseCellSize;
     frDynArray(int) queryResult;
-    frBitArray indexSet;
+    frDynArray(unsigned int) queryStamps;
+    frDynArray(frVector2i) minCells, maxCells;
+    frDynArray(bool) staticFlags;
+    frVector2i minBounds, maxBounds;
+    int staticCount, staticCellCount;
+    unsigned int queryStamp;
+    bool dirty;
 };
 
+/* Private Function Prototypes ============================================> */
+
+/* 
+    Returns the index of the cell with the given `key` in `sh`, 
+    or the index of the empty cell where it should be inserted.
+*/
+static int frFindSpatialHashCell(const frSpatialHash *sh, frVector2i key);
+
+/* 
+    Increments the query ID of `sh`, so that every object 
+    can be reported again by the next query.
+*/
+static void frBeginSpatialHashQuery(frSpatialHash *sh);
+
+/* Returns the hash value of the given `key`. */
+static FR_API_INLINE unsigned int frHashVector2i(frVector2i key);
+
 /* Public Functions =======================================================> */
 
 /* Creates a new spatial hash with the given `cellSize`. */
@@ -62,9 +100,16 @@ frSpatialHash *frCreateSpatialHash(float cellSize) {
     sh->cellSize = cellSize;
     sh->inverseCellSize = 1.0f / cellSize;
 
-    sh->indexSet = frCreateBitArray(FR_WORLD_MAX_OBJECT_COUNT);
+    frInitDynArray(sh->records);
+    frInitDynArray(sh->cells);
+    frInitDynArray(sh->cellIndices);
+    frInitDynArray(sh->indexPool);
 
     frInitDynArray(sh->queryResult);
+    frInitDynArray(sh->queryStamps);
+    frInitDynArray(sh->minCells);
+    frInitDynArray(sh->maxCells);
+    frInitDynArray(sh->staticFlags);
 
     return sh;
 }
@@ -73,21 +118,73 @@ frSpatialHash *frCreateSpatialHash(float cellSize) {
 void frReleaseSpatialHash(frSpatialHash *sh) {
     if (sh == NULL) return;
 
-    for (int i = 0; i < hmlen(sh->entries); i++)
-        frReleaseDynArray(sh->entries[i].value);
+    frReleaseDynArray(sh->records);
+    frReleaseDynArray(sh->cells);
+    frReleaseDynArray(sh->cellIndices);
+    frReleaseDynArray(sh->indexPool);
 
-    frReleaseBitArray(sh->indexSet);
     frReleaseDynArray(sh->queryResult);
+    frReleaseDynArray(sh->queryStamps);
+    frReleaseDynArray(sh->minCells);
+    frReleaseDynArray(sh->maxCells);
+    frReleaseDynArray(sh->staticFlags);
 
-    hmfree(sh->entries), free(sh);
+    free(sh);
 }
 
 /* Erases all elements from `sh`. */
 void frClearSpatialHash(frSpatialHash *sh) {
     if (sh == NULL) return;
 
-    for (int i = 0; i < hmlen(sh->entries); i++)
-        frSetDynArrayLength(sh->entries[i].value, 0);
+    // NOTE: Only the cells that are in use have to be emptied
+    for (int i = 0; i < frGetDynArrayLength(sh->cellIndices); i++)
+        frGetDynArrayValue(sh->cells, frGetDynArrayValue(sh->cellIndices, i))
+            .count = 0;
+
+    for (int i = 0; i < sh->staticCount; i++)
+        frGetDynArrayValue(sh->staticFlags,
+                           frGetDynArrayValue(sh->records, i).value) = false;
+
+    frSetDynArrayLength(sh->records, 0);
+    frSetDynArrayLength(sh->cellIndices, 0);
+    frSetDynArrayLength(sh->indexPool, 0);
+
+    sh->staticCount = sh->staticCellCount = 0;
+
+    sh->dirty = false;
+}
+
+/* 
+    Erases all elements from `sh`, except for the static elements 
+    marked by the last call to `frMarkSpatialHashStatic()`.
+*/
+void frClearSpatialHashDynamic(frSpatialHash *sh) {
+    if (sh == NULL) return;
+
+    // NOTE: A spatial hash with only static elements can be kept as it is
+    if (frGetDynArrayLength(sh->records) <= sh->staticCount) return;
+
+    frSetDynArrayLength(sh->records, sh->staticCount);
+
+    sh->dirty = true;
+}
+
+/* 
+    Marks all elements in `sh` as static, so that they will be kept 
+    (along with their cells) by `frClearSpatialHashDynamic()`, 
+    and no pair of them will be reported by `frQuerySpatialHashPairs()`.
+*/
+void frMarkSpatialHashStatic(frSpatialHash *sh) {
+    if (sh == NULL) return;
+
+    sh->staticCount = frGetDynArrayLength(sh->records);
+
+    for (int i = 0; i < sh->staticCount; i++)
+        frGetDynArrayValue(sh->staticFlags,
+                           frGetDynArrayValue(sh->records, i).value) = true;
+
+    // NOTE: The cells of the static elements will be found by the next build
+    sh->staticCellCount = 0;
 }
 
 /* Returns the cell size of `sh`. */
@@ -95,35 +192,169 @@ float frGetSpatialHashCellSize(const frSpatialHash *sh) {
     return (sh != NULL) ? sh->cellSize : 0.0f;
 }
 
+/* Returns the bounds of all cells in `sh` that contain an element. */
+frAABB frGetSpatialHashBounds(const frSpatialHash *sh) {
+    if (sh == NULL || frGetDynArrayLength(sh->cellIndices) <= 0)
+        return (frAABB) { .width = 0.0f };
+
+    return (frAABB) {
+        .x = sh->minBounds.x * sh->cellSize,
+        .y = sh->minBounds.y * sh->cellSize,
+        .width = ((sh->maxBounds.x - sh->minBounds.x) + 1) * sh->cellSize,
+        .height = ((sh->maxBounds.y - sh->minBounds.y) + 1) * sh->cellSize
+    };
+}
+
+/* Returns the number of cells that contain any elements in `sh`. */
+int frGetSpatialHashCellCount(const frSpatialHash *sh) {
+    return (sh != NULL) ? frGetDynArrayLength(sh->cellIndices) : 0;
+}
+
 /* Inserts a `key`-`value` pair into `sh`. */
 void frInsertIntoSpatialHash(frSpatialHash *sh, frAABB key, int value) {
-    if (sh == NULL) return;
+    if (sh == NULL || value < 0) return;
+
+    while (frGetDynArrayLength(sh->queryStamps) <= value) {
+        frDynArrayPush(sh->queryStamps, 0u);
+        frDynArrayPush(sh->minCells, ((frVector2i) { .x = 0, .y = 0 }));
+        frDynArrayPush(sh->maxCells, ((frVector2i) { .x = 0, .y = 0 }));
+        frDynArrayPush(sh->staticFlags, false);
+    }
 
     float inverseCellSize = sh->inverseCellSize;
 
-    int minX = key.x * inverseCellSize;
-    int minY = key.y * inverseCellSize;
+    int minX = floorf(key.x * inverseCellSize);
+    int minY = floorf(key.y * inverseCellSize);
 
-    int maxX = (key.x + key.width) * inverseCellSize;
-    int maxY = (key.y + key.height) * inverseCellSize;
+    int maxX = floorf((key.x + key.width) * inverseCellSize);
+    int maxY = floorf((key.y + key.height) * inverseCellSize);
 
+    frGetDynArrayValue(sh->minCells, value) = (frVector2i) { .x = minX,
+                                                             .y = minY };
+    frGetDynArrayValue(sh->maxCells, value) = (frVector2i) { .x = maxX,
+                                                             .y = maxY };
+
+    /*
+        NOTE: The new element will be moved to its cells
+        by the next call to `frBuildSpatialHash()`.
+    */
     for (int y = minY; y <= maxY; y++)
-        for (int x = minX; x <= maxX; x++) {
-            frVector2i key = { .x = x, .y = y };
+        for (int x = minX; x <= maxX; x++)
+            frDynArrayPush(sh->records,
+                           ((frSpatialHashRecord) { .key = { .x = x, .y = y },
+                                                    .value = value }));
 
-            frSpatialHashEntry *entry = hmgetp_null(sh->entries, key);
+    sh->dirty = true;
+}
 
-            if (entry != NULL) {
-                frDynArrayPush(entry->value, value);
-            } else {
-                frSpatialHashEntry newEntry = { .key = key };
+/* 
+    Moves each element of `sh` to its cell, then stores the values 
+    of each cell contiguously in the index pool of `sh`.
+*/
+void frBuildSpatialHash(frSpatialHash *sh) {
+    if (sh == NULL || !sh->dirty) return;
 
-                frInitDynArray(newEntry.value);
-                frDynArrayPush(newEntry.value, value);
+    // NOTE: The elements added after the last build must be merged
+    for (int i = 0; i < frGetDynArrayLength(sh->cellIndices); i++)
+        frGetDynArrayValue(sh->cells, frGetDynArrayValue(sh->cellIndices, i))
+            .count = 0;
 
-                hmputs(sh->entries, newEntry);
-            }
+    frSetDynArrayLength(sh->cellIndices, 0);
+
+    int recordCount = frGetDynArrayLength(sh->records);
+
+    {
+        /*
+            NOTE: There cannot be more cells than records, so keeping
+            the load factor of the cell table below 0.5 never requires
+            rehashing in the middle of a build.
+        */
+        unsigned int cellCount = recordCount << 1;
+
+        if (cellCount < FR_SPATIAL_HASH_MIN_CELL_COUNT)
+            cellCount = FR_SPATIAL_HASH_MIN_CELL_COUNT;
+
+        frRoundUp32(cellCount);
+
+        if (frGetDynArrayLength(sh->cells) < cellCount) {
+            frSetDynArrayCapacity(sh->cells, cellCount);
+
+            memset(sh->cells.buffer, 0, cellCount * sizeof(frSpatialHashCell));
+
+            frSetDynArrayLength(sh->cells, cellCount);
+        }
+    }
+
+    /*
+        NOTE: The static elements are always moved to their cells first,
+        so their cells stay the same until the cell table grows.
+    */
+    bool staticCached = (sh->staticCellCount > 0)
+                        && (sh->staticCellCount
+                            == frGetDynArrayLength(sh->cells));
+
+    for (int i = 0; i < recordCount; i++) {
+        frSpatialHashRecord *record = &frGetDynArrayValue(sh->records, i);
+
+        int cellIndex = (staticCached && i < sh->staticCount)
+                            ? record->cellIndex
+                            : frFindSpatialHashCell(sh, record->key);
+
+        frSpatialHashCell *cell = &frGetDynArrayValue(sh->cells, cellIndex);
+
+        if (cell->count == 0) {
+            cell->key = record->key;
+
+            frDynArrayPush(sh->cellIndices, cellIndex);
+
+            if (frGetDynArrayLength(sh->cellIndices) == 1)
+                sh->minBounds = sh->maxBounds = cell->key;
+
+            if (sh->minBounds.x > cell->key.x) sh->minBounds.x = cell->key.x;
+            if (sh->minBounds.y > cell->key.y) sh->minBounds.y = cell->key.y;
+
+            if (sh->maxBounds.x < cell->key.x) sh->maxBounds.x = cell->key.x;
+            if (sh->maxBounds.y < cell->key.y) sh->maxBounds.y = cell->key.y;
+        }
+
+        cell->count++, record->cellIndex = cellIndex;
+    }
+
+    if (sh->staticCount > 0)
+        sh->staticCellCount = frGetDynArrayLength(sh->cells);
+
+    {
+        int offset = 0;
+
+        for (int i = 0; i < frGetDynArrayLength(sh->cellIndices); i++) {
+            frSpatialHashCell *cell = &frGetDynArrayValue(
+                sh->cells, frGetDynArrayValue(sh->cellIndices, i));
+
+            cell->offset = offset, offset += cell->count;
+
+            // NOTE: `count` will be restored while filling the index pool
+            cell->count = 0;
         }
+    }
+
+    if (frGetDynArrayCapacity(sh->indexPool) < recordCount)
+        frSetDynArrayCapacity(sh->indexPool, recordCount);
+
+    frSetDynArrayLength(sh->indexPool, recordCount);
+
+    for (int i = 0; i < recordCount; i++) {
+        const frSpatialHashRecord *record = &frGetDynArrayValue(sh->records, i);
+
+        frSpatialHashCell *cell = &frGetDynArrayValue(sh->cells,
+                                                      record->cellIndex);
+
+        frGetDynArrayValue(sh->indexPool, cell->offset + cell->count) =
+            record->value;
+
+        cell->count++;
+    }
+
+    sh->dirty = false;
 }
 
 /* Query `sh` for any objects that are likely to overlap the given `aabb`. */
@@ -133,40 +364,43 @@ void frQuerySpatialHash(frSpatialHash *sh,
                         void *userData) {
     if (sh == NULL) return;
 
+    frBuildSpatialHash(sh);
+
     float inverseCellSize = sh->inverseCellSize;
 
-    int minX = aabb.x * inverseCellSize;
-    int minY = aabb.y * inverseCellSize;
+    int minX = floorf(aabb.x * inverseCellSize);
+    int minY = floorf(aabb.y * inverseCellSize);
 
-    int maxX = (aabb.x + aabb.width) * inverseCellSize;
-    int maxY = (aabb.y + aabb.height) * inverseCellSize;
+    int maxX = floorf((aabb.x + aabb.width) * inverseCellSize);
+    int maxY = floorf((aabb.y + aabb.height) * inverseCellSize);
 
     frSetDynArrayLength(sh->queryResult, 0);
 
-    for (int y = minY; y <= maxY; y++)
-        for (int x = minX; x <= maxX; x++) {
-            frVector2i key = { .x = x, .y = y };
+    frBeginSpatialHashQuery(sh);
 
-            frSpatialHashEntry *entry = hmgetp_null(sh->entries, key);
+    if (frGetDynArrayLength(sh->cellIndices) > 0) {
+        for (int y = minY; y <= maxY; y++)
+            for (int x = minX; x <= maxX; x++) {
+                const frSpatialHashCell *cell = &frGetDynArrayValue(
+                    sh->cells,
+                    frFindSpatialHashCell(sh,
+                                          (frVector2i) { .x = x, .y = y }));
 
-            if (entry == NULL) continue;
+                // NOTE: An empty cell means that `(x, y)` is not in `sh`
+                for (int i = 0; i < cell->count; i++) {
+                    int value = frGetDynArrayValue(sh->indexPool,
+                                                   cell->offset + i);
 
-            for (int i = 0; i < frGetDynArrayLength(entry->value); i++)
-                frDynArrayPush(sh->queryResult,
-                               frGetDynArrayValue(entry->value, i));
-        }
+                    unsigned int *queryStamp = &frGetDynArrayValue(
+                        sh->queryStamps, value);
 
-    {
-        frBitArrayClear(sh->indexSet, FR_WORLD_MAX_OBJECT_COUNT);
+                    if (*queryStamp == sh->queryStamp) continue;
 
-        for (int i = 0; i < frGetDynArrayLength(sh->queryResult); i++)
-            frBitArraySet(sh->indexSet, frGetDynArrayValue(sh->queryResult, i));
+                    *queryStamp = sh->queryStamp;
 
-        frSetDynArrayLength(sh->queryResult, 0);
-
-        for (int i = 0; i < FR_WORLD_MAX_OBJECT_COUNT; i++)
-            if (frBitArrayGet(sh->indexSet, i))
-                frDynArrayPush(sh->queryResult, i);
+                    frDynArrayPush(sh->queryResult, value);
+                }
+            }
     }
 
     /*
@@ -177,3 +411,254 @@ void frQuerySpatialHash(frSpatialHash *sh,
         func((frContextNode) { .id = frGetDynArrayValue(sh->queryResult, i),
                                .ctx = userData });
 }
+
+/*
+    Query `sh` for all pairs of objects that are likely to overlap
+    each other, visiting each cell of `sh` only once.
+*/
+void frQuerySpatialHashPairs(frSpatialHash *sh,
+                             frPairQueryFunc func,
+                             void *userData) {
+    if (sh == NULL || func == NULL) return;
+
+    frBuildSpatialHash(sh);
+
+    for (int i = 0; i < frGetDynArrayLength(sh->cellIndices); i++) {
+        const frSpatialHashCell *cell = &frGetDynArrayValue(
+            sh->cells, frGetDynArrayValue(sh->cellIndices, i));
+
+        const int *values = &frGetDynArrayValue(sh->indexPool, cell->offset);
+
+        for (int j = 0; j < cell->count; j++)
+            for (int k = j + 1; k < cell->count; k++) {
+                int first = values[j], second = values[k];
+
+                if (first == second) continue;
+
+                // NOTE: Two static objects can never start to overlap
+                if (frGetDynArrayValue(sh->staticFlags, first)
+                    && frGetDynArrayValue(sh->staticFlags, second))
+                    continue;
+
+                frVector2i minCell1 = frGetDynArrayValue(sh->minCells, first);
+                frVector2i minCell2 = frGetDynArrayValue(sh->minCells, second);
+
+                /*
+                    NOTE: Two objects can share more than one cell, so
+                    we only report their pair in the first cell they share,
+                    which is where their cell ranges start to overlap.
+                */
+                int x = (minCell1.x > minCell2.x) ? minCell1.x : minCell2.x;
+                int y = (minCell1.y > minCell2.y) ? minCell1.y : minCell2.y;
+
+                if (cell->key.x != x || cell->key.y != y) continue;
+
+                if (first < second)
+                    func(first, second, userData);
+                else
+                    func(second, first, userData);
+            }
+    }
+}
+
+/*
+    Casts a `ray` against the cells of `sh` in the order they are crossed,
+    then calls `func` for each object in those cells, which returns 
+    the new maximum distance of `ray`.
+*/
+void frRaycastSpatialHash(frSpatialHash *sh,
+                          frRay ray,
+                          frHashRaycastFunc func,
+                          void *userData) {
+    if (sh == NULL || func == NULL || ray.maxDistance < 0.0f) return;
+
+    frBuildSpatialHash(sh);
+
+    if (frGetDynArrayLength(sh->cellIndices) <= 0) return;
+
+    frVector2 direction = frVector2Normalize(ray.direction);
+
+    float cellSize = sh->cellSize, inverseCellSize = sh->inverseCellSize;
+
+    float maxDistance = ray.maxDistance;
+
+    /*
+        NOTE: We can skip all the cells before `ray` enters the bounds
+        of `sh` and after `ray` leaves the bounds of `sh`.
+    */
+    float minDistance = 0.0f, endDistance = maxDistance;
+
+    {
+        float minBounds[2] = { sh->minBounds.x * cellSize,
+                               sh->minBounds.y * cellSize };
+        float maxBounds[2] = { (sh->maxBounds.x + 1) * cellSize,
+                               (sh->maxBounds.y + 1) * cellSize };
+
+        float origin[2] = { ray.origin.x, ray.origin.y };
+        float delta[2] = { direction.x, direction.y };
+
+        for (int i = 0; i < 2; i++) {
+            if (delta[i] == 0.0f) {
+                if (origin[i] < minBounds[i] || origin[i] > maxBounds[i])
+                    return;
+            } else {
+                float t1 = (minBounds[i] - origin[i]) / delta[i];
+                float t2 = (maxBounds[i] - origin[i]) / delta[i];
+
+                if (minDistance < fminf(t1, t2)) minDistance = fminf(t1, t2);
+                if (endDistance > fmaxf(t1, t2)) endDistance = fmaxf(t1, t2);
+            }
+        }
+
+        if (minDistance > endDistance) return;
+    }
+
+    frVector2 startPoint = frVector2Add(
+        ray.origin, frVector2ScalarMultiply(direction, minDistance));
+
+    int x = floorf(startPoint.x * inverseCellSize);
+    int y = floorf(startPoint.y * inverseCellSize);
+
+    if (x < sh->minBounds.x) x = sh->minBounds.x;
+    if (y < sh->minBounds.y) y = sh->minBounds.y;
+
+    if (x > sh->maxBounds.x) x = sh->maxBounds.x;
+    if (y > sh->maxBounds.y) y = sh->maxBounds.y;
+
+    int stepX = (direction.x > 0.0f) ? 1 : -1;
+    int stepY = (direction.y > 0.0f) ? 1 : -1;
+
+    /*
+        NOTE: `tMaxX` and `tMaxY` are the distances along `ray` to the next
+        vertical and horizontal cell boundaries, and `tDeltaX` and `tDeltaY`
+        are the distances along `ray` between two of those boundaries.
+
+        http://www.cse.yorku.ca/~amana/research/grid.pdf
+    */
+    float tMaxX = FLT_MAX, tMaxY = FLT_MAX;
+    float tDeltaX = FLT_MAX, tDeltaY = FLT_MAX;
+
+    if (direction.x != 0.0f) {
+        float boundaryX = (x + (stepX > 0)) * cellSize;
+
+        tMaxX = (boundaryX - ray.origin.x) / direction.x;
+        tDeltaX = cellSize / fabsf(direction.x);
+    }
+
+    if (direction.y != 0.0f) {
+        float boundaryY = (y + (stepY > 0)) * cellSize;
+
+        tMaxY = (boundaryY - ray.origin.y) / direction.y;
+        tDeltaY = cellSize / fabsf(direction.y);
+    }
+
+    // NOTE: The cell visited before `(x, y)`, if any
+    frVector2i prevCell = { .x = x, .y = y };
+
+    for (bool firstCell = true;; firstCell = false) {
+        const frSpatialHashCell *cell = &frGetDynArrayValue(
+            sh->cells,
+            frFindSpatialHashCell(sh, (frVector2i) { .x = x, .y = y }));
+
+        for (int i = 0; i < cell->count; i++) {
+            int value = frGetDynArrayValue(sh->indexPool, cell->offset + i);
+
+            frVector2i minCell = frGetDynArrayValue(sh->minCells, value);
+            frVector2i maxCell = frGetDynArrayValue(sh->maxCells, value);
+
+            /*
+                NOTE: A ray enters the cell range of an object only once,
+                so if the previous cell is also in the cell range of
+                this object, it must have been reported already. Unlike
+                query stamps, this does not write to `sh`, so many rays
+                can be cast against `sh` at the same time.
+            */
+            if (!firstCell
+                && (prevCell.x >= minCell.x && prevCell.x <= maxCell.x)
+                && (prevCell.y >= minCell.y && prevCell.y <= maxCell.y))
+                continue;
+
+            float newMaxDistance = func(
+                (frContextNode) { .id = value, .ctx = userData },
+                maxDistance);
+
+            // NOTE: The callback function wants us to stop right away
+            if (newMaxDistance <= 0.0f) return;
+
+            if (maxDistance > newMaxDistance) maxDistance = newMaxDistance;
+
+            if (endDistance > newMaxDistance) endDistance = newMaxDistance;
+        }
+
+        /*
+            NOTE: Every object that `ray` can still hit before `endDistance`
+            must be in one of the cells we have already visited, if
+            the next cell starts after `endDistance`.
+        */
+        prevCell = (frVector2i) { .x = x, .y = y };
+
+        if (tMaxX < tMaxY) {
+            if (tMaxX > endDistance) break;
+
+            x += stepX, tMaxX += tDeltaX;
+
+            if (x < sh->minBounds.x || x > sh->maxBounds.x) break;
+        } else {
+            if (tMaxY > endDistance) break;
+
+            y += stepY, tMaxY += tDeltaY;
+
+            if (y < sh->minBounds.y || y > sh->maxBounds.y) break;
+        }
+    }
+}
+
+/* Private Functions ======================================================> */
+
+/* 
+    Increments the query ID of `sh`, so that every object 
+    can be reported again by the next query.
+*/
+static void frBeginSpatialHashQuery(frSpatialHash *sh) {
+    /*
+        NOTE: Each object will be stamped with the ID of the current query
+        when it is reported, so that we can skip the duplicates
+        without clearing or scanning a bit array.
+    */
+    if (++sh->queryStamp == 0) {
+        memset(sh->queryStamps.buffer,
+               0,
+               frGetDynArrayLength(sh->queryStamps) * sizeof(unsigned int));
+
+        sh->queryStamp = 1;
+    }
+}
+
+/* 
+    Returns the index of the cell with the given `key` in `sh`, 
+    or the index of the empty cell where it should be inserted.
+*/
+static int frFindSpatialHashCell(const frSpatialHash *sh, frVector2i key) {
+    unsigned int mask = frGetDynArrayLength(sh->cells) - 1;
+
+    // NOTE: https://en.wikipedia.org/wiki/Linear_probing
+    for (unsigned int i = frHashVector2i(key) & mask;; i = (i + 1) & mask) {
+        const frSpatialHashCell *cell = &frGetDynArrayValue(sh->cells, i);
+
+        if (cell->count == 0 || (cell->key.x == key.x && cell->key.y == key.y))
+            return i;
+    }
+}
+
+/* Returns the hash value of the given `key`. */
+static FR_API_INLINE unsigned int frHashVector2i(frVector2i key) {
+    unsigned int result = ((unsigned int) key.x * 0x8DA6B343u)
+                          ^ ((unsigned int) key.y * 0xD8163841u);
+
+    // NOTE: https://github.com/aappleby/smhasher/wiki/MurmurHash3
+    result ^= result >> 16, result *= 0x85EBCA6Bu;
+    result ^= result >> 13, result *= 0xC2B2AE35u;
+    result ^= result >> 16;
+
+    return result;
+}
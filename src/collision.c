@@ -24,6 +24,14 @@
 
 #include "ferox.h"
 
+/* Macros =================================================================> */
+
+/* 
+    The maximum number of iterations for finding the time of impact 
+    of two bodies with conservative advancement.
+*/
+#define FR_COLLISION_TOI_ITERATION_COUNT  20
+
 /* Typedefs ===============================================================> */
 
 /* A structure that represents an edge of a convex polygon. */
@@ -42,7 +50,7 @@ typedef struct frEdge_ {
 static bool frClipEdge(frEdge *e, frVector2 v, float dot);
 
 /* 
-    Checks whether `s1` and `s2` are colliding,
+    Checks whether `s1` and `s2` are colliding or closer than `margin`,
     assuming `s1` and `s2` are 'circle' collision shapes,
     then stores the collision information to `collision`.
 */
@@ -50,10 +58,11 @@ static bool frComputeCollisionCircles(const frShape *s1,
                                       frTransform tx1,
                                       const frShape *s2,
                                       frTransform tx2,
+                                      float margin,
                                       frCollision *collision);
 
 /* 
-    Checks whether `s1` and `s2` are colliding,
+    Checks whether `s1` and `s2` are colliding or closer than `margin`,
     assuming `s1` is a 'circle' collision shape and `s2` is a 'polygon' 
     collision shape, then stores the collision information to `collision`.
 */
@@ -61,10 +70,11 @@ static bool frComputeCollisionCirclePoly(const frShape *s1,
                                          frTransform tx1,
                                          const frShape *s2,
                                          frTransform tx2,
+                                         float margin,
                                          frCollision *collision);
 
 /* 
-    Checks whether `s1` and `s2` are colliding,
+    Checks whether `s1` and `s2` are colliding or closer than `margin`,
     assuming `s1` and `s2` are 'polygon' collision shapes,
     then stores the collision information to `collision`.
 */
@@ -72,6 +82,7 @@ static bool frComputeCollisionPolys(const frShape *s1,
                                     frTransform tx1,
                                     const frShape *s2,
                                     frTransform tx2,
+                                    float margin,
                                     frCollision *collision);
 
 /* Computes the intersection of a circle and a line. */
@@ -81,12 +92,14 @@ static bool frComputeIntersectionCircleLine(frVector2 center,
                                             frVector2 direction,
                                             float *distance);
 
-/* Computes the intersection of two lines. */
-static bool frComputeIntersectionLines(frVector2 origin1,
-                                       frVector2 direction1,
-                                       frVector2 origin2,
-                                       frVector2 direction2,
-                                       float *distance);
+/* 
+    Returns the distance between `s1` and `s2`, or a lower bound of it,
+    which will be negative if `s1` and `s2` are overlapping.
+*/
+static float frComputeSeparation(const frShape *s1,
+                                 frTransform tx1,
+                                 const frShape *s2,
+                                 frTransform tx2);
 
 /* Returns the edge of `s` that is most perpendicular to `v`. */
 static frEdge frGetContactEdge(const frShape *s, frTransform tx, frVector2 v);
@@ -101,10 +114,25 @@ static int frGetSeparatingAxisIndex(const frShape *s1,
                                     frTransform tx2,
                                     float *depth);
 
+/* 
+    Returns the distance from the origin of `s` 
+    to the farthest point of `s`, if `s` is not a circle.
+*/
+static float frGetShapeBoundingRadius(const frShape *s);
+
 /* Returns the index of the vertex farthest along `v`. */
 static int
 frGetSupportPointIndex(const frVertices *vertices, frTransform tx, frVector2 v);
 
+/* 
+    Returns the transform that is `t` of the way from `tx`
+    to `tx` moved by `deltaPosition` and rotated by `deltaAngle`.
+*/
+static frTransform frGetSweptTransform(frTransform tx,
+                                       frVector2 deltaPosition,
+                                       float deltaAngle,
+                                       float t);
+
 /* Public Functions =======================================================> */
 
 /* 
@@ -112,6 +140,19 @@ frGetSupportPointIndex(const frVertices *vertices, frTransform tx, frVector2 v);
     then stores the collision information to `collision`.
 */
 bool frComputeCollision(frBody *b1, frBody *b2, frCollision *collision) {
+    return frComputeSpeculativeCollision(b1, b2, 0.0f, collision);
+}
+
+/* 
+    Checks whether `b1` and `b2` are colliding or closer than `margin`
+    to each other, then stores the collision information to `collision`.
+    The contacts of two bodies that are not touching yet will have 
+    a negative depth, which is the distance between them.
+*/
+bool frComputeSpeculativeCollision(frBody *b1,
+                                   frBody *b2,
+                                   float margin,
+                                   frCollision *collision) {
     if (b1 == NULL || b2 == NULL) return false;
 
     const frShape *s1 = frGetBodyShape(b1);
@@ -123,13 +164,20 @@ bool frComputeCollision(frBody *b1, frBody *b2, frCollision *collision) {
     frShapeType type1 = frGetShapeType(s1);
     frShapeType type2 = frGetShapeType(s2);
 
+    if (margin < 0.0f) margin = 0.0f;
+
     if (type1 == FR_SHAPE_CIRCLE && type2 == FR_SHAPE_CIRCLE)
-        return frComputeCollisionCircles(s1, tx1, s2, tx2, collision);
+        return frComputeCollisionCircles(s1, tx1, s2, tx2, margin, collision);
     else if ((type1 == FR_SHAPE_CIRCLE && type2 == FR_SHAPE_POLYGON)
              || (type1 == FR_SHAPE_POLYGON && type2 == FR_SHAPE_CIRCLE))
-        return frComputeCollisionCirclePoly(s1, tx1, s2, tx2, collision);
+        return frComputeCollisionCirclePoly(s1,
+                                            tx1,
+                                            s2,
+                                            tx2,
+                                            margin,
+                                            collision);
     else if (type1 == FR_SHAPE_POLYGON && type2 == FR_SHAPE_POLYGON)
-        return frComputeCollisionPolys(s1, tx1, s2, tx2, collision);
+        return frComputeCollisionPolys(s1, tx1, s2, tx2, margin, collision);
     else
         return false;
 }
@@ -172,53 +220,197 @@ bool frComputeRaycast(const frBody *b, frRay ray, frRaycastHit *raycastHit) {
         return result;
     } else if (type == FR_SHAPE_POLYGON) {
         const frVertices *vertices = frGetPolygonVertices(s);
+        const frVertices *normals = frGetPolygonNormals(s);
 
-        int intersectionCount = 0;
-
-        float minDistance = FLT_MAX;
-
-        for (int j = vertices->count - 1, i = 0; i < vertices->count;
-             j = i, i++) {
-            frVector2 v1 = frVector2Transform(vertices->data[i], tx);
-            frVector2 v2 = frVector2Transform(vertices->data[j], tx);
-
-            frVector2 edgeVector = frVector2Subtract(v1, v2);
+        // NOTE: The ray will be transformed to the local space of `s`
+        frVector2 originToPosition = frVector2Subtract(ray.origin,
+                                                       tx.position);
 
-            bool intersects = frComputeIntersectionLines(ray.origin,
-                                                         ray.direction,
-                                                         v2,
-                                                         edgeVector,
-                                                         &distance);
+        frVector2 origin = { .x = originToPosition.x * tx.rotation.cos_
+                                  + originToPosition.y * tx.rotation.sin_,
+                             .y = originToPosition.y * tx.rotation.cos_
+                                  - originToPosition.x * tx.rotation.sin_ };
 
-            if (intersects && distance <= ray.maxDistance) {
-                if (minDistance > distance) {
-                    minDistance = distance;
+        frVector2 direction = { .x = ray.direction.x * tx.rotation.cos_
+                                     + ray.direction.y * tx.rotation.sin_,
+                                .y = ray.direction.y * tx.rotation.cos_
+                                     - ray.direction.x * tx.rotation.sin_ };
 
-                    if (raycastHit != NULL) {
-                        raycastHit->point =
-                            frVector2Add(ray.origin,
-                                         frVector2ScalarMultiply(ray.direction,
-                                                                 minDistance));
+        float lower = 0.0f, upper = ray.maxDistance;
 
-                        raycastHit->normal = frVector2LeftNormal(edgeVector);
-                    }
-                }
+        int edgeIndex = -1;
 
-                intersectionCount++;
+        /*
+            NOTE: Clips the ray against the half-plane of each edge,
+            keeping the interval `[lower, upper]` where the ray is inside
+            of every half-plane.
+        */
+        for (int i = 0; i < vertices->count; i++) {
+            float numerator = frVector2Dot(normals->data[i],
+                                           frVector2Subtract(vertices->data[i],
+                                                             origin));
+
+            float denominator = frVector2Dot(normals->data[i], direction);
+
+            if (denominator == 0.0f) {
+                if (numerator < 0.0f) return false;
+            } else if (denominator < 0.0f && numerator < lower * denominator) {
+                lower = numerator / denominator, edgeIndex = i;
+            } else if (denominator > 0.0f && numerator < upper * denominator) {
+                upper = numerator / denominator;
             }
+
+            if (upper < lower) return false;
         }
 
         if (raycastHit != NULL) {
             raycastHit->body = (frBody *) b;
-            raycastHit->inside = (intersectionCount & 1);
+
+            raycastHit->point = frVector2Add(
+                ray.origin, frVector2ScalarMultiply(ray.direction, lower));
+
+            raycastHit->normal = (edgeIndex >= 0)
+                                     ? frVector2RotateTx(
+                                         normals->data[edgeIndex], tx)
+                                     : frVector2Negate(ray.direction);
+
+            raycastHit->distance = lower;
+            raycastHit->inside = (edgeIndex < 0);
         }
 
-        return (!(raycastHit->inside) && (intersectionCount > 0));
+        // NOTE: The origin of the ray is inside of `s`
+        return (edgeIndex >= 0);
     } else {
         return false;
     }
 }
 
+/* 
+    Casts a `ray` against `aabb`, then stores the distance 
+    from the origin of `ray` to the hit point in `distance`.
+*/
+bool frComputeAABBRaycast(frAABB aabb, frRay ray, float *distance) {
+    ray.direction = frVector2Normalize(ray.direction);
+
+    float minBounds[2] = { aabb.x, aabb.y };
+    float maxBounds[2] = { aabb.x + aabb.width, aabb.y + aabb.height };
+
+    float origin[2] = { ray.origin.x, ray.origin.y };
+    float direction[2] = { ray.direction.x, ray.direction.y };
+
+    float minDistance = 0.0f, maxDistance = ray.maxDistance;
+
+    // NOTE: https://en.wikipedia.org/wiki/Slab_method
+    for (int i = 0; i < 2; i++) {
+        if (direction[i] == 0.0f) {
+            if (origin[i] < minBounds[i] || origin[i] > maxBounds[i])
+                return false;
+        } else {
+            float inverseDirection = 1.0f / direction[i];
+
+            float t1 = (minBounds[i] - origin[i]) * inverseDirection;
+            float t2 = (maxBounds[i] - origin[i]) * inverseDirection;
+
+            if (minDistance < fminf(t1, t2)) minDistance = fminf(t1, t2);
+            if (maxDistance > fmaxf(t1, t2)) maxDistance = fmaxf(t1, t2);
+
+            if (minDistance > maxDistance) return false;
+        }
+    }
+
+    if (distance != NULL) *distance = minDistance;
+
+    return true;
+}
+
+/* 
+    Computes the time of impact of `b1` and `b2` moving with their current
+    velocities over `dt`, as a fraction of `dt`, where `b1` and `b2` 
+    overlap by about half of `baumgarteSlop`, then stores it to `toi`.
+*/
+bool frComputeTimeOfImpact(const frBody *b1,
+                           const frBody *b2,
+                           float dt,
+                           float baumgarteSlop,
+                           float *toi) {
+    if (b1 == NULL || b2 == NULL || dt <= 0.0f) return false;
+
+    const frShape *s1 = frGetBodyShape(b1);
+    const frShape *s2 = frGetBodyShape(b2);
+
+    if (s1 == NULL || s2 == NULL) return false;
+
+    frTransform tx1 = frGetBodyTransform(b1);
+    frTransform tx2 = frGetBodyTransform(b2);
+
+    frVector2 deltaPosition1 = frVector2ScalarMultiply(frGetBodyVelocity(b1),
+                                                       dt);
+    frVector2 deltaPosition2 = frVector2ScalarMultiply(frGetBodyVelocity(b2),
+                                                       dt);
+
+    float deltaAngle1 = frGetBodyAngularVelocity(b1) * dt;
+    float deltaAngle2 = frGetBodyAngularVelocity(b2) * dt;
+
+    /*
+        NOTE: No point of `b1` can move farther than this relative to `b2`
+        over `dt`, so the separation of `b1` and `b2` cannot shrink faster.
+    */
+    float maxDistance = frVector2Distance(deltaPosition1, deltaPosition2)
+                        + fabsf(deltaAngle1) * frGetShapeBoundingRadius(s1)
+                        + fabsf(deltaAngle2) * frGetShapeBoundingRadius(s2);
+
+    if (maxDistance <= 0.0f) return false;
+
+    /*
+        NOTE: Both bodies will be stopped with a small penetration, 
+        so that the narrow phase can find their contact in the next step.
+    */
+    float targetSeparation = -0.5f * baumgarteSlop;
+
+    const float tolerance = 0.25f * baumgarteSlop;
+
+    float separation = frComputeSeparation(s1, tx1, s2, tx2);
+
+    /*
+        NOTE: Bodies that are already touching can only get a little deeper
+        into each other, since the solver might not have been able to 
+        push them apart (e.g. a fast spinning body hitting a thin wall).
+    */
+    bool touching = (separation <= targetSeparation + tolerance);
+
+    // NOTE: Without any slop, touching bodies cannot get any deeper
+    if (touching && baumgarteSlop <= 0.0f) return false;
+
+    if (touching) targetSeparation = separation - baumgarteSlop;
+
+    float t = 0.0f;
+
+    // NOTE: https://en.wikipedia.org/wiki/Conservative_advancement
+    for (int i = 0; i < FR_COLLISION_TOI_ITERATION_COUNT; i++) {
+        t += (separation - targetSeparation) / maxDistance;
+
+        if (t >= 1.0f) return false;
+
+        separation = frComputeSeparation(
+            s1,
+            frGetSweptTransform(tx1, deltaPosition1, deltaAngle1, t),
+            s2,
+            frGetSweptTransform(tx2, deltaPosition2, deltaAngle2, t));
+
+        if (separation <= targetSeparation + tolerance) break;
+    }
+
+    /*
+        NOTE: Bodies that slide along each other never get closer,
+        but each iteration only advances them by a tiny amount.
+    */
+    if (touching && separation > targetSeparation + tolerance) return false;
+
+    if (toi != NULL) *toi = t;
+
+    return true;
+}
+
 /* Private Functions ======================================================> */
 
 /* 
@@ -257,7 +449,7 @@ static bool frClipEdge(frEdge *e, frVector2 v, float dot) {
 }
 
 /* 
-    Checks whether `s1` and `s2` are colliding,
+    Checks whether `s1` and `s2` are colliding or closer than `margin`,
     assuming `s1` and `s2` are 'circle' collision shapes,
     then stores the collision information to `collision`.
 */
@@ -265,13 +457,16 @@ static bool frComputeCollisionCircles(const frShape *s1,
                                       frTransform tx1,
                                       const frShape *s2,
                                       frTransform tx2,
+                                      float margin,
                                       frCollision *collision) {
     frVector2 direction = frVector2Subtract(tx2.position, tx1.position);
 
     float radiusSum = frGetCircleRadius(s1) + frGetCircleRadius(s2);
     float magnitudeSqr = frVector2MagnitudeSqr(direction);
 
-    if (radiusSum * radiusSum < magnitudeSqr) return false;
+    float maxDistance = radiusSum + margin;
+
+    if (maxDistance * maxDistance < magnitudeSqr) return false;
 
     if (collision != NULL) {
         float magnitude = sqrtf(magnitudeSqr);
@@ -298,7 +493,7 @@ static bool frComputeCollisionCircles(const frShape *s1,
 }
 
 /* 
-    Checks whether `s1` and `s2` are colliding,
+    Checks whether `s1` and `s2` are colliding or closer than `margin`,
     assuming `s1` is a 'circle' collision shape and `s2` is a 'polygon' 
     collision shape, then stores the collision information to `collision`.
 */
@@ -306,6 +501,7 @@ static bool frComputeCollisionCirclePoly(const frShape *s1,
                                          frTransform tx1,
                                          const frShape *s2,
                                          frTransform tx2,
+                                         float margin,
                                          frCollision *collision) {
     frShape *circle, *poly;
     frTransform circleTx, polyTx;
@@ -342,7 +538,7 @@ static bool frComputeCollisionCirclePoly(const frShape *s1,
                                  frVector2Subtract(txCenter,
                                                    vertices->data[i]));
 
-        if (dot > radius) return false;
+        if (dot > radius + margin) return false;
 
         if (maxDot < dot) maxDot = dot, maxIndex = i;
     }
@@ -396,7 +592,9 @@ static bool frComputeCollisionCirclePoly(const frShape *s1,
 
             float magnitudeSqr = frVector2MagnitudeSqr(direction);
 
-            if (radius * radius < magnitudeSqr) return false;
+            float maxDistance = radius + margin;
+
+            if (maxDistance * maxDistance < magnitudeSqr) return false;
 
             if (collision != NULL) {
                 float magnitude = sqrtf(magnitudeSqr);
@@ -449,7 +647,7 @@ static bool frComputeCollisionCirclePoly(const frShape *s1,
 }
 
 /* 
-    Checks whether `s1` and `s2` are colliding,
+    Checks whether `s1` and `s2` are colliding or closer than `margin`,
     assuming `s1` and `s2` are 'polygon' collision shapes,
     then stores the collision information to `collision`.
 */
@@ -457,16 +655,17 @@ static bool frComputeCollisionPolys(const frShape *s1,
                                     frTransform tx1,
                                     const frShape *s2,
                                     frTransform tx2,
+                                    float margin,
                                     frCollision *collision) {
     float maxDepth1 = FLT_MAX, maxDepth2 = FLT_MAX;
 
     int index1 = frGetSeparatingAxisIndex(s1, tx1, s2, tx2, &maxDepth1);
 
-    if (maxDepth1 >= 0.0f) return false;
+    if (maxDepth1 >= margin) return false;
 
     int index2 = frGetSeparatingAxisIndex(s2, tx2, s1, tx1, &maxDepth2);
 
-    if (maxDepth2 >= 0.0f) return false;
+    if (maxDepth2 >= margin) return false;
 
     if (collision != NULL) {
         frVector2 direction =
@@ -527,7 +726,8 @@ static bool frComputeCollisionPolys(const frShape *s1,
         collision->contacts[0].id = contactIdMask | incEdge.indices[0];
         collision->contacts[1].id = contactIdMask | incEdge.indices[1];
 
-        if (depth1 < 0.0f) {
+        // NOTE: The depth of a speculative contact is at least `-margin`
+        if (depth1 < -margin) {
             collision->contacts[0].id = collision->contacts[1].id;
 
             collision->contacts[0].point = incEdge.data[1];
@@ -536,7 +736,7 @@ static bool frComputeCollisionPolys(const frShape *s1,
             collision->contacts[1] = collision->contacts[0];
 
             collision->count = 1;
-        } else if (depth2 < 0.0f) {
+        } else if (depth2 < -margin) {
             collision->contacts[0].point = incEdge.data[0];
             collision->contacts[0].depth = depth1;
 
@@ -575,52 +775,87 @@ static bool frComputeIntersectionCircleLine(frVector2 center,
     return (dot >= 0.0f && baseSqr >= 0.0f);
 }
 
-/* Computes the intersection of two lines. */
-static bool frComputeIntersectionLines(frVector2 origin1,
-                                       frVector2 direction1,
-                                       frVector2 origin2,
-                                       frVector2 direction2,
-                                       float *distance) {
-    float rXs = frVector2Cross(direction1, direction2);
+/* 
+    Returns the distance between `s1` and `s2`, or a lower bound of it,
+    which will be negative if `s1` and `s2` are overlapping.
+*/
+static float frComputeSeparation(const frShape *s1,
+                                 frTransform tx1,
+                                 const frShape *s2,
+                                 frTransform tx2) {
+    frShapeType type1 = frGetShapeType(s1);
+    frShapeType type2 = frGetShapeType(s2);
+
+    if (type1 == FR_SHAPE_CIRCLE && type2 == FR_SHAPE_CIRCLE) {
+        return frVector2Distance(tx1.position, tx2.position)
+               - (frGetCircleRadius(s1) + frGetCircleRadius(s2));
+    } else if (type1 == FR_SHAPE_POLYGON && type2 == FR_SHAPE_POLYGON) {
+        float maxDepth1 = FLT_MAX, maxDepth2 = FLT_MAX;
+
+        (void) frGetSeparatingAxisIndex(s1, tx1, s2, tx2, &maxDepth1);
+        (void) frGetSeparatingAxisIndex(s2, tx2, s1, tx1, &maxDepth2);
+
+        /*
+            NOTE: This underestimates the distance between two vertices,
+            but is exact for any overlapping pair of convex polygons.
+        */
+        return fmaxf(maxDepth1, maxDepth2);
+    } else if (type1 == FR_SHAPE_CIRCLE || type2 == FR_SHAPE_CIRCLE) {
+        const frShape *circle = s1, *poly = s2;
 
-    frVector2 qp = frVector2Subtract(origin2, origin1);
+        frTransform circleTx = tx1, polyTx = tx2;
 
-    float qpXs = frVector2Cross(qp, direction2);
-    float qpXr = frVector2Cross(qp, direction1);
+        if (type1 != FR_SHAPE_CIRCLE) {
+            circle = s2, poly = s1;
+            circleTx = tx2, polyTx = tx1;
+        }
 
-    if (rXs != 0.0f) {
-        float inverseRxS = 1.0f / rXs;
+        const frVertices *vertices = frGetPolygonVertices(poly);
+        const frVertices *normals = frGetPolygonNormals(poly);
 
-        float t = qpXs * inverseRxS, u = qpXr * inverseRxS;
+        frVector2 txCenter = frVector2Rotate(
+            frVector2Subtract(circleTx.position, polyTx.position),
+            -polyTx.angle);
 
-        if ((t >= 0.0f && t <= 1.0f) && (u >= 0.0f && u <= 1.0f)) {
-            if (distance != NULL) *distance = t;
+        float radius = frGetCircleRadius(circle), maxDot = -FLT_MAX;
 
-            return true;
+        for (int i = 0; i < vertices->count; i++) {
+            float dot = frVector2Dot(normals->data[i],
+                                     frVector2Subtract(txCenter,
+                                                       vertices->data[i]));
+
+            if (maxDot < dot) maxDot = dot;
         }
 
-        return false;
-    } else {
-        if (qpXr != 0.0f) return 0;
+        if (maxDot <= 0.0f) return maxDot - radius;
 
-        float rDr = frVector2Dot(direction1, direction1);
-        float sDr = frVector2Dot(direction2, direction1);
+        float minDistanceSqr = FLT_MAX;
 
-        float inverseRdR = 1.0f / rDr;
+        // NOTE: The closest point might be a vertex of the polygon
+        for (int j = vertices->count - 1, i = 0; i < vertices->count;
+             j = i, i++) {
+            frVector2 edgeVector = frVector2Subtract(vertices->data[i],
+                                                     vertices->data[j]);
 
-        float qpDr = frVector2Dot(qp, direction1);
+            frVector2 toCenter = frVector2Subtract(txCenter,
+                                                   vertices->data[j]);
 
-        float k, t0 = qpDr * inverseRdR, t1 = t0 + sDr * inverseRdR;
+            float t = frVector2Dot(toCenter, edgeVector)
+                      / frVector2MagnitudeSqr(edgeVector);
 
-        if (sDr < 0.0f) k = t0, t0 = t1, t1 = k;
+            if (t < 0.0f) t = 0.0f;
+            else if (t > 1.0f) t = 1.0f;
 
-        if ((t0 < 0.0f && t1 == 0.0f) || (t0 == 1.0f && t1 > 1.0f)) {
-            if (distance != NULL) *distance = (t0 == 1.0f);
+            float distanceSqr = frVector2MagnitudeSqr(
+                frVector2Subtract(toCenter,
+                                  frVector2ScalarMultiply(edgeVector, t)));
 
-            return 1;
+            if (minDistanceSqr > distanceSqr) minDistanceSqr = distanceSqr;
         }
 
-        return (t1 >= 0.0f && t0 <= 1.0f);
+        return sqrtf(minDistanceSqr) - radius;
+    } else {
+        return FLT_MAX;
     }
 }
 
@@ -704,6 +939,27 @@ static int frGetSeparatingAxisIndex(const frShape *s1,
     return maxIndex;
 }
 
+/* 
+    Returns the distance from the origin of `s` 
+    to the farthest point of `s`, if `s` is not a circle.
+*/
+static float frGetShapeBoundingRadius(const frShape *s) {
+    // NOTE: Rotating a circle about its center never moves its boundary
+    if (frGetShapeType(s) != FR_SHAPE_POLYGON) return 0.0f;
+
+    const frVertices *vertices = frGetPolygonVertices(s);
+
+    float maxMagnitudeSqr = 0.0f;
+
+    for (int i = 0; i < vertices->count; i++) {
+        float magnitudeSqr = frVector2MagnitudeSqr(vertices->data[i]);
+
+        if (maxMagnitudeSqr < magnitudeSqr) maxMagnitudeSqr = magnitudeSqr;
+    }
+
+    return sqrtf(maxMagnitudeSqr);
+}
+
 /* Returns the index of the vertex farthest along `v`. */
 static int frGetSupportPointIndex(const frVertices *vertices,
                                   frTransform tx,
@@ -722,3 +978,23 @@ static int frGetSupportPointIndex(const frVertices *vertices,
 
     return maxIndex;
 }
+
+/* 
+    Returns the transform that is `t` of the way from `tx`
+    to `tx` moved by `deltaPosition` and rotated by `deltaAngle`.
+*/
+static frTransform frGetSweptTransform(frTransform tx,
+                                       frVector2 deltaPosition,
+                                       float deltaAngle,
+                                       float t) {
+    frTransform result = {
+        .position = frVector2Add(tx.position,
+                                 frVector2ScalarMultiply(deltaPosition, t)),
+        .angle = tx.angle + (deltaAngle * t)
+    };
+
+    result.rotation.sin_ = sinf(result.angle);
+    result.rotation.cos_ = cosf(result.angle);
+
+    return result;
+}
@@ -0,0 +1,890 @@
+/*
+    Copyright (c) 2021-2025 Jaedeok Kim <jdeokkim@protonmail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a 
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation 
+    the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+    and/or sell copies of the Software, and to permit persons to whom the 
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included 
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Includes ===============================================================> */
+
+#include "external/ferox_utils.h"
+
+#include "ferox.h"
+
+/* Macros =================================================================> */
+
+#define FR_DYNAMIC_TREE_STACK_SIZE  256
+
+/* Typedefs ===============================================================> */
+
+/* A structure that represents a node of a dynamic AABB tree. */
+typedef struct frTreeNode_ {
+    frAABB aabb;
+    int parent, left, right;
+    int height, value;
+    bool moved;
+} frTreeNode;
+
+/* A structure that represents a dynamic AABB tree. */
+struct frDynamicTree_ {
+    frDynArray(frTreeNode) nodes;
+    frDynArray(int) moveBuffer;
+    frDynArray(int) stack;
+    int root, freeList, leafCount;
+    float margin;
+};
+
+/* Private Function Prototypes ============================================> */
+
+/* Allocates a new node from the node pool of `dt`, then returns its index. */
+static int frAllocateTreeNode(frDynamicTree *dt);
+
+/* Returns the node with the given `i`ndex to the node pool of `dt`. */
+static void frFreeTreeNode(frDynamicTree *dt, int i);
+
+/* Inserts a `leaf` node into `dt`. */
+static void frInsertLeaf(frDynamicTree *dt, int leaf);
+
+/* Removes a `leaf` node from `dt`. */
+static void frRemoveLeaf(frDynamicTree *dt, int leaf);
+
+/* Rebuilds all internal nodes of `dt` from its leaf nodes, top-down. */
+static void frRebuildDynamicTree(frDynamicTree *dt);
+
+/* 
+    Builds a subtree from `count` `leaves` of `dt`, 
+    then returns the index of its root node.
+*/
+static int frBuildTreeNodes(frDynamicTree *dt, int *leaves, int count);
+
+/* 
+    Partially sorts `count` `leaves` of `dt` along the given `axis`, 
+    so that the `k`-th leaf is the one with the `k`-th smallest center.
+*/
+static void frSelectTreeLeaves(const frDynamicTree *dt,
+                               int *leaves,
+                               int count,
+                               int k,
+                               int axis);
+
+/*
+    Performs a left or right rotation if the node with the given `i`ndex
+    is imbalanced, then returns the index of the new subtree root.
+*/
+static int frBalanceTreeNode(frDynamicTree *dt, int i);
+
+/*
+    Recomputes the height and the AABB of each ancestor
+    of the node with the given `i`ndex, balancing the tree along the way.
+*/
+static void frRefitTreeNodes(frDynamicTree *dt, int i);
+
+/* Returns the smallest AABB that contains both `a1` and `a2`. */
+static FR_API_INLINE frAABB frGetAABBUnion(frAABB a1, frAABB a2);
+
+/* Returns the perimeter of `aabb`. */
+static FR_API_INLINE float frGetAABBPerimeter(frAABB aabb);
+
+/* Returns the center of the node with the given `i`ndex along `axis`. */
+static FR_API_INLINE float frGetTreeNodeCenter(const frDynamicTree *dt,
+                                               int i,
+                                               int axis);
+
+/* Checks if `a1` fully contains `a2`. */
+static FR_API_INLINE bool frAABBContains(frAABB a1, frAABB a2);
+
+/* Checks if `a1` and `a2` overlap. */
+static FR_API_INLINE bool frAABBOverlaps(frAABB a1, frAABB a2);
+
+/* Public Functions =======================================================> */
+
+/*
+    Creates a new dynamic AABB tree, which will extend the AABB
+    of each object by `margin` on every side.
+*/
+frDynamicTree *frCreateDynamicTree(float margin) {
+    if (margin < 0.0f) return NULL;
+
+    frDynamicTree *dt = calloc(1, sizeof *dt);
+
+    dt->root = dt->freeList = -1;
+    dt->margin = margin;
+
+    frInitDynArray(dt->nodes);
+    frInitDynArray(dt->moveBuffer);
+    frInitDynArray(dt->stack);
+
+    return dt;
+}
+
+/* Releases the memory allocated for `dt`. */
+void frReleaseDynamicTree(frDynamicTree *dt) {
+    if (dt == NULL) return;
+
+    frReleaseDynArray(dt->nodes);
+    frReleaseDynArray(dt->moveBuffer);
+    frReleaseDynArray(dt->stack);
+
+    free(dt);
+}
+
+/* Erases all elements from `dt`. */
+void frClearDynamicTree(frDynamicTree *dt) {
+    if (dt == NULL) return;
+
+    frSetDynArrayLength(dt->nodes, 0);
+    frSetDynArrayLength(dt->moveBuffer, 0);
+
+    dt->root = dt->freeList = -1;
+
+    dt->leafCount = 0;
+}
+
+/* Returns the 'fat' AABB of the root node of `dt`. */
+frAABB frGetDynamicTreeBounds(const frDynamicTree *dt) {
+    if (dt == NULL || dt->root < 0) return (frAABB) { .width = 0.0f };
+
+    return frGetDynArrayValue(dt->nodes, dt->root).aabb;
+}
+
+/*
+    Inserts a `key`-`value` pair into `dt`,
+    then returns the proxy ID of the new element.
+*/
+int frInsertIntoDynamicTree(frDynamicTree *dt, frAABB key, int value) {
+    if (dt == NULL) return -1;
+
+    int proxyId = frAllocateTreeNode(dt);
+
+    frTreeNode *node = &frGetDynArrayValue(dt->nodes, proxyId);
+
+    node->aabb = (frAABB) { .x = key.x - dt->margin,
+                            .y = key.y - dt->margin,
+                            .width = key.width + (2.0f * dt->margin),
+                            .height = key.height + (2.0f * dt->margin) };
+
+    node->value = value, node->moved = true;
+
+    frInsertLeaf(dt, proxyId);
+
+    frDynArrayPush(dt->moveBuffer, proxyId);
+
+    dt->leafCount++;
+
+    return proxyId;
+}
+
+/*
+    Inserts `count` `keys`-`values` pairs into `dt`,
+    then stores the proxy ID of each new element to `proxyIds`.
+*/
+void frInsertManyIntoDynamicTree(frDynamicTree *dt,
+                                 const frAABB *keys,
+                                 const int *values,
+                                 int count,
+                                 int *proxyIds) {
+    if (dt == NULL || keys == NULL || values == NULL || count <= 0) return;
+
+    /*
+        NOTE: Rebuilding the whole tree costs `O(n log n)`, so it is 
+        only worth it when the number of leaves at least doubles.
+    */
+    bool rebuild = (count >= dt->leafCount);
+
+    for (int i = 0; i < count; i++) {
+        int proxyId = frAllocateTreeNode(dt);
+
+        frTreeNode *node = &frGetDynArrayValue(dt->nodes, proxyId);
+
+        node->aabb = (frAABB) { .x = keys[i].x - dt->margin,
+                                .y = keys[i].y - dt->margin,
+                                .width = keys[i].width + (2.0f * dt->margin),
+                                .height = keys[i].height 
+                                          + (2.0f * dt->margin) };
+
+        node->value = values[i], node->moved = true;
+
+        if (!rebuild) frInsertLeaf(dt, proxyId);
+
+        frDynArrayPush(dt->moveBuffer, proxyId);
+
+        if (proxyIds != NULL) proxyIds[i] = proxyId;
+    }
+
+    dt->leafCount += count;
+
+    if (rebuild) frRebuildDynamicTree(dt);
+}
+
+/* Removes an element with the given `proxyId` from `dt`. */
+void frRemoveFromDynamicTree(frDynamicTree *dt, int proxyId) {
+    if (dt == NULL || proxyId < 0 || proxyId >= frGetDynArrayLength(dt->nodes))
+        return;
+
+    frRemoveLeaf(dt, proxyId);
+    frFreeTreeNode(dt, proxyId);
+
+    dt->leafCount--;
+}
+
+/*
+    Updates the `key` of an element with the given `proxyId` in `dt`,
+    then returns `true` if the element had to be re-inserted.
+*/
+bool frUpdateDynamicTree(frDynamicTree *dt, int proxyId, frAABB key) {
+    if (dt == NULL || proxyId < 0 || proxyId >= frGetDynArrayLength(dt->nodes))
+        return false;
+
+    frTreeNode *node = &frGetDynArrayValue(dt->nodes, proxyId);
+
+    /*
+        NOTE: As long as the 'fat' AABB of this element contains
+        its actual AABB, we do not need to touch the tree at all.
+    */
+    if (frAABBContains(node->aabb, key)) return false;
+
+    frRemoveLeaf(dt, proxyId);
+
+    node = &frGetDynArrayValue(dt->nodes, proxyId);
+
+    node->aabb = (frAABB) { .x = key.x - dt->margin,
+                            .y = key.y - dt->margin,
+                            .width = key.width + (2.0f * dt->margin),
+                            .height = key.height + (2.0f * dt->margin) };
+
+    frInsertLeaf(dt, proxyId);
+
+    node = &frGetDynArrayValue(dt->nodes, proxyId);
+
+    if (!node->moved) {
+        node->moved = true;
+
+        frDynArrayPush(dt->moveBuffer, proxyId);
+    }
+
+    return true;
+}
+
+/*
+    Checks if the 'fat' AABBs of two elements with the given
+    `proxyId1` and `proxyId2` in `dt` overlap.
+*/
+bool frCheckDynamicTreeOverlap(const frDynamicTree *dt,
+                               int proxyId1,
+                               int proxyId2) {
+    if (dt == NULL || proxyId1 < 0 || proxyId2 < 0
+        || proxyId1 >= frGetDynArrayLength(dt->nodes)
+        || proxyId2 >= frGetDynArrayLength(dt->nodes))
+        return false;
+
+    return frAABBOverlaps(frGetDynArrayValue(dt->nodes, proxyId1).aabb,
+                          frGetDynArrayValue(dt->nodes, proxyId2).aabb);
+}
+
+/* Sets the `value` of an element with the given `proxyId` in `dt`. */
+void frSetDynamicTreeValue(frDynamicTree *dt, int proxyId, int value) {
+    if (dt == NULL || proxyId < 0 || proxyId >= frGetDynArrayLength(dt->nodes))
+        return;
+
+    frGetDynArrayValue(dt->nodes, proxyId).value = value;
+}
+
+/* Query `dt` for any objects that overlap the given `aabb`. */
+void frQueryDynamicTree(frDynamicTree *dt,
+                        frAABB aabb,
+                        frTreeQueryFunc func,
+                        void *userData) {
+    if (dt == NULL || func == NULL || dt->root < 0) return;
+
+    frSetDynArrayLength(dt->stack, 0);
+
+    frDynArrayPush(dt->stack, dt->root);
+
+    while (frGetDynArrayLength(dt->stack) > 0) {
+        int i = frGetDynArrayValue(dt->stack,
+                                   frGetDynArrayLength(dt->stack) - 1);
+
+        frSetDynArrayLength(dt->stack, frGetDynArrayLength(dt->stack) - 1);
+
+        const frTreeNode *node = &frGetDynArrayValue(dt->nodes, i);
+
+        if (!frAABBOverlaps(node->aabb, aabb)) continue;
+
+        if (node->left < 0) {
+            func((frContextNode) { .id = node->value, .ctx = userData });
+        } else {
+            frDynArrayPush(dt->stack, node->left);
+            frDynArrayPush(dt->stack, node->right);
+        }
+    }
+}
+
+/*
+    Query `dt` for any pairs of objects that started to overlap
+    since the last call to this function.
+*/
+void frQueryDynamicTreePairs(frDynamicTree *dt,
+                             frPairQueryFunc func,
+                             void *userData) {
+    if (dt == NULL || func == NULL) return;
+
+    for (int i = 0; i < frGetDynArrayLength(dt->moveBuffer); i++) {
+        int proxyId = frGetDynArrayValue(dt->moveBuffer, i);
+
+        const frTreeNode *node = &frGetDynArrayValue(dt->nodes, proxyId);
+
+        // NOTE: This element might have been removed after being moved
+        if (!node->moved || node->left >= 0) continue;
+
+        frSetDynArrayLength(dt->stack, 0);
+
+        frDynArrayPush(dt->stack, dt->root);
+
+        while (frGetDynArrayLength(dt->stack) > 0) {
+            int j = frGetDynArrayValue(dt->stack,
+                                       frGetDynArrayLength(dt->stack) - 1);
+
+            frSetDynArrayLength(dt->stack, frGetDynArrayLength(dt->stack) - 1);
+
+            const frTreeNode *other = &frGetDynArrayValue(dt->nodes, j);
+
+            if (j == proxyId || !frAABBOverlaps(other->aabb, node->aabb))
+                continue;
+
+            if (other->left < 0) {
+                /*
+                    NOTE: If both elements have been moved, then the pair
+                    will be reported only once, by the one with the
+                    smaller proxy ID.
+                */
+                if (other->moved && j < proxyId) continue;
+
+                func(node->value, other->value, userData);
+            } else {
+                frDynArrayPush(dt->stack, other->left);
+                frDynArrayPush(dt->stack, other->right);
+            }
+        }
+    }
+
+    for (int i = 0; i < frGetDynArrayLength(dt->moveBuffer); i++)
+        frGetDynArrayValue(dt->nodes, frGetDynArrayValue(dt->moveBuffer, i))
+            .moved = false;
+
+    frSetDynArrayLength(dt->moveBuffer, 0);
+}
+
+/*
+    Casts a `ray` against `dt`, then calls `func` for each object 
+    whose AABB is hit by `ray`, which returns the new maximum distance 
+    of `ray`.
+*/
+void frRaycastDynamicTree(frDynamicTree *dt,
+                          frRay ray,
+                          frTreeRaycastFunc func,
+                          void *userData) {
+    if (dt == NULL || func == NULL || dt->root < 0) return;
+
+    /*
+        NOTE: Unlike the other queries, this function uses its own stack
+        instead of `dt->stack`, so that many rays can be cast against `dt`
+        at the same time. The stack will be moved to the heap
+        only if the tree gets too tall.
+    */
+    int localStack[FR_DYNAMIC_TREE_STACK_SIZE], *stack = localStack;
+
+    int stackCapacity = FR_DYNAMIC_TREE_STACK_SIZE, stackSize = 0;
+
+    stack[stackSize++] = dt->root;
+
+    while (stackSize > 0) {
+        const frTreeNode *node = &frGetDynArrayValue(dt->nodes,
+                                                     stack[--stackSize]);
+
+        // NOTE: `ray.maxDistance` gets shorter as `func` finds closer hits
+        if (!frComputeAABBRaycast(node->aabb, ray, NULL)) continue;
+
+        if (node->left < 0) {
+            float newMaxDistance = func(
+                (frContextNode) { .id = node->value, .ctx = userData },
+                ray.maxDistance);
+
+            // NOTE: The callback function wants us to stop right away
+            if (newMaxDistance <= 0.0f) break;
+
+            if (ray.maxDistance > newMaxDistance)
+                ray.maxDistance = newMaxDistance;
+        } else {
+            if (stackSize + 2 > stackCapacity) {
+                int *newStack = malloc(2 * stackCapacity * sizeof *newStack);
+
+                memcpy(newStack, stack, stackSize * sizeof *newStack);
+
+                if (stack != localStack) free(stack);
+
+                stack = newStack, stackCapacity *= 2;
+            }
+
+            stack[stackSize++] = node->left;
+            stack[stackSize++] = node->right;
+        }
+    }
+
+    if (stack != localStack) free(stack);
+}
+
+/* Private Functions ======================================================> */
+
+/* Allocates a new node from the node pool of `dt`, then returns its index. */
+static int frAllocateTreeNode(frDynamicTree *dt) {
+    int i = dt->freeList;
+
+    if (i >= 0) {
+        dt->freeList = frGetDynArrayValue(dt->nodes, i).parent;
+    } else {
+        frDynArrayPush(dt->nodes, frStructZero(frTreeNode));
+
+        i = frGetDynArrayLength(dt->nodes) - 1;
+    }
+
+    frGetDynArrayValue(dt->nodes, i) = (frTreeNode) { .parent = -1,
+                                                      .left = -1,
+                                                      .right = -1,
+                                                      .value = -1 };
+
+    return i;
+}
+
+/* Returns the node with the given `i`ndex to the node pool of `dt`. */
+static void frFreeTreeNode(frDynamicTree *dt, int i) {
+    // NOTE: The `parent` field of a free node points to the next free node
+    frGetDynArrayValue(dt->nodes, i) = (frTreeNode) { .parent = dt->freeList,
+                                                      .left = -1,
+                                                      .right = -1,
+                                                      .height = -1,
+                                                      .value = -1 };
+
+    dt->freeList = i;
+}
+
+/* Inserts a `leaf` node into `dt`. */
+static void frInsertLeaf(frDynamicTree *dt, int leaf) {
+    if (dt->root < 0) {
+        dt->root = leaf;
+
+        frGetDynArrayValue(dt->nodes, leaf).parent = -1;
+
+        return;
+    }
+
+    frAABB leafAABB = frGetDynArrayValue(dt->nodes, leaf).aabb;
+
+    int i = dt->root;
+
+    /*
+        NOTE: Finds the best sibling for the new leaf node
+        with the 'surface area heuristic' (SAH), where the cost
+        of a node is the perimeter of its AABB.
+    */
+    while (frGetDynArrayValue(dt->nodes, i).left >= 0) {
+        const frTreeNode *node = &frGetDynArrayValue(dt->nodes, i);
+
+        const frTreeNode *left = &frGetDynArrayValue(dt->nodes, node->left);
+        const frTreeNode *right = &frGetDynArrayValue(dt->nodes, node->right);
+
+        float perimeter = frGetAABBPerimeter(node->aabb);
+
+        float unionPerimeter = frGetAABBPerimeter(
+            frGetAABBUnion(node->aabb, leafAABB));
+
+        float cost = 2.0f * unionPerimeter;
+
+        float inheritanceCost = 2.0f * (unionPerimeter - perimeter);
+
+        float leftCost = frGetAABBPerimeter(
+                             frGetAABBUnion(leafAABB, left->aabb))
+                         + inheritanceCost;
+
+        if (left->left >= 0) leftCost -= frGetAABBPerimeter(left->aabb);
+
+        float rightCost = frGetAABBPerimeter(
+                              frGetAABBUnion(leafAABB, right->aabb))
+                          + inheritanceCost;
+
+        if (right->left >= 0) rightCost -= frGetAABBPerimeter(right->aabb);
+
+        if (cost < leftCost && cost < rightCost) break;
+
+        i = (leftCost < rightCost) ? node->left : node->right;
+    }
+
+    int sibling = i;
+
+    int newParent = frAllocateTreeNode(dt);
+
+    frTreeNode *siblingNode = &frGetDynArrayValue(dt->nodes, sibling);
+    frTreeNode *parentNode = &frGetDynArrayValue(dt->nodes, newParent);
+
+    int oldParent = siblingNode->parent;
+
+    parentNode->parent = oldParent;
+    parentNode->left = sibling, parentNode->right = leaf;
+    parentNode->aabb = frGetAABBUnion(siblingNode->aabb, leafAABB);
+    parentNode->height = siblingNode->height + 1;
+
+    siblingNode->parent = newParent;
+
+    frGetDynArrayValue(dt->nodes, leaf).parent = newParent;
+
+    if (oldParent >= 0) {
+        frTreeNode *oldParentNode = &frGetDynArrayValue(dt->nodes, oldParent);
+
+        if (oldParentNode->left == sibling)
+            oldParentNode->left = newParent;
+        else
+            oldParentNode->right = newParent;
+    } else {
+        dt->root = newParent;
+    }
+
+    frRefitTreeNodes(dt, newParent);
+}
+
+/* Removes a `leaf` node from `dt`. */
+static void frRemoveLeaf(frDynamicTree *dt, int leaf) {
+    if (dt->root == leaf) {
+        dt->root = -1;
+
+        return;
+    }
+
+    int parent = frGetDynArrayValue(dt->nodes, leaf).parent;
+
+    const frTreeNode *parentNode = &frGetDynArrayValue(dt->nodes, parent);
+
+    int grandParent = parentNode->parent;
+
+    int sibling = (parentNode->left == leaf) ? parentNode->right
+                                             : parentNode->left;
+
+    frGetDynArrayValue(dt->nodes, sibling).parent = grandParent;
+
+    if (grandParent >= 0) {
+        frTreeNode *grandParentNode = &frGetDynArrayValue(dt->nodes,
+                                                          grandParent);
+
+        if (grandParentNode->left == parent)
+            grandParentNode->left = sibling;
+        else
+            grandParentNode->right = sibling;
+
+        frFreeTreeNode(dt, parent);
+
+        frRefitTreeNodes(dt, grandParent);
+    } else {
+        dt->root = sibling;
+
+        frFreeTreeNode(dt, parent);
+    }
+}
+
+/* Rebuilds all internal nodes of `dt` from its leaf nodes, top-down. */
+static void frRebuildDynamicTree(frDynamicTree *dt) {
+    // NOTE: The query stack is free to be used as scratch memory here
+    frSetDynArrayLength(dt->stack, 0);
+
+    for (int i = 0; i < frGetDynArrayLength(dt->nodes); i++) {
+        const frTreeNode *node = &frGetDynArrayValue(dt->nodes, i);
+
+        // NOTE: The height of a free node is always `-1`
+        if (node->height < 0) continue;
+
+        if (node->left < 0) frDynArrayPush(dt->stack, i);
+        else frFreeTreeNode(dt, i);
+    }
+
+    int leafCount = frGetDynArrayLength(dt->stack);
+
+    if (leafCount <= 0) {
+        dt->root = -1;
+
+        return;
+    }
+
+    dt->root = frBuildTreeNodes(dt, dt->stack.buffer, leafCount);
+
+    frGetDynArrayValue(dt->nodes, dt->root).parent = -1;
+}
+
+/* 
+    Builds a subtree from `count` `leaves` of `dt`, 
+    then returns the index of its root node.
+*/
+static int frBuildTreeNodes(frDynamicTree *dt, int *leaves, int count) {
+    if (count == 1) return leaves[0];
+
+    float minX = FLT_MAX, minY = FLT_MAX;
+    float maxX = -FLT_MAX, maxY = -FLT_MAX;
+
+    for (int i = 0; i < count; i++) {
+        float x = frGetTreeNodeCenter(dt, leaves[i], 0);
+        float y = frGetTreeNodeCenter(dt, leaves[i], 1);
+
+        if (minX > x) minX = x;
+        if (minY > y) minY = y;
+
+        if (maxX < x) maxX = x;
+        if (maxY < y) maxY = y;
+    }
+
+    /*
+        NOTE: Splitting at the median along the longest axis 
+        of the centers keeps the tree perfectly balanced.
+    */
+    int axis = ((maxX - minX) >= (maxY - minY)) ? 0 : 1;
+
+    int half = count >> 1;
+
+    frSelectTreeLeaves(dt, leaves, count, half, axis);
+
+    int left = frBuildTreeNodes(dt, leaves, half);
+    int right = frBuildTreeNodes(dt, leaves + half, count - half);
+
+    int i = frAllocateTreeNode(dt);
+
+    frTreeNode *node = &frGetDynArrayValue(dt->nodes, i);
+
+    frTreeNode *leftNode = &frGetDynArrayValue(dt->nodes, left);
+    frTreeNode *rightNode = &frGetDynArrayValue(dt->nodes, right);
+
+    node->left = left, node->right = right;
+    node->aabb = frGetAABBUnion(leftNode->aabb, rightNode->aabb);
+    node->height = 1 + ((leftNode->height > rightNode->height)
+                            ? leftNode->height
+                            : rightNode->height);
+
+    leftNode->parent = rightNode->parent = i;
+
+    return i;
+}
+
+/* 
+    Partially sorts `count` `leaves` of `dt` along the given `axis`, 
+    so that the `k`-th leaf is the one with the `k`-th smallest center.
+*/
+static void frSelectTreeLeaves(const frDynamicTree *dt,
+                               int *leaves,
+                               int count,
+                               int k,
+                               int axis) {
+    int low = 0, high = count - 1;
+
+    while (low < high) {
+        float pivot = frGetTreeNodeCenter(dt, leaves[(low + high) >> 1], axis);
+
+        int i = low, j = high;
+
+        while (i <= j) {
+            while (frGetTreeNodeCenter(dt, leaves[i], axis) < pivot) i++;
+            while (frGetTreeNodeCenter(dt, leaves[j], axis) > pivot) j--;
+
+            if (i <= j) {
+                int tmp = leaves[i];
+
+                leaves[i] = leaves[j], leaves[j] = tmp;
+
+                i++, j--;
+            }
+        }
+
+        if (k <= j) high = j;
+        else if (k >= i) low = i;
+        else break;
+    }
+}
+
+/*
+    Performs a left or right rotation if the node with the given `i`ndex
+    is imbalanced, then returns the index of the new subtree root.
+*/
+static int frBalanceTreeNode(frDynamicTree *dt, int i) {
+    frTreeNode *a = &frGetDynArrayValue(dt->nodes, i);
+
+    if (a->left < 0 || a->height < 2) return i;
+
+    int iB = a->left, iC = a->right;
+
+    frTreeNode *b = &frGetDynArrayValue(dt->nodes, iB);
+    frTreeNode *c = &frGetDynArrayValue(dt->nodes, iC);
+
+    int balance = c->height - b->height;
+
+    /*
+        NOTE: `a` is the root of the imbalanced subtree, and one of
+        its children (`b` or `c`) will be promoted to replace it.
+
+              a                     c
+             / \                   / \
+            b   c       =>        a   f   (or `g`)
+               / \               / \
+              f   g             b   g     (or `f`)
+    */
+
+    if (balance > 1) {
+        int iF = c->left, iG = c->right;
+
+        frTreeNode *f = &frGetDynArrayValue(dt->nodes, iF);
+        frTreeNode *g = &frGetDynArrayValue(dt->nodes, iG);
+
+        c->left = i, c->parent = a->parent, a->parent = iC;
+
+        if (c->parent >= 0) {
+            frTreeNode *parent = &frGetDynArrayValue(dt->nodes, c->parent);
+
+            if (parent->left == i)
+                parent->left = iC;
+            else
+                parent->right = iC;
+        } else {
+            dt->root = iC;
+        }
+
+        if (f->height > g->height) {
+            c->right = iF, a->right = iG, g->parent = i;
+
+            a->aabb = frGetAABBUnion(b->aabb, g->aabb);
+            c->aabb = frGetAABBUnion(a->aabb, f->aabb);
+
+            a->height = 1 + ((b->height > g->height) ? b->height : g->height);
+            c->height = 1 + ((a->height > f->height) ? a->height : f->height);
+        } else {
+            c->right = iG, a->right = iF, f->parent = i;
+
+            a->aabb = frGetAABBUnion(b->aabb, f->aabb);
+            c->aabb = frGetAABBUnion(a->aabb, g->aabb);
+
+            a->height = 1 + ((b->height > f->height) ? b->height : f->height);
+            c->height = 1 + ((a->height > g->height) ? a->height : g->height);
+        }
+
+        return iC;
+    } else if (balance < -1) {
+        int iD = b->left, iE = b->right;
+
+        frTreeNode *d = &frGetDynArrayValue(dt->nodes, iD);
+        frTreeNode *e = &frGetDynArrayValue(dt->nodes, iE);
+
+        b->left = i, b->parent = a->parent, a->parent = iB;
+
+        if (b->parent >= 0) {
+            frTreeNode *parent = &frGetDynArrayValue(dt->nodes, b->parent);
+
+            if (parent->left == i)
+                parent->left = iB;
+            else
+                parent->right = iB;
+        } else {
+            dt->root = iB;
+        }
+
+        if (d->height > e->height) {
+            b->right = iD, a->left = iE, e->parent = i;
+
+            a->aabb = frGetAABBUnion(c->aabb, e->aabb);
+            b->aabb = frGetAABBUnion(a->aabb, d->aabb);
+
+            a->height = 1 + ((c->height > e->height) ? c->height : e->height);
+            b->height = 1 + ((a->height > d->height) ? a->height : d->height);
+        } else {
+            b->right = iE, a->left = iD, d->parent = i;
+
+            a->aabb = frGetAABBUnion(c->aabb, d->aabb);
+            b->aabb = frGetAABBUnion(a->aabb, e->aabb);
+
+            a->height = 1 + ((c->height > d->height) ? c->height : d->height);
+            b->height = 1 + ((a->height > e->height) ? a->height : e->height);
+        }
+
+        return iB;
+    }
+
+    return i;
+}
+
+/*
+    Recomputes the height and the AABB of each ancestor
+    of the node with the given `i`ndex, balancing the tree along the way.
+*/
+static void frRefitTreeNodes(frDynamicTree *dt, int i) {
+    while (i >= 0) {
+        i = frBalanceTreeNode(dt, i);
+
+        frTreeNode *node = &frGetDynArrayValue(dt->nodes, i);
+
+        const frTreeNode *left = &frGetDynArrayValue(dt->nodes, node->left);
+        const frTreeNode *right = &frGetDynArrayValue(dt->nodes, node->right);
+
+        node->height = 1
+                       + ((left->height > right->height) ? left->height
+                                                         : right->height);
+
+        node->aabb = frGetAABBUnion(left->aabb, right->aabb);
+
+        i = node->parent;
+    }
+}
+
+/* Returns the smallest AABB that contains both `a1` and `a2`. */
+static FR_API_INLINE frAABB frGetAABBUnion(frAABB a1, frAABB a2) {
+    float minX = fminf(a1.x, a2.x), minY = fminf(a1.y, a2.y);
+
+    float maxX = fmaxf(a1.x + a1.width, a2.x + a2.width);
+    float maxY = fmaxf(a1.y + a1.height, a2.y + a2.height);
+
+    return (frAABB) {
+        .x = minX, .y = minY, .width = maxX - minX, .height = maxY - minY
+    };
+}
+
+/* Returns the perimeter of `aabb`. */
+static FR_API_INLINE float frGetAABBPerimeter(frAABB aabb) {
+    return 2.0f * (aabb.width + aabb.height);
+}
+
+/* Returns the center of the node with the given `i`ndex along `axis`. */
+static FR_API_INLINE float frGetTreeNodeCenter(const frDynamicTree *dt,
+                                               int i,
+                                               int axis) {
+    frAABB aabb = frGetDynArrayValue(dt->nodes, i).aabb;
+
+    return (axis == 0) ? aabb.x + 0.5f * aabb.width
+                       : aabb.y + 0.5f * aabb.height;
+}
+
+/* Checks if `a1` fully contains `a2`. */
+static FR_API_INLINE bool frAABBContains(frAABB a1, frAABB a2) {
+    return (a1.x <= a2.x && a1.y <= a2.y)
+           && (a2.x + a2.width <= a1.x + a1.width)
+           && (a2.y + a2.height <= a1.y + a1.height);
+}
+
+/* Checks if `a1` and `a2` overlap. */
+static FR_API_INLINE bool frAABBOverlaps(frAABB a1, frAABB a2) {
+    return (a1.x <= a2.x + a2.width && a2.x <= a1.x + a1.width)
+           && (a1.y <= a2.y + a2.height && a2.y <= a1.y + a1.height);
+}
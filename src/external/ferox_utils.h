@@ -129,6 +129,14 @@
         (arr).buffer[(arr).length] = (newValue), (arr).length++;  \
     } while (0)
 
+/* Increases the capacity of `arr` to at least `minCapacity`. */
+#define frReserveDynArray(arr, minCapacity)              \
+    do {                                                 \
+        if ((arr).buffer == NULL                         \
+            || (arr).capacity < (size_t) (minCapacity))  \
+            frSetDynArrayCapacity((arr), (minCapacity)); \
+    } while (0)
+
 /* Swaps the `i`-th value and the `j`-th value of `arr`. */
 #define frDynArraySwap(type, arr, i, j)         \
     do {                                        \
@@ -193,6 +201,33 @@
        free((rbf).buffer);        \
     } while (0)
 
+/* Returns `true` if `rbf` cannot hold any more values. */
+#define frIsRingBufferFull(rbf)  \
+    ((((rbf).head + 1) & ((rbf).length - 1)) == (rbf).tail)
+
+/* 
+    Doubles the length of `rbf`, moving the values that wrapped around 
+    to the end of the old buffer so that their order is preserved.
+*/
+#define frGrowRingBuffer(rbf)                                          \
+    do {                                                               \
+        size_t oldLength = (rbf).length;                               \
+                                                                       \
+        void *newBuffer = realloc((rbf).buffer,                        \
+            (oldLength << 1) * sizeof *((rbf).buffer));                \
+                                                                       \
+        if (newBuffer != NULL) {                                       \
+            (rbf).buffer = newBuffer, (rbf).length = oldLength << 1;   \
+                                                                       \
+            if ((rbf).head < (rbf).tail) {                             \
+                memcpy((rbf).buffer + oldLength, (rbf).buffer,         \
+                       (rbf).head * sizeof *((rbf).buffer));           \
+                                                                       \
+                (rbf).head += oldLength;                               \
+            }                                                          \
+        }                                                              \
+    } while (0)
+
 /* Adds a `value` to `rbf`. */
 #define frAddToRingBuffer(rbf, value)                            \
     ((((rbf).head + 1) & ((rbf).length - 1)) != (rbf).tail       \
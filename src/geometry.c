@@ -47,6 +47,11 @@ struct frShape_ {
     float area;
 };
 
+/* Private Variables ======================================================> */
+
+/* The memory pool for all collision shapes. */
+static frPool *shapePool;
+
 /* Private Function Prototypes ============================================> */
 
 /* 
@@ -61,7 +66,8 @@ static void frJarvisMarch(const frVertices *input, frVertices *output);
 frShape *frCreateCircle(frMaterial material, float radius) {
     if (radius <= 0.0f) return NULL;
 
-    frShape *result = calloc(1, sizeof *result);
+    frShape *result = frAllocateFromPool(
+        frCreatePoolOnce(&shapePool, sizeof *result));
 
     result->type = FR_SHAPE_CIRCLE;
     result->material = material;
@@ -75,7 +81,8 @@ frShape *frCreateCircle(frMaterial material, float radius) {
 frShape *frCreateRectangle(frMaterial material, float width, float height) {
     if (width <= 0.0f || height <= 0.0f) return NULL;
 
-    frShape *result = calloc(1, sizeof *result);
+    frShape *result = frAllocateFromPool(
+        frCreatePoolOnce(&shapePool, sizeof *result));
 
     result->type = FR_SHAPE_POLYGON;
     result->material = material;
@@ -98,7 +105,8 @@ frShape *frCreateRectangle(frMaterial material, float width, float height) {
 frShape *frCreatePolygon(frMaterial material, const frVertices *vertices) {
     if (vertices == NULL || vertices->count <= 0) return NULL;
 
-    frShape *result = calloc(1, sizeof *result);
+    frShape *result = frAllocateFromPool(
+        frCreatePoolOnce(&shapePool, sizeof *result));
 
     result->type = FR_SHAPE_POLYGON;
     result->material = material;
@@ -110,7 +118,20 @@ frShape *frCreatePolygon(frMaterial material, const frVertices *vertices) {
 
 /* Releases the memory allocated by `s`. */
 void frReleaseShape(frShape *s) {
-    free(s);
+    frFreeToPool(shapePool, s);
+}
+
+/* Returns a handle to `s`. */
+frHandle frGetShapeHandle(const frShape *s) {
+    return frGetPoolHandle(shapePool, s);
+}
+
+/* 
+    Returns the collision shape of `handle`, or `NULL` if the collision 
+    shape has been released since `handle` was created.
+*/
+frShape *frGetShapeFromHandle(frHandle handle) {
+    return frGetPoolBlock(shapePool, handle);
 }
 
 /* Returns the type of `s`. */
@@ -22,10 +22,63 @@
 
 /* Includes ===============================================================> */
 
+#include "external/ferox_utils.h"
+
 #include "ferox.h"
 
+/*
+    NOTE: The contact solver uses the widest vector instructions 
+    available at compile time, and falls back to plain arrays 
+    of four floats if there are none.
+*/
+#if defined(__AVX2__)
+    #include <immintrin.h>
+
+    #define FR_SOLVER_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+
+    #define FR_SOLVER_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+
+    #define FR_SOLVER_NEON
+#endif
+
+/* Macros =================================================================> */
+
+#ifdef FR_SOLVER_AVX2
+    /* The number of collisions in a contact batch. */
+    #define FR_SOLVER_LANE_COUNT  8
+#else
+    /* The number of collisions in a contact batch. */
+    #define FR_SOLVER_LANE_COUNT  4
+#endif
+
+/* 
+    Returns the given `field` of `b`, which lives in the body storage 
+    of `b` if `b` has been added to one, or in `b` itself otherwise.
+*/
+#define frBodyField(b, field)                                      \
+    (*(((b)->storage != NULL)                                     \
+           ? &frGetDynArrayValue((b)->storage->field, (b)->index)  \
+           : &(b)->field))
+
 /* Typedefs ===============================================================> */
 
+#if defined(FR_SOLVER_AVX2)
+    typedef __m256 frFloatW;
+#elif defined(FR_SOLVER_SSE2)
+    typedef __m128 frFloatW;
+#elif defined(FR_SOLVER_NEON)
+    typedef float32x4_t frFloatW;
+#else
+    typedef struct frFloatW_ {
+        float v[FR_SOLVER_LANE_COUNT];
+    } frFloatW;
+#endif
+
 /* A structure that represents the motion data of a rigid body. */
 typedef struct frMotionData_ {
     float mass, inverseMass;
@@ -39,35 +92,194 @@ typedef struct frMotionData_ {
 
 /* A structure that represents a rigid body. */
 struct frBody_ {
+    frBodyStorage *storage;
+    int index;
     frMotionData mtn;
     frTransform tx;
     frShape *shape;
     frBodyType type;
     frBodyFlags flags;
     frAABB aabb;
+    float sleepTime;
+    bool sleeping, *sleepFlag;
     void *ctx;
 };
 
+/* 
+    A structure that represents the hot data of rigid bodies, 
+    stored in the SoA layout.
+
+    NOTE: Each field has the same name as the field of `frBody` 
+    it replaces, so that `frBodyField()` can be used for both.
+*/
+struct frBodyStorage_ {
+    frDynArray(frBody *) bodies;
+    struct {
+        frDynArray(float) mass, inverseMass;
+        frDynArray(float) inertia, inverseInertia;
+        frDynArray(frVector2) velocity;
+        frDynArray(float) angularVelocity;
+        frDynArray(float) gravityScale;
+        frDynArray(frVector2) force;
+        frDynArray(float) torque;
+    } mtn;
+    frDynArray(frTransform) tx;
+    frDynArray(frShape *) shape;
+    frDynArray(frBodyType) type;
+    frDynArray(frAABB) aabb;
+    frDynArray(bool) sleeping;
+};
+
+/* 
+    A structure that represents the contact constraints 
+    of `FR_SOLVER_LANE_COUNT` collisions, stored in the SoA layout.
+*/
+typedef struct frContactBatch_ {
+    frBody *bodies[2][FR_SOLVER_LANE_COUNT];
+    frCollision *collisions[FR_SOLVER_LANE_COUNT];
+    float inverseMasses[2][FR_SOLVER_LANE_COUNT];
+    float inverseInertias[2][FR_SOLVER_LANE_COUNT];
+    float normalX[FR_SOLVER_LANE_COUNT], normalY[FR_SOLVER_LANE_COUNT];
+    float tangentX[FR_SOLVER_LANE_COUNT], tangentY[FR_SOLVER_LANE_COUNT];
+    float friction[FR_SOLVER_LANE_COUNT];
+    float restitution[FR_SOLVER_LANE_COUNT];
+    struct {
+        float relPositionX[2][FR_SOLVER_LANE_COUNT];
+        float relPositionY[2][FR_SOLVER_LANE_COUNT];
+        float relNormalX[2][FR_SOLVER_LANE_COUNT];
+        float relNormalY[2][FR_SOLVER_LANE_COUNT];
+        float biasScalar[FR_SOLVER_LANE_COUNT];
+        float normalMass[FR_SOLVER_LANE_COUNT];
+        float normalScalar[FR_SOLVER_LANE_COUNT];
+        float tangentMass[FR_SOLVER_LANE_COUNT];
+        float tangentScalar[FR_SOLVER_LANE_COUNT];
+    } contacts[2];
+    int count;
+} frContactBatch;
+
+/* A structure that represents a SIMD contact solver. */
+struct frContactSolver_ {
+    frDynArray(frContactBatch) batches;
+    bool closed;
+};
+
 /* Constants ==============================================================> */
 
 /* Constants for `frNormalizeAngle()`. */
 const float TWO_PI = 2.0f * M_PI, INVERSE_TWO_PI = 1.0f / (2.0f * M_PI);
 
+/* 
+    Constants for `frResolveCollisionSoft()`, which define the stiffness
+    of a soft contact constraint and how fast it can push two overlapping
+    bodies apart, in meters per second.
+*/
+static const float CONTACT_HERTZ = 30.0f, CONTACT_DAMPING_RATIO = 10.0f,
+                   CONTACT_MAX_PUSH_VELOCITY = 3.0f;
+
+/* 
+    Constants for `frApplyCollisionRestitution()`, which defines how fast
+    two bodies must approach each other to bounce off, in meters per second.
+*/
+static const float RESTITUTION_THRESHOLD = 1.0f;
+
+/* Private Variables ======================================================> */
+
+/* The memory pool for all rigid bodies. */
+static frPool *bodyPool;
+
 /* Private Function Prototypes ============================================> */
 
 /* Computes the mass and the moment of inertia for `b`. */
 static void frComputeBodyMass(frBody *b);
 
+/* 
+    Moves the data of `b` from the body storage of `b` 
+    back to `b` itself.
+*/
+static void frDetachBodyFromStorage(frBody *b);
+
+/* Swaps the data at index `i` of `bs` with the data at index `j`. */
+static void frSwapBodyStorageData(frBodyStorage *bs, int i, int j);
+
+/* Sets the number of bodies in `bs` to `length`. */
+static void frSetBodyStorageLength(frBodyStorage *bs, int length);
+
+/* Sets the `angle` of `b`, in radians, without waking `b` up. */
+static void frSetBodyRotation(frBody *b, float angle);
+
+/* Sets the `angle` of `tx`, in radians. */
+static FR_API_INLINE void frSetTransformAngle(frTransform *tx, float angle);
+
+/* 
+    Applies an `impulse` to `b2` and the opposite impulse to `b1`, 
+    at the given positions relative to each body.
+*/
+static FR_API_INLINE void frApplyContactImpulse(frBody *b1,
+                                                frBody *b2,
+                                                frVector2 relPosition1,
+                                                frVector2 relPosition2,
+                                                frVector2 impulse);
+
+/* 
+    Returns the velocity of `b2` relative to `b1` at the given positions 
+    relative to each body.
+*/
+static FR_API_INLINE frVector2 frGetContactVelocity(const frBody *b1,
+                                                    const frBody *b2,
+                                                    frVector2 relPosition1,
+                                                    frVector2 relPosition2);
+
+/* 
+    Returns the velocity bias of a contact with the given `depth`, 
+    which pushes two overlapping bodies apart or lets two separated 
+    bodies approach each other by their distance in a step.
+*/
+static FR_API_INLINE float frGetContactBiasScalar(float depth,
+                                                  float inverseDt,
+                                                  float baumgarteFactor,
+                                                  float baumgarteSlop);
+
 /* Normalizes the `angle` to a range `[0, 2π]`. */
 static FR_API_INLINE float frNormalizeAngle(float angle);
 
+/* 
+    Resolves the collisions in `batch` at the same time, then returns 
+    the largest change in the accumulated impulses of `batch`.
+*/
+static float frResolveContactBatch(frContactBatch *batch);
+
+/* Returns a vector with all lanes set to `f`. */
+static FR_API_INLINE frFloatW frSetFloatW(float f);
+
+/* Loads a vector from the given array of floats. */
+static FR_API_INLINE frFloatW frLoadFloatW(const float *ptr);
+
+/* Stores `v` to the given array of floats. */
+static FR_API_INLINE void frStoreFloatW(float *ptr, frFloatW v);
+
+/* Adds `v1` and `v2`, lane by lane. */
+static FR_API_INLINE frFloatW frAddFloatW(frFloatW v1, frFloatW v2);
+
+/* Subtracts `v2` from `v1`, lane by lane. */
+static FR_API_INLINE frFloatW frSubtractFloatW(frFloatW v1, frFloatW v2);
+
+/* Multiplies `v1` by `v2`, lane by lane. */
+static FR_API_INLINE frFloatW frMultiplyFloatW(frFloatW v1, frFloatW v2);
+
+/* Returns the smaller of `v1` and `v2`, lane by lane. */
+static FR_API_INLINE frFloatW frMinFloatW(frFloatW v1, frFloatW v2);
+
+/* Returns the larger of `v1` and `v2`, lane by lane. */
+static FR_API_INLINE frFloatW frMaxFloatW(frFloatW v1, frFloatW v2);
+
 /* Public Functions =======================================================> */
 
 /* Creates a rigid body at `position`. */
 frBody *frCreateBody(frBodyType type, frVector2 position) {
     if (type < FR_BODY_STATIC || type > FR_BODY_DYNAMIC) return NULL;
 
-    frBody *result = calloc(1, sizeof *result);
+    frBody *result = frAllocateFromPool(
+        frCreatePoolOnce(&bodyPool, sizeof *result));
 
     result->type = type;
 
@@ -92,12 +304,25 @@ frBody *frCreateBodyFromShape(frBodyType type, frVector2 position, frShape *s) {
 
 /* Releases the memory allocated for `b`. */
 void frReleaseBody(frBody *b) {
-    free(b);
+    frFreeToPool(bodyPool, b);
+}
+
+/* Returns a handle to `b`. */
+frHandle frGetBodyHandle(const frBody *b) {
+    return frGetPoolHandle(bodyPool, b);
+}
+
+/* 
+    Returns the rigid body of `handle`, or `NULL` if the rigid body 
+    has been released since `handle` was created.
+*/
+frBody *frGetBodyFromHandle(frHandle handle) {
+    return frGetPoolBlock(bodyPool, handle);
 }
 
 /* Returns the type of `b`. */
 frBodyType frGetBodyType(const frBody *b) {
-    return (b != NULL) ? b->type : FR_BODY_UNKNOWN;
+    return (b != NULL) ? frBodyField(b, type) : FR_BODY_UNKNOWN;
 }
 
 /* Returns the property flags of `b`. */
@@ -107,72 +332,74 @@ frBodyFlags frGetBodyFlags(const frBody *b) {
 
 /* Returns the collision shape of `b`. */
 frShape *frGetBodyShape(const frBody *b) {
-    return (b != NULL) ? b->shape : NULL;
+    return (b != NULL) ? frBodyField(b, shape) : NULL;
 }
 
 /* Returns the transform of `b`. */
 frTransform frGetBodyTransform(const frBody *b) {
-    return (b != NULL) ? b->tx : frStructZero(frTransform);
+    return (b != NULL) ? frBodyField(b, tx) : frStructZero(frTransform);
 }
 
 /* Returns the position of `b`. */
 frVector2 frGetBodyPosition(const frBody *b) {
-    return (b != NULL) ? b->tx.position : frStructZero(frVector2);
+    return (b != NULL) ? frBodyField(b, tx).position : frStructZero(frVector2);
 }
 
 /* Returns the angle of `b`, in radians. */
 float frGetBodyAngle(const frBody *b) {
-    return (b != NULL) ? b->tx.angle : 0.0f;
+    return (b != NULL) ? frBodyField(b, tx).angle : 0.0f;
 }
 
 /* Returns the mass of `b`. */
 float frGetBodyMass(const frBody *b) {
-    return (b != NULL) ? b->mtn.mass : 0.0f;
+    return (b != NULL) ? frBodyField(b, mtn.mass) : 0.0f;
 }
 
 /* Returns the inverse mass of `b`. */
 float frGetBodyInverseMass(const frBody *b) {
-    return (b != NULL) ? b->mtn.inverseMass : 0.0f;
+    return (b != NULL) ? frBodyField(b, mtn.inverseMass) : 0.0f;
 }
 
 /* Returns the moment of inertia of `b`. */
 float frGetBodyInertia(const frBody *b) {
-    return (b != NULL) ? b->mtn.inertia : 0.0f;
+    return (b != NULL) ? frBodyField(b, mtn.inertia) : 0.0f;
 }
 
 /* Returns the inverse moment of inertia of `b`. */
 float frGetBodyInverseInertia(const frBody *b) {
-    return (b != NULL) ? b->mtn.inverseInertia : 0.0f;
+    return (b != NULL) ? frBodyField(b, mtn.inverseInertia) : 0.0f;
 }
 
 /* Returns the gravity scale of `b`. */
 float frGetBodyGravityScale(const frBody *b) {
-    return (b != NULL) ? b->mtn.gravityScale : 0.0f;
+    return (b != NULL) ? frBodyField(b, mtn.gravityScale) : 0.0f;
 }
 
 /* Returns the velocity of `b`. */
 frVector2 frGetBodyVelocity(const frBody *b) {
-    return (b != NULL) ? b->mtn.velocity : frStructZero(frVector2);
+    return (b != NULL) ? frBodyField(b, mtn.velocity) : frStructZero(frVector2);
 }
 
 /* Returns the angular velocity of `b`. */
 float frGetBodyAngularVelocity(const frBody *b) {
-    return (b != NULL) ? b->mtn.angularVelocity : 0.0f;
+    return (b != NULL) ? frBodyField(b, mtn.angularVelocity) : 0.0f;
 }
 
 /* Returns the net force of `b`. */
 frVector2 frGetBodyForce(const frBody *b) {
-    return (b != NULL) ? b->mtn.force : frStructZero(frVector2);
+    return (b != NULL) ? frBodyField(b, mtn.force) : frStructZero(frVector2);
 }
 
 /* Returns the net torque of `b`. */
 float frGetBodyTorque(const frBody *b) {
-    return (b != NULL) ? b->mtn.torque : 0.0f;
+    return (b != NULL) ? frBodyField(b, mtn.torque) : 0.0f;
 }
 
 /* Returns the AABB (Axis-Aligned Bounding Box) of `b`. */
 frAABB frGetBodyAABB(const frBody *b) {
-    return (b != NULL && b->shape != NULL) ? b->aabb : frStructZero(frAABB);
+    return (b != NULL && frBodyField(b, shape) != NULL)
+               ? frBodyField(b, aabb)
+               : frStructZero(frAABB);
 }
 
 /* Returns the user data of `b`. */
@@ -180,13 +407,28 @@ void *frGetBodyUserData(const frBody *b) {
     return (b != NULL) ? b->ctx : NULL;
 }
 
+/* 
+    Returns the amount of time `b` has been resting for, 
+    in seconds. 
+*/
+float frGetBodySleepTime(const frBody *b) {
+    return (b != NULL) ? b->sleepTime : 0.0f;
+}
+
+/* Checks if `b` is sleeping. */
+bool frIsBodySleeping(const frBody *b) {
+    return (b != NULL) ? frBodyField(b, sleeping) : false;
+}
+
 /* Sets the `type` of `b`. */
 void frSetBodyType(frBody *b, frBodyType type) {
     if (b == NULL) return;
 
-    b->type = type;
+    frBodyField(b, type) = type;
 
     frComputeBodyMass(b);
+
+    frSetBodySleeping(b, false);
 }
 
 /* Sets the property `flags` of `b`. */
@@ -196,6 +438,8 @@ void frSetBodyFlags(frBody *b, frBodyFlags flags) {
     b->flags = flags;
 
     frComputeBodyMass(b);
+
+    frSetBodySleeping(b, false);
 }
 
 /* 
@@ -205,51 +449,60 @@ void frSetBodyFlags(frBody *b, frBodyFlags flags) {
 void frSetBodyShape(frBody *b, frShape *s) {
     if (b == NULL) return;
 
-    b->shape = s;
+    frBodyField(b, shape) = s;
 
-    b->aabb = (s != NULL) ? frGetShapeAABB(s, b->tx) : frStructZero(frAABB);
+    frBodyField(b, aabb) = (s != NULL) ? frGetShapeAABB(s, frBodyField(b, tx))
+                                       : frStructZero(frAABB);
 
     frComputeBodyMass(b);
+
+    frSetBodySleeping(b, false);
 }
 
 /* Sets the position of `b` to `position`. */
 void frSetBodyPosition(frBody *b, frVector2 position) {
     if (b == NULL) return;
 
-    b->tx.position = position;
+    frTransform *tx = &frBodyField(b, tx);
 
-    b->aabb.x += position.x, b->aabb.y += position.y;
+    tx->position = position;
+
+    if (frBodyField(b, shape) != NULL)
+        frBodyField(b, aabb) = frGetShapeAABB(frBodyField(b, shape), *tx);
+
+    frSetBodySleeping(b, false);
 }
 
 /* Sets the `angle` of `b`, in radians. */
 void frSetBodyAngle(frBody *b, float angle) {
-    if (b == NULL || b->tx.angle == angle) return;
-
-    b->tx.angle = frNormalizeAngle(angle);
+    if (b == NULL) return;
 
-    /*
-        NOTE: These values must be cached in order to 
-        avoid expensive computations as much as possible.
-    */
-    b->tx.rotation.sin_ = sinf(b->tx.angle);
-    b->tx.rotation.cos_ = cosf(b->tx.angle);
+    frSetBodyRotation(b, angle);
 
-    b->aabb = frGetShapeAABB(b->shape, b->tx);
+    frSetBodySleeping(b, false);
 }
 
 /* Sets the gravity `scale` of `b`. */
 void frSetBodyGravityScale(frBody *b, float scale) {
-    if (b != NULL) b->mtn.gravityScale = scale;
+    if (b != NULL) frBodyField(b, mtn.gravityScale) = scale;
 }
 
 /* Sets the `velocity` of `b`. */
 void frSetBodyVelocity(frBody *b, frVector2 velocity) {
-    if (b != NULL) b->mtn.velocity = velocity;
+    if (b == NULL) return;
+
+    frBodyField(b, mtn.velocity) = velocity;
+
+    frSetBodySleeping(b, false);
 }
 
 /* Sets the `angularVelocity` of `b`. */
 void frSetBodyAngularVelocity(frBody *b, float angularVelocity) {
-    if (b != NULL) b->mtn.angularVelocity = angularVelocity;
+    if (b == NULL) return;
+
+    frBodyField(b, mtn.angularVelocity) = angularVelocity;
+
+    frSetBodySleeping(b, false);
 }
 
 /* Sets the user data of `b` to `ctx`. */
@@ -257,13 +510,47 @@ void frSetBodyUserData(frBody *b, void *userData) {
     if (b != NULL) b->ctx = userData;
 }
 
+/* 
+    Sets the `flag` that will be set to `true` 
+    whenever `b` falls asleep or wakes up.
+*/
+void frSetBodySleepFlag(frBody *b, bool *flag) {
+    if (b != NULL) b->sleepFlag = flag;
+}
+
+/* 
+    Puts `b` to sleep if `sleeping` is `true`, or wakes `b` up otherwise.
+    
+    NOTE: Only dynamic bodies can be put to sleep.
+*/
+void frSetBodySleeping(frBody *b, bool sleeping) {
+    if (b == NULL) return;
+
+    if (sleeping) {
+        if (frBodyField(b, type) != FR_BODY_DYNAMIC) return;
+
+        frBodyField(b, mtn.velocity) = frStructZero(frVector2);
+        frBodyField(b, mtn.angularVelocity) = 0.0f;
+
+        frBodyField(b, mtn.force) = frStructZero(frVector2);
+        frBodyField(b, mtn.torque) = 0.0f;
+    } else {
+        b->sleepTime = 0.0f;
+    }
+
+    if (frBodyField(b, sleeping) != sleeping && b->sleepFlag != NULL)
+        *b->sleepFlag = true;
+
+    frBodyField(b, sleeping) = sleeping;
+}
+
 /* Checks if the given `point` lies inside `b`. */
 bool frBodyContainsPoint(const frBody *b, frVector2 point) {
     if (b == NULL) return false;
 
-    const frShape *s = b->shape;
+    const frShape *s = frBodyField(b, shape);
 
-    frTransform tx = b->tx;
+    frTransform tx = frBodyField(b, tx);
     frShapeType type = frGetShapeType(s);
 
     if (type == FR_SHAPE_CIRCLE) {
@@ -292,41 +579,50 @@ bool frBodyContainsPoint(const frBody *b, frVector2 point) {
 void frClearBodyForces(frBody *b) {
     if (b == NULL) return;
 
-    b->mtn.force.x = b->mtn.force.y = b->mtn.torque = 0.0f;
+    frBodyField(b, mtn.force) = frStructZero(frVector2);
+    frBodyField(b, mtn.torque) = 0.0f;
 }
 
 /* Applies a `force` at a `point` on `b`. */
 void frApplyForceToBody(frBody *b, frVector2 point, frVector2 force) {
-    if (b == NULL || b->mtn.inverseMass <= 0.0f) return;
+    if (b == NULL || frBodyField(b, mtn.inverseMass) <= 0.0f) return;
 
-    frVector2 localPoint = frVector2Subtract(point, b->tx.position);
+    frVector2 localPoint = frVector2Subtract(point,
+                                             frBodyField(b, tx).position);
 
-    b->mtn.force = frVector2Add(b->mtn.force, force);
-    b->mtn.torque += frVector2Cross(localPoint, force);
+    frBodyField(b, mtn.force) = frVector2Add(frBodyField(b, mtn.force), force);
+    frBodyField(b, mtn.torque) += frVector2Cross(localPoint, force);
+
+    frSetBodySleeping(b, false);
 }
 
 /* Applies a gravity force to `b` with the `g`ravity acceleration vector. */
 void frApplyGravityToBody(frBody *b, frVector2 g) {
-    if (b == NULL || b->mtn.mass <= 0.0f) return;
+    if (b == NULL || frBodyField(b, mtn.mass) <= 0.0f) return;
+
+    float gravityScale = frBodyField(b, mtn.gravityScale);
 
-    b->mtn.force = frVector2Add(b->mtn.force,
-                                frVector2ScalarMultiply(g,
-                                                        b->mtn.gravityScale
-                                                            * b->mtn.mass));
+    frBodyField(b, mtn.force) = frVector2Add(
+        frBodyField(b, mtn.force),
+        frVector2ScalarMultiply(g, gravityScale * frBodyField(b, mtn.mass)));
 }
 
 /* Applies an `impulse` at a `point` on `b`. */
 void frApplyImpulseToBody(frBody *b, frVector2 point, frVector2 impulse) {
-    if (b == NULL || b->mtn.inverseMass <= 0.0f) return;
+    if (b == NULL || frBodyField(b, mtn.inverseMass) <= 0.0f) return;
 
-    frVector2 localPoint = frVector2Subtract(point, b->tx.position);
+    frVector2 localPoint = frVector2Subtract(point,
+                                             frBodyField(b, tx).position);
 
-    b->mtn.velocity = frVector2Add(b->mtn.velocity,
-                                   frVector2ScalarMultiply(impulse,
-                                                           b->mtn.inverseMass));
+    frBodyField(b, mtn.velocity) = frVector2Add(
+        frBodyField(b, mtn.velocity),
+        frVector2ScalarMultiply(impulse, frBodyField(b, mtn.inverseMass)));
 
-    b->mtn.angularVelocity += b->mtn.inverseInertia
-                              * frVector2Cross(localPoint, impulse);
+    frBodyField(b, mtn.angularVelocity) += frBodyField(b, mtn.inverseInertia)
+                                           * frVector2Cross(localPoint,
+                                                            impulse);
+
+    frSetBodySleeping(b, false);
 }
 
 /* Applies accumulated impulses to `b1` and `b2`. */
@@ -335,37 +631,46 @@ void frApplyAccumulatedImpulses(frBody *b1,
                                 frCollision *collision) {
     if (b1 == NULL || b2 == NULL || collision == NULL) return;
 
-    if (b1->mtn.inverseMass + b2->mtn.inverseMass <= 0.0f) {
-        if (b1->type == FR_BODY_STATIC)
-            b1->mtn.velocity.x = b1->mtn.velocity
-                                     .y = b1->mtn.angularVelocity = 0.0f;
+    float inverseMass1 = frBodyField(b1, mtn.inverseMass);
+    float inverseMass2 = frBodyField(b2, mtn.inverseMass);
+
+    if (inverseMass1 + inverseMass2 <= 0.0f) {
+        if (frBodyField(b1, type) == FR_BODY_STATIC) {
+            frBodyField(b1, mtn.velocity) = frStructZero(frVector2);
+            frBodyField(b1, mtn.angularVelocity) = 0.0f;
+        }
 
-        if (b2->type == FR_BODY_STATIC)
-            b2->mtn.velocity.x = b2->mtn.velocity
-                                     .y = b2->mtn.angularVelocity = 0.0f;
+        if (frBodyField(b2, type) == FR_BODY_STATIC) {
+            frBodyField(b2, mtn.velocity) = frStructZero(frVector2);
+            frBodyField(b2, mtn.angularVelocity) = 0.0f;
+        }
 
         return;
     }
 
+    float inverseInertia1 = frBodyField(b1, mtn.inverseInertia);
+    float inverseInertia2 = frBodyField(b2, mtn.inverseInertia);
+
+    frVector2 position1 = frBodyField(b1, tx).position;
+    frVector2 position2 = frBodyField(b2, tx).position;
+
     frVector2 ctxTangent = frVector2RightNormal(collision->direction);
 
     for (int i = 0; i < collision->count; i++) {
         frVector2 contactPoint = collision->contacts[i].point;
 
-        frVector2 relPosition1 = frVector2Subtract(contactPoint,
-                                                   b1->tx.position);
-        frVector2 relPosition2 = frVector2Subtract(contactPoint,
-                                                   b2->tx.position);
+        frVector2 relPosition1 = frVector2Subtract(contactPoint, position1);
+        frVector2 relPosition2 = frVector2Subtract(contactPoint, position2);
 
         float relPositionCross1 = frVector2Cross(relPosition1,
                                                  collision->direction);
         float relPositionCross2 = frVector2Cross(relPosition2,
                                                  collision->direction);
 
-        float normalMass = (b1->mtn.inverseMass + b2->mtn.inverseMass)
-                           + b1->mtn.inverseInertia
+        float normalMass = (inverseMass1 + inverseMass2)
+                           + inverseInertia1
                                  * (relPositionCross1 * relPositionCross1)
-                           + b2->mtn.inverseInertia
+                           + inverseInertia2
                                  * (relPositionCross2 * relPositionCross2);
 
         collision->contacts[i].cache.normalMass = 1.0f / normalMass;
@@ -376,10 +681,10 @@ void frApplyAccumulatedImpulses(frBody *b1,
         relPositionCross1 = frVector2Cross(relPosition1, ctxTangent);
         relPositionCross2 = frVector2Cross(relPosition2, ctxTangent);
 
-        float tangentMass = (b1->mtn.inverseMass + b2->mtn.inverseMass)
-                            + b1->mtn.inverseInertia
+        float tangentMass = (inverseMass1 + inverseMass2)
+                            + inverseInertia1
                                   * (relPositionCross1 * relPositionCross1)
-                            + b2->mtn.inverseInertia
+                            + inverseInertia2
                                   * (relPositionCross2 * relPositionCross2);
 
         collision->contacts[i].cache.tangentMass = 1.0f / tangentMass;
@@ -387,26 +692,12 @@ void frApplyAccumulatedImpulses(frBody *b1,
         frVector2 accTangentImpulse = frVector2ScalarMultiply(
             ctxTangent, collision->contacts[i].cache.tangentScalar);
 
-        {
-            frVector2 accImpulse = frVector2Add(accNormalImpulse,
-                                                accTangentImpulse);
-
-            b1->mtn.velocity = frVector2Subtract(
-                b1->mtn.velocity,
-                frVector2ScalarMultiply(accImpulse, b1->mtn.inverseMass));
-
-            b1->mtn.angularVelocity -= b1->mtn.inverseInertia
-                                       * frVector2Cross(relPosition1,
-                                                        accImpulse);
-
-            b2->mtn.velocity = frVector2Add(
-                b2->mtn.velocity,
-                frVector2ScalarMultiply(accImpulse, b2->mtn.inverseMass));
-
-            b2->mtn.angularVelocity += b2->mtn.inverseInertia
-                                       * frVector2Cross(relPosition2,
-                                                        accImpulse);
-        }
+        frApplyContactImpulse(b1,
+                              b2,
+                              relPosition1,
+                              relPosition2,
+                              frVector2Add(accNormalImpulse,
+                                           accTangentImpulse));
     }
 }
 
@@ -416,14 +707,18 @@ void frApplyAccumulatedImpulses(frBody *b1,
     velocity of `b`.
 */
 void frIntegrateForBodyVelocity(frBody *b, float dt) {
-    if (b == NULL || b->mtn.inverseMass <= 0.0f || dt <= 0.0f) return;
+    if (b == NULL || frBodyField(b, mtn.inverseMass) <= 0.0f || dt <= 0.0f)
+        return;
 
-    b->mtn.velocity = frVector2Add(b->mtn.velocity,
-                                   frVector2ScalarMultiply(b->mtn.force,
-                                                           b->mtn.inverseMass
-                                                               * dt));
+    frBodyField(b, mtn.velocity) = frVector2Add(
+        frBodyField(b, mtn.velocity),
+        frVector2ScalarMultiply(frBodyField(b, mtn.force),
+                                frBodyField(b, mtn.inverseMass) * dt));
 
-    b->mtn.angularVelocity += (b->mtn.torque * b->mtn.inverseInertia) * dt;
+    frBodyField(b, mtn.angularVelocity) += (frBodyField(b, mtn.torque)
+                                            * frBodyField(b,
+                                                          mtn.inverseInertia))
+                                           * dt;
 }
 
 /* 
@@ -431,57 +726,112 @@ void frIntegrateForBodyVelocity(frBody *b, float dt) {
     to calculate the position of `b`. 
 */
 void frIntegrateForBodyPosition(frBody *b, float dt) {
-    if (b == NULL || b->type == FR_BODY_STATIC || dt <= 0.0f) return;
+    if (b == NULL || frBodyField(b, type) == FR_BODY_STATIC || dt <= 0.0f)
+        return;
+
+    frTransform *tx = &frBodyField(b, tx);
+
+    frVector2 velocity = frBodyField(b, mtn.velocity);
+
+    float angularVelocity = frBodyField(b, mtn.angularVelocity);
+
+    tx->position.x += velocity.x * dt;
+    tx->position.y += velocity.y * dt;
+
+    if (angularVelocity != 0.0f)
+        frSetTransformAngle(tx, tx->angle + (angularVelocity * dt));
+
+    frBodyField(b, aabb) = frGetShapeAABB(frBodyField(b, shape), *tx);
+}
+
+/* 
+    Resets the sleep timer of `b` if `b` is moving, 
+    or advances the sleep timer of `b` over `dt` otherwise.
+*/
+void frUpdateBodySleepTime(frBody *b, float dt) {
+    if (b == NULL || frBodyField(b, type) != FR_BODY_DYNAMIC
+        || frBodyField(b, sleeping))
+        return;
+
+    const float linearThreshold = FR_WORLD_SLEEP_LINEAR_THRESHOLD;
+    const float angularThreshold = FR_WORLD_SLEEP_ANGULAR_THRESHOLD;
 
-    b->tx.position.x += b->mtn.velocity.x * dt;
-    b->tx.position.y += b->mtn.velocity.y * dt;
+    frVector2 velocity = frBodyField(b, mtn.velocity);
 
-    if (b->mtn.angularVelocity != 0.0f)
-        frSetBodyAngle(b, b->tx.angle + (b->mtn.angularVelocity * dt));
+    float angularVelocity = frBodyField(b, mtn.angularVelocity);
 
-    b->aabb = frGetShapeAABB(b->shape, b->tx);
+    if (frVector2Dot(velocity, velocity) > linearThreshold * linearThreshold
+        || angularVelocity * angularVelocity
+               > angularThreshold * angularThreshold)
+        b->sleepTime = 0.0f;
+    else
+        b->sleepTime += dt;
 }
 
-/* Resolves the collision between `b1` and `b2`. */
-void frResolveCollision(frBody *b1,
-                        frBody *b2,
-                        frCollision *collision,
-                        float inverseDt) {
+/* 
+    Resolves the collision between `b1` and `b2` with the given
+    Baumgarte stabilization parameters, then returns the largest change 
+    in the accumulated impulses of `collision`.
+*/
+float frResolveCollision(frBody *b1,
+                         frBody *b2,
+                         frCollision *collision,
+                         float inverseDt,
+                         float baumgarteFactor,
+                         float baumgarteSlop) {
     if (b1 == NULL || b2 == NULL
-        || b1->mtn.inverseMass + b2->mtn.inverseMass <= 0.0f
+        || frBodyField(b1, mtn.inverseMass) + frBodyField(b2, mtn.inverseMass)
+               <= 0.0f
         || collision == NULL || inverseDt <= 0.0f)
-        return;
+        return 0.0f;
+
+    float maxImpulseScalar = 0.0f;
+
+    /*
+        NOTE: These pointers stay valid until the end of this function,
+        since no body can be added to or removed from a body storage here.
+    */
+    const frVector2 *velocity1 = &frBodyField(b1, mtn.velocity);
+    const frVector2 *velocity2 = &frBodyField(b2, mtn.velocity);
+
+    const float *angularVelocity1 = &frBodyField(b1, mtn.angularVelocity);
+    const float *angularVelocity2 = &frBodyField(b2, mtn.angularVelocity);
+
+    frVector2 position1 = frBodyField(b1, tx).position;
+    frVector2 position2 = frBodyField(b2, tx).position;
 
     frVector2 ctxTangent = frVector2RightNormal(collision->direction);
 
     for (int i = 0; i < collision->count; i++) {
         frVector2 contactPoint = collision->contacts[i].point;
 
-        frVector2 relPosition1 = frVector2Subtract(contactPoint,
-                                                   b1->tx.position);
-        frVector2 relPosition2 = frVector2Subtract(contactPoint,
-                                                   b2->tx.position);
+        frVector2 relPosition1 = frVector2Subtract(contactPoint, position1);
+        frVector2 relPosition2 = frVector2Subtract(contactPoint, position2);
 
         frVector2 relNormal1 = frVector2LeftNormal(relPosition1);
         frVector2 relNormal2 = frVector2LeftNormal(relPosition2);
 
         frVector2 relVelocity = frVector2Subtract(
-            frVector2Add(b2->mtn.velocity,
+            frVector2Add(*velocity2,
                          frVector2ScalarMultiply(relNormal2,
-                                                 b2->mtn.angularVelocity)),
-            frVector2Add(b1->mtn.velocity,
+                                                 *angularVelocity2)),
+            frVector2Add(*velocity1,
                          frVector2ScalarMultiply(relNormal1,
-                                                 b1->mtn.angularVelocity)));
+                                                 *angularVelocity1)));
 
         float relVelocityDot = frVector2Dot(relVelocity, collision->direction);
 
-        float biasScalar = -(FR_WORLD_BAUMGARTE_FACTOR * inverseDt)
-                           * fminf(0.0f,
-                                   -collision->contacts[i].depth
-                                       + FR_WORLD_BAUMGARTE_SLOP);
+        float biasScalar = frGetContactBiasScalar(collision->contacts[i].depth,
+                                                  inverseDt,
+                                                  baumgarteFactor,
+                                                  baumgarteSlop);
+
+        // NOTE: Two bodies must not bounce off before they touch each other
+        float restitution = (collision->contacts[i].depth >= 0.0f)
+                                ? collision->restitution
+                                : 0.0f;
 
-        float normalScalar = ((-(1.0f + collision->restitution)
-                               * relVelocityDot)
+        float normalScalar = ((-(1.0f + restitution) * relVelocityDot)
                               + biasScalar)
                              * collision->contacts[i].cache.normalMass;
 
@@ -493,18 +843,25 @@ void frResolveCollision(frBody *b1,
 
             normalScalar = collision->contacts[i].cache.normalScalar
                            - oldNormalScalar;
+
+            maxImpulseScalar = fmaxf(maxImpulseScalar, fabsf(normalScalar));
         }
 
-        frVector2 normalImpulse = frVector2ScalarMultiply(collision->direction,
-                                                          normalScalar);
+        frApplyContactImpulse(
+            b1,
+            b2,
+            relPosition1,
+            relPosition2,
+            frVector2ScalarMultiply(collision->direction, normalScalar));
 
+        // NOTE: The friction must see the velocities after the normal impulse
         relVelocity = frVector2Subtract(
-            frVector2Add(b2->mtn.velocity,
+            frVector2Add(*velocity2,
                          frVector2ScalarMultiply(relNormal2,
-                                                 b2->mtn.angularVelocity)),
-            frVector2Add(b1->mtn.velocity,
+                                                 *angularVelocity2)),
+            frVector2Add(*velocity1,
                          frVector2ScalarMultiply(relNormal1,
-                                                 b1->mtn.angularVelocity)));
+                                                 *angularVelocity1)));
 
         float tangentScalar = -frVector2Dot(relVelocity, ctxTangent)
                               * collision->contacts[i].cache.tangentMass;
@@ -522,70 +879,1320 @@ void frResolveCollision(frBody *b1,
 
             tangentScalar = collision->contacts[i].cache.tangentScalar
                             - oldTangentScalar;
+
+            maxImpulseScalar = fmaxf(maxImpulseScalar, fabsf(tangentScalar));
         }
 
-        frVector2 tangentImpulse = frVector2ScalarMultiply(ctxTangent,
-                                                           tangentScalar);
+        frApplyContactImpulse(b1,
+                              b2,
+                              relPosition1,
+                              relPosition2,
+                              frVector2ScalarMultiply(ctxTangent,
+                                                      tangentScalar));
+    }
+
+    return maxImpulseScalar;
+}
+
+/* 
+    Resolves the collision between `b1` and `b2` as a soft constraint 
+    over a sub-step of `1 / inverseDt` seconds, which lets `b1` and `b2` 
+    overlap by `baumgarteSlop`, or only removes the approaching velocities 
+    of `b1` and `b2` (without pushing them apart) if `useBias` is `false`.
+*/
+void frResolveCollisionSoft(frBody *b1,
+                            frBody *b2,
+                            frCollision *collision,
+                            float inverseDt,
+                            float baumgarteSlop,
+                            bool useBias) {
+    if (b1 == NULL || b2 == NULL
+        || frBodyField(b1, mtn.inverseMass) + frBodyField(b2, mtn.inverseMass)
+               <= 0.0f
+        || collision == NULL || inverseDt <= 0.0f)
+        return;
+
+    /*
+        NOTE: A stiffer contact than a quarter of the sub-step rate
+        would make the sub-steps overshoot, and a heavily damped contact
+        pushes two overlapping bodies apart without any bouncing.
+    */
+    float contactHertz = fminf(CONTACT_HERTZ, 0.25f * inverseDt);
+
+    float omega = TWO_PI * contactHertz, omegaDt = omega / inverseDt;
+
+    float a1 = 2.0f * CONTACT_DAMPING_RATIO + omegaDt;
+    float a2 = omegaDt * a1, a3 = 1.0f / (1.0f + a2);
+
+    float biasRate = omega / a1;
+
+    frVector2 position1 = frBodyField(b1, tx).position;
+    frVector2 position2 = frBodyField(b2, tx).position;
+
+    frVector2 ctxTangent = frVector2RightNormal(collision->direction);
+
+    for (int i = 0; i < collision->count; i++) {
+        frContact *contact = &collision->contacts[i];
+
+        frVector2 relPosition1 = frVector2Subtract(contact->point, position1);
+        frVector2 relPosition2 = frVector2Subtract(contact->point, position2);
+
+        frVector2 relVelocity = frGetContactVelocity(b1,
+                                                     b2,
+                                                     relPosition1,
+                                                     relPosition2);
+
+        float relVelocityDot = frVector2Dot(relVelocity, collision->direction);
+
+        // NOTE: Two bodies can overlap by the slop without being pushed apart
+        float separation = baumgarteSlop - contact->depth;
+
+        float biasScalar = 0.0f, massScale = 1.0f, impulseScale = 0.0f;
+
+        if (separation > 0.0f) {
+            biasScalar = separation * inverseDt;
+        } else if (useBias) {
+            biasScalar = fmaxf(biasRate * separation,
+                               -CONTACT_MAX_PUSH_VELOCITY);
+
+            massScale = a2 * a3, impulseScale = a3;
+        }
+
+        float normalScalar = -(massScale * contact->cache.normalMass)
+                                 * (relVelocityDot + biasScalar)
+                             - impulseScale * contact->cache.normalScalar;
 
         {
-            frVector2 totalImpulse = frVector2Add(normalImpulse,
-                                                  tangentImpulse);
+            float oldNormalScalar = contact->cache.normalScalar;
 
-            b1->mtn.velocity = frVector2Subtract(
-                b1->mtn.velocity,
-                frVector2ScalarMultiply(totalImpulse, b1->mtn.inverseMass));
+            contact->cache.normalScalar = fmaxf(0.0f,
+                                                oldNormalScalar + normalScalar);
 
-            b1->mtn.angularVelocity -= b1->mtn.inverseInertia
-                                       * frVector2Cross(relPosition1,
-                                                        totalImpulse);
+            normalScalar = contact->cache.normalScalar - oldNormalScalar;
+        }
+
+        frVector2 normalImpulse = frVector2ScalarMultiply(collision->direction,
+                                                          normalScalar);
+
+        frApplyContactImpulse(b1,
+                              b2,
+                              relPosition1,
+                              relPosition2,
+                              normalImpulse);
+
+        relVelocity = frGetContactVelocity(b1,
+                                           b2,
+                                           relPosition1,
+                                           relPosition2);
+
+        float tangentScalar = -frVector2Dot(relVelocity, ctxTangent)
+                              * contact->cache.tangentMass;
 
-            b2->mtn.velocity = frVector2Add(
-                b2->mtn.velocity,
-                frVector2ScalarMultiply(totalImpulse, b2->mtn.inverseMass));
+        {
+            float maxTangentScalar = fabsf(collision->friction
+                                           * contact->cache.normalScalar);
+
+            float oldTangentScalar = contact->cache.tangentScalar;
+
+            contact->cache.tangentScalar = fminf(
+                fmaxf(oldTangentScalar + tangentScalar, -maxTangentScalar),
+                maxTangentScalar);
 
-            b2->mtn.angularVelocity += b2->mtn.inverseInertia
-                                       * frVector2Cross(relPosition2,
-                                                        totalImpulse);
+            tangentScalar = contact->cache.tangentScalar - oldTangentScalar;
         }
+
+        frVector2 tangentImpulse = frVector2ScalarMultiply(ctxTangent,
+                                                           tangentScalar);
+
+        frApplyContactImpulse(b1,
+                              b2,
+                              relPosition1,
+                              relPosition2,
+                              tangentImpulse);
     }
 }
 
-/* Private Functions ======================================================> */
+/* 
+    Moves the contact points of `collision` along with `b1` and `b2` 
+    over `dt`, then updates the depth of each contact point 
+    from the relative velocity of `b1` and `b2`.
+*/
+void frUpdateCollisionDepths(const frBody *b1,
+                             const frBody *b2,
+                             frCollision *collision,
+                             float dt) {
+    if (b1 == NULL || b2 == NULL || collision == NULL || dt <= 0.0f) return;
 
-/* Computes the mass and the moment of inertia for `b`. */
-static void frComputeBodyMass(frBody *b) {
-    b->mtn.mass = b->mtn.inverseMass = 0.0f;
-    b->mtn.inertia = b->mtn.inverseInertia = 0.0f;
+    frVector2 position1 = frBodyField(b1, tx).position;
+    frVector2 position2 = frBodyField(b2, tx).position;
 
-    switch (b->type) {
-        case FR_BODY_STATIC:
-            b->mtn.velocity.x = b->mtn.velocity.y = b->mtn
-                                                        .angularVelocity = 0.0f;
+    for (int i = 0; i < collision->count; i++) {
+        frContact *contact = &collision->contacts[i];
+
+        frVector2 relPosition1 = frVector2Subtract(contact->point, position1);
+        frVector2 relPosition2 = frVector2Subtract(contact->point, position2);
+
+        frVector2 pointVelocity1 = frVector2Add(
+            frBodyField(b1, mtn.velocity),
+            frVector2ScalarMultiply(frVector2LeftNormal(relPosition1),
+                                    frBodyField(b1, mtn.angularVelocity)));
+
+        frVector2 pointVelocity2 = frVector2Add(
+            frBodyField(b2, mtn.velocity),
+            frVector2ScalarMultiply(frVector2LeftNormal(relPosition2),
+                                    frBodyField(b2, mtn.angularVelocity)));
+
+        contact->depth -= frVector2Dot(frVector2Subtract(pointVelocity2,
+                                                         pointVelocity1),
+                                       collision->direction)
+                          * dt;
+
+        contact->point = frVector2Add(
+            contact->point,
+            frVector2ScalarMultiply(frVector2Add(pointVelocity1,
+                                                 pointVelocity2),
+                                    0.5f * dt));
+    }
+}
 
-            break;
+/* 
+    Stores the relative velocity of `b1` and `b2` along the normal 
+    at each contact point of `collision`, before the collision is resolved.
+*/
+void frStoreCollisionVelocities(const frBody *b1,
+                                const frBody *b2,
+                                frCollision *collision) {
+    if (b1 == NULL || b2 == NULL || collision == NULL) return;
 
-        case FR_BODY_DYNAMIC:
-            if (!(b->flags & FR_FLAG_INFINITE_MASS)) {
-                b->mtn.mass = frGetShapeMass(b->shape);
+    frVector2 position1 = frBodyField(b1, tx).position;
+    frVector2 position2 = frBodyField(b2, tx).position;
 
-                if (b->mtn.mass > 0.0f) b->mtn.inverseMass = 1.0f / b->mtn.mass;
-            }
+    for (int i = 0; i < collision->count; i++) {
+        frContact *contact = &collision->contacts[i];
 
-            if (!(b->flags & FR_FLAG_INFINITE_INERTIA)) {
-                b->mtn.inertia = frGetShapeInertia(b->shape);
+        frVector2 relVelocity = frGetContactVelocity(
+            b1,
+            b2,
+            frVector2Subtract(contact->point, position1),
+            frVector2Subtract(contact->point, position2));
 
-                if (b->mtn.inertia > 0.0f)
-                    b->mtn.inverseInertia = 1.0f / b->mtn.inertia;
-            }
+        contact->cache.normalVelocity = frVector2Dot(relVelocity,
+                                                     collision->direction);
+    }
+}
 
-            break;
+/* 
+    Makes `b1` and `b2` bounce off each other, from the relative velocities
+    stored by `frStoreCollisionVelocities()`.
+*/
+void frApplyCollisionRestitution(frBody *b1,
+                                 frBody *b2,
+                                 frCollision *collision) {
+    if (b1 == NULL || b2 == NULL
+        || frBodyField(b1, mtn.inverseMass) + frBodyField(b2, mtn.inverseMass)
+               <= 0.0f
+        || collision == NULL || collision->restitution <= 0.0f)
+        return;
 
-        default:
-            break;
+    frVector2 position1 = frBodyField(b1, tx).position;
+    frVector2 position2 = frBodyField(b2, tx).position;
+
+    for (int i = 0; i < collision->count; i++) {
+        frContact *contact = &collision->contacts[i];
+
+        // NOTE: Resting contacts (and the ones that did not touch) never bounce
+        if (contact->cache.normalVelocity > -RESTITUTION_THRESHOLD
+            || contact->cache.normalScalar <= 0.0f)
+            continue;
+
+        frVector2 relPosition1 = frVector2Subtract(contact->point, position1);
+        frVector2 relPosition2 = frVector2Subtract(contact->point, position2);
+
+        frVector2 relVelocity = frGetContactVelocity(b1,
+                                                     b2,
+                                                     relPosition1,
+                                                     relPosition2);
+
+        float normalScalar = -(frVector2Dot(relVelocity, collision->direction)
+                               + collision->restitution
+                                     * contact->cache.normalVelocity)
+                             * contact->cache.normalMass;
+
+        {
+            float oldNormalScalar = contact->cache.normalScalar;
+
+            contact->cache.normalScalar = fmaxf(0.0f,
+                                                oldNormalScalar + normalScalar);
+
+            normalScalar = contact->cache.normalScalar - oldNormalScalar;
+        }
+
+        frApplyContactImpulse(b1,
+                              b2,
+                              relPosition1,
+                              relPosition2,
+                              frVector2ScalarMultiply(collision->direction,
+                                                      normalScalar));
     }
 }
 
-/* Normalizes the `angle` to a range `[-2π, 2π]`. */
-static FR_API_INLINE float frNormalizeAngle(float angle) {
-    return angle - (TWO_PI * floorf((angle + -M_PI) * INVERSE_TWO_PI));
+/* Creates a new body storage. */
+frBodyStorage *frCreateBodyStorage(void) {
+    frBodyStorage *result = calloc(1, sizeof *result);
+
+    return result;
+}
+
+/* 
+    Releases the memory allocated for `bs`.
+
+    NOTE: The bodies in `bs` must be released before calling this function.
+*/
+void frReleaseBodyStorage(frBodyStorage *bs) {
+    if (bs == NULL) return;
+
+    frReleaseDynArray(bs->bodies);
+
+    frReleaseDynArray(bs->mtn.mass);
+    frReleaseDynArray(bs->mtn.inverseMass);
+    frReleaseDynArray(bs->mtn.inertia);
+    frReleaseDynArray(bs->mtn.inverseInertia);
+    frReleaseDynArray(bs->mtn.velocity);
+    frReleaseDynArray(bs->mtn.angularVelocity);
+    frReleaseDynArray(bs->mtn.gravityScale);
+    frReleaseDynArray(bs->mtn.force);
+    frReleaseDynArray(bs->mtn.torque);
+
+    frReleaseDynArray(bs->tx);
+    frReleaseDynArray(bs->shape);
+    frReleaseDynArray(bs->type);
+    frReleaseDynArray(bs->aabb);
+    frReleaseDynArray(bs->sleeping);
+
+    free(bs);
+}
+
+/* 
+    Moves the data of each body in `bs` back to the body,
+    then erases all bodies from `bs`.
+*/
+void frClearBodyStorage(frBodyStorage *bs) {
+    if (bs == NULL) return;
+
+    for (int i = 0; i < frGetDynArrayLength(bs->bodies); i++)
+        frDetachBodyFromStorage(frGetDynArrayValue(bs->bodies, i));
+
+    frSetBodyStorageLength(bs, 0);
 }
+
+/* 
+    Moves the data of `b` to the end of `bs`. Returns `false` 
+    if `b` has already been added to a body storage.
+*/
+bool frAddToBodyStorage(frBodyStorage *bs, frBody *b) {
+    if (bs == NULL || b == NULL || b->storage != NULL) return false;
+
+    b->index = frGetDynArrayLength(bs->bodies);
+
+    frDynArrayPush(bs->bodies, b);
+
+    frDynArrayPush(bs->mtn.mass, b->mtn.mass);
+    frDynArrayPush(bs->mtn.inverseMass, b->mtn.inverseMass);
+    frDynArrayPush(bs->mtn.inertia, b->mtn.inertia);
+    frDynArrayPush(bs->mtn.inverseInertia, b->mtn.inverseInertia);
+    frDynArrayPush(bs->mtn.velocity, b->mtn.velocity);
+    frDynArrayPush(bs->mtn.angularVelocity, b->mtn.angularVelocity);
+    frDynArrayPush(bs->mtn.gravityScale, b->mtn.gravityScale);
+    frDynArrayPush(bs->mtn.force, b->mtn.force);
+    frDynArrayPush(bs->mtn.torque, b->mtn.torque);
+
+    frDynArrayPush(bs->tx, b->tx);
+    frDynArrayPush(bs->shape, b->shape);
+    frDynArrayPush(bs->type, b->type);
+    frDynArrayPush(bs->aabb, b->aabb);
+    frDynArrayPush(bs->sleeping, b->sleeping);
+
+    b->storage = bs;
+
+    return true;
+}
+
+/* 
+    Moves the data of `b` from `bs` back to `b`, then moves the data 
+    of the last body in `bs` to where the data of `b` was.
+*/
+bool frRemoveFromBodyStorage(frBodyStorage *bs, frBody *b) {
+    if (bs == NULL || b == NULL || b->storage != bs) return false;
+
+    int i = b->index, lastIndex = frGetDynArrayLength(bs->bodies) - 1;
+
+    frDetachBodyFromStorage(b);
+
+    if (i < lastIndex) {
+        frSwapBodyStorageData(bs, i, lastIndex);
+
+        frGetDynArrayValue(bs->bodies, i)->index = i;
+    }
+
+    frSetBodyStorageLength(bs, lastIndex);
+
+    return true;
+}
+
+/* Reserves memory for at least `capacity` bodies in `bs`. */
+void frReserveBodyStorage(frBodyStorage *bs, int capacity) {
+    if (bs == NULL || capacity <= 0) return;
+
+    frReserveDynArray(bs->bodies, capacity);
+
+    frReserveDynArray(bs->mtn.mass, capacity);
+    frReserveDynArray(bs->mtn.inverseMass, capacity);
+    frReserveDynArray(bs->mtn.inertia, capacity);
+    frReserveDynArray(bs->mtn.inverseInertia, capacity);
+    frReserveDynArray(bs->mtn.velocity, capacity);
+    frReserveDynArray(bs->mtn.angularVelocity, capacity);
+    frReserveDynArray(bs->mtn.gravityScale, capacity);
+    frReserveDynArray(bs->mtn.force, capacity);
+    frReserveDynArray(bs->mtn.torque, capacity);
+
+    frReserveDynArray(bs->tx, capacity);
+    frReserveDynArray(bs->shape, capacity);
+    frReserveDynArray(bs->type, capacity);
+    frReserveDynArray(bs->aabb, capacity);
+    frReserveDynArray(bs->sleeping, capacity);
+}
+
+/* Returns the number of bodies in `bs`. */
+int frGetBodyStorageLength(const frBodyStorage *bs) {
+    return (bs != NULL) ? frGetDynArrayLength(bs->bodies) : 0;
+}
+
+/* Returns the body storage that `b` has been added to. */
+frBodyStorage *frGetBodyStorage(const frBody *b) {
+    return (b != NULL) ? b->storage : NULL;
+}
+
+/* 
+    Returns the index of `b` in the body storage of `b`, 
+    or `-1` if `b` has not been added to any body storage.
+*/
+int frGetBodyStorageIndex(const frBody *b) {
+    return (b != NULL && b->storage != NULL) ? b->index : -1;
+}
+
+/* Clears accumulated forces on each body in `bs`. */
+void frClearBodyStorageForces(frBodyStorage *bs) {
+    if (bs == NULL) return;
+
+    int length = frGetDynArrayLength(bs->bodies);
+
+    frVector2 *force = bs->mtn.force.buffer;
+    float *torque = bs->mtn.torque.buffer;
+
+    for (int i = 0; i < length; i++)
+        force[i].x = force[i].y = torque[i] = 0.0f;
+}
+
+/* 
+    Applies a gravity force to each awake body in `bs` with the `g`ravity 
+    acceleration vector, then calculates the acceleration of each awake 
+    body from the accumulated forces and integrates the acceleration
+    over `dt` to calculate the velocity of each awake body.
+*/
+void frIntegrateForBodyStorageVelocities(frBodyStorage *bs,
+                                         frVector2 g,
+                                         float dt) {
+    if (bs == NULL || dt <= 0.0f) return;
+
+    int length = frGetDynArrayLength(bs->bodies);
+
+    const float *mass = bs->mtn.mass.buffer;
+    const float *inverseMass = bs->mtn.inverseMass.buffer;
+    const float *inverseInertia = bs->mtn.inverseInertia.buffer;
+    const float *gravityScale = bs->mtn.gravityScale.buffer;
+    const float *torque = bs->mtn.torque.buffer;
+
+    const bool *sleeping = bs->sleeping.buffer;
+
+    frVector2 *velocity = bs->mtn.velocity.buffer;
+    frVector2 *force = bs->mtn.force.buffer;
+
+    float *angularVelocity = bs->mtn.angularVelocity.buffer;
+
+    /*
+        NOTE: A body has a positive mass if and only if it has 
+        a positive inverse mass, so this is the same as calling
+        `frApplyGravityToBody()` and `frIntegrateForBodyVelocity()`
+        for each awake body.
+    */
+    for (int i = 0; i < length; i++) {
+        if (sleeping[i] || inverseMass[i] <= 0.0f) continue;
+
+        float gravityMass = gravityScale[i] * mass[i];
+
+        force[i].x += g.x * gravityMass, force[i].y += g.y * gravityMass;
+
+        float inverseMassDt = inverseMass[i] * dt;
+
+        velocity[i].x += force[i].x * inverseMassDt;
+        velocity[i].y += force[i].y * inverseMassDt;
+
+        angularVelocity[i] += (torque[i] * inverseInertia[i]) * dt;
+    }
+}
+
+/* 
+    Integrates the velocity of each awake body in `bs` over `dt`
+    to calculate the position of each awake body, then updates 
+    the AABB of each awake body.
+*/
+void frIntegrateForBodyStoragePositions(frBodyStorage *bs, float dt) {
+    if (bs == NULL || dt <= 0.0f) return;
+
+    int length = frGetDynArrayLength(bs->bodies);
+
+    const frVector2 *velocity = bs->mtn.velocity.buffer;
+    const float *angularVelocity = bs->mtn.angularVelocity.buffer;
+
+    const frBodyType *type = bs->type.buffer;
+    const bool *sleeping = bs->sleeping.buffer;
+
+    frTransform *tx = bs->tx.buffer;
+
+    for (int i = 0; i < length; i++) {
+        if (sleeping[i] || type[i] == FR_BODY_STATIC) continue;
+
+        tx[i].position.x += velocity[i].x * dt;
+        tx[i].position.y += velocity[i].y * dt;
+
+        if (angularVelocity[i] != 0.0f)
+            frSetTransformAngle(&tx[i],
+                                tx[i].angle + (angularVelocity[i] * dt));
+
+        frGetDynArrayValue(bs->aabb, i) = frGetShapeAABB(
+            frGetDynArrayValue(bs->shape, i), tx[i]);
+    }
+}
+
+/* Creates a new SIMD contact solver. */
+frContactSolver *frCreateContactSolver(void) {
+    frContactSolver *result = calloc(1, sizeof *result);
+
+    frInitDynArray(result->batches);
+
+    result->closed = true;
+
+    return result;
+}
+
+/* Releases the memory allocated for `cs`. */
+void frReleaseContactSolver(frContactSolver *cs) {
+    if (cs == NULL) return;
+
+    frReleaseDynArray(cs->batches);
+
+    free(cs);
+}
+
+/* Erases all contact batches from `cs`. */
+void frClearContactSolver(frContactSolver *cs) {
+    if (cs == NULL) return;
+
+    frSetDynArrayLength(cs->batches, 0);
+
+    cs->closed = true;
+}
+
+/* Returns the number of contact batches in `cs`. */
+int frGetContactSolverBatchCount(const frContactSolver *cs) {
+    return (cs != NULL) ? frGetDynArrayLength(cs->batches) : 0;
+}
+
+/* 
+    Adds the `collision` between `b1` and `b2` to the last contact batch 
+    of `cs` (or to a new contact batch if the last one is full or closed),
+    with the given Baumgarte stabilization parameters.
+
+    NOTE: `frApplyAccumulatedImpulses()` must be called for `collision`
+    before calling this function.
+*/
+void frAddToContactSolver(frContactSolver *cs,
+                          frBody *b1,
+                          frBody *b2,
+                          frCollision *collision,
+                          float inverseDt,
+                          float baumgarteFactor,
+                          float baumgarteSlop) {
+    if (cs == NULL || b1 == NULL || b2 == NULL || collision == NULL) return;
+
+    int batchCount = frGetDynArrayLength(cs->batches);
+
+    if (cs->closed
+        || frGetDynArrayValue(cs->batches, batchCount - 1).count
+               >= FR_SOLVER_LANE_COUNT) {
+        if (batchCount >= frGetDynArrayCapacity(cs->batches))
+            frSetDynArrayCapacity(cs->batches, 2 * batchCount);
+
+        frSetDynArrayLength(cs->batches, ++batchCount);
+
+        // NOTE: The empty lanes of a batch never change any velocity
+        memset(&frGetDynArrayValue(cs->batches, batchCount - 1),
+               0,
+               sizeof *cs->batches.buffer);
+
+        cs->closed = false;
+    }
+
+    frContactBatch *batch = &frGetDynArrayValue(cs->batches, batchCount - 1);
+
+    int i = batch->count++;
+
+    frBody *bodies[2] = { b1, b2 };
+
+    for (int j = 0; j < 2; j++) {
+        batch->bodies[j][i] = bodies[j];
+
+        // NOTE: Static and kinematic bodies must never be written to
+        if (frBodyField(bodies[j], type) != FR_BODY_DYNAMIC) continue;
+
+        batch->inverseMasses[j][i] = frBodyField(bodies[j], mtn.inverseMass);
+        batch->inverseInertias[j][i] = frBodyField(bodies[j],
+                                                   mtn.inverseInertia);
+    }
+
+    batch->collisions[i] = collision;
+
+    frVector2 ctxTangent = frVector2RightNormal(collision->direction);
+
+    batch->normalX[i] = collision->direction.x;
+    batch->normalY[i] = collision->direction.y;
+
+    batch->tangentX[i] = ctxTangent.x, batch->tangentY[i] = ctxTangent.y;
+
+    batch->friction[i] = collision->friction;
+    bool touching = false;
+
+    for (int k = 0; k < collision->count; k++)
+        if (collision->contacts[k].depth >= 0.0f) touching = true;
+
+    // NOTE: Two bodies must not bounce off before they touch each other
+    batch->restitution[i] = 1.0f + (touching ? collision->restitution : 0.0f);
+
+    for (int k = 0; k < collision->count; k++) {
+        const frContact *contact = &collision->contacts[k];
+
+        for (int j = 0; j < 2; j++) {
+            frVector2 relPosition = frVector2Subtract(
+                contact->point, frBodyField(bodies[j], tx).position);
+
+            frVector2 relNormal = frVector2LeftNormal(relPosition);
+
+            batch->contacts[k].relPositionX[j][i] = relPosition.x;
+            batch->contacts[k].relPositionY[j][i] = relPosition.y;
+
+            batch->contacts[k].relNormalX[j][i] = relNormal.x;
+            batch->contacts[k].relNormalY[j][i] = relNormal.y;
+        }
+
+        batch->contacts[k].biasScalar[i] =
+            frGetContactBiasScalar(contact->depth,
+                                   inverseDt,
+                                   baumgarteFactor,
+                                   baumgarteSlop);
+
+        batch->contacts[k].normalMass[i] = contact->cache.normalMass;
+        batch->contacts[k].normalScalar[i] = contact->cache.normalScalar;
+        batch->contacts[k].tangentMass[i] = contact->cache.tangentMass;
+        batch->contacts[k].tangentScalar[i] = contact->cache.tangentScalar;
+    }
+}
+
+/* 
+    Closes the last contact batch of `cs`, so that the next collision 
+    will be added to a new contact batch.
+
+    NOTE: All collisions in a contact batch will be resolved at the same 
+    time, so they must not share any dynamic body.
+*/
+void frCloseContactSolverBatch(frContactSolver *cs) {
+    if (cs != NULL) cs->closed = true;
+}
+
+/* 
+    Resolves the collisions in the contact batches of `cs`
+    within the range `[begin, end)`, then returns the largest change 
+    in the accumulated impulses of those collisions.
+*/
+float frResolveContactSolverBatches(frContactSolver *cs, int begin, int end) {
+    if (cs == NULL) return 0.0f;
+
+    if (begin < 0) begin = 0;
+
+    if (end > frGetDynArrayLength(cs->batches))
+        end = frGetDynArrayLength(cs->batches);
+
+    float maxImpulseScalar = 0.0f;
+
+    for (int i = begin; i < end; i++)
+        maxImpulseScalar = fmaxf(
+            maxImpulseScalar,
+            frResolveContactBatch(&frGetDynArrayValue(cs->batches, i)));
+
+    return maxImpulseScalar;
+}
+
+/* 
+    Stores the accumulated impulses of each collision in `cs` 
+    back to the collision, so that they can be used for warm starting.
+*/
+void frStoreContactSolverImpulses(frContactSolver *cs) {
+    if (cs == NULL) return;
+
+    for (int i = 0; i < frGetDynArrayLength(cs->batches); i++) {
+        const frContactBatch *batch = &frGetDynArrayValue(cs->batches, i);
+
+        for (int j = 0; j < batch->count; j++) {
+            frCollision *collision = batch->collisions[j];
+
+            for (int k = 0; k < collision->count; k++) {
+                collision->contacts[k].cache.normalScalar =
+                    batch->contacts[k].normalScalar[j];
+                collision->contacts[k].cache.tangentScalar =
+                    batch->contacts[k].tangentScalar[j];
+            }
+        }
+    }
+}
+
+/* Private Functions ======================================================> */
+
+/* Computes the mass and the moment of inertia for `b`. */
+static void frComputeBodyMass(frBody *b) {
+    float mass = 0.0f, inverseMass = 0.0f;
+    float inertia = 0.0f, inverseInertia = 0.0f;
+
+    frShape *s = frBodyField(b, shape);
+
+    switch (frBodyField(b, type)) {
+        case FR_BODY_STATIC:
+            frBodyField(b, mtn.velocity) = frStructZero(frVector2);
+            frBodyField(b, mtn.angularVelocity) = 0.0f;
+
+            break;
+
+        case FR_BODY_DYNAMIC:
+            if (!(b->flags & FR_FLAG_INFINITE_MASS)) {
+                mass = frGetShapeMass(s);
+
+                if (mass > 0.0f) inverseMass = 1.0f / mass;
+            }
+
+            if (!(b->flags & FR_FLAG_INFINITE_INERTIA)) {
+                inertia = frGetShapeInertia(s);
+
+                if (inertia > 0.0f) inverseInertia = 1.0f / inertia;
+            }
+
+            break;
+
+        default:
+            break;
+    }
+
+    frBodyField(b, mtn.mass) = mass;
+    frBodyField(b, mtn.inverseMass) = inverseMass;
+
+    frBodyField(b, mtn.inertia) = inertia;
+    frBodyField(b, mtn.inverseInertia) = inverseInertia;
+}
+
+/* 
+    Moves the data of `b` from the body storage of `b` 
+    back to `b` itself.
+*/
+static void frDetachBodyFromStorage(frBody *b) {
+    frBodyStorage *bs = b->storage;
+
+    int i = b->index;
+
+    b->mtn.mass = frGetDynArrayValue(bs->mtn.mass, i);
+    b->mtn.inverseMass = frGetDynArrayValue(bs->mtn.inverseMass, i);
+    b->mtn.inertia = frGetDynArrayValue(bs->mtn.inertia, i);
+    b->mtn.inverseInertia = frGetDynArrayValue(bs->mtn.inverseInertia, i);
+    b->mtn.velocity = frGetDynArrayValue(bs->mtn.velocity, i);
+    b->mtn.angularVelocity = frGetDynArrayValue(bs->mtn.angularVelocity, i);
+    b->mtn.gravityScale = frGetDynArrayValue(bs->mtn.gravityScale, i);
+    b->mtn.force = frGetDynArrayValue(bs->mtn.force, i);
+    b->mtn.torque = frGetDynArrayValue(bs->mtn.torque, i);
+
+    b->tx = frGetDynArrayValue(bs->tx, i);
+    b->shape = frGetDynArrayValue(bs->shape, i);
+    b->type = frGetDynArrayValue(bs->type, i);
+    b->aabb = frGetDynArrayValue(bs->aabb, i);
+    b->sleeping = frGetDynArrayValue(bs->sleeping, i);
+
+    b->storage = NULL, b->index = -1;
+}
+
+/* Swaps the data at index `i` of `bs` with the data at index `j`. */
+static void frSwapBodyStorageData(frBodyStorage *bs, int i, int j) {
+    frDynArraySwap(frBody *, bs->bodies, i, j);
+
+    frDynArraySwap(float, bs->mtn.mass, i, j);
+    frDynArraySwap(float, bs->mtn.inverseMass, i, j);
+    frDynArraySwap(float, bs->mtn.inertia, i, j);
+    frDynArraySwap(float, bs->mtn.inverseInertia, i, j);
+    frDynArraySwap(frVector2, bs->mtn.velocity, i, j);
+    frDynArraySwap(float, bs->mtn.angularVelocity, i, j);
+    frDynArraySwap(float, bs->mtn.gravityScale, i, j);
+    frDynArraySwap(frVector2, bs->mtn.force, i, j);
+    frDynArraySwap(float, bs->mtn.torque, i, j);
+
+    frDynArraySwap(frTransform, bs->tx, i, j);
+    frDynArraySwap(frShape *, bs->shape, i, j);
+    frDynArraySwap(frBodyType, bs->type, i, j);
+    frDynArraySwap(frAABB, bs->aabb, i, j);
+    frDynArraySwap(bool, bs->sleeping, i, j);
+}
+
+/* Sets the number of bodies in `bs` to `length`. */
+static void frSetBodyStorageLength(frBodyStorage *bs, int length) {
+    frSetDynArrayLength(bs->bodies, length);
+
+    frSetDynArrayLength(bs->mtn.mass, length);
+    frSetDynArrayLength(bs->mtn.inverseMass, length);
+    frSetDynArrayLength(bs->mtn.inertia, length);
+    frSetDynArrayLength(bs->mtn.inverseInertia, length);
+    frSetDynArrayLength(bs->mtn.velocity, length);
+    frSetDynArrayLength(bs->mtn.angularVelocity, length);
+    frSetDynArrayLength(bs->mtn.gravityScale, length);
+    frSetDynArrayLength(bs->mtn.force, length);
+    frSetDynArrayLength(bs->mtn.torque, length);
+
+    frSetDynArrayLength(bs->tx, length);
+    frSetDynArrayLength(bs->shape, length);
+    frSetDynArrayLength(bs->type, length);
+    frSetDynArrayLength(bs->aabb, length);
+    frSetDynArrayLength(bs->sleeping, length);
+}
+
+/* 
+    Applies an `impulse` to `b2` and the opposite impulse to `b1`, 
+    at the given positions relative to each body.
+*/
+static FR_API_INLINE void frApplyContactImpulse(frBody *b1,
+                                                frBody *b2,
+                                                frVector2 relPosition1,
+                                                frVector2 relPosition2,
+                                                frVector2 impulse) {
+    /*
+        NOTE: Static and kinematic bodies can be shared by several pairs
+        that are being solved at the same time, so they must never be 
+        written to (their impulses would be zero anyway).
+    */
+    if (frBodyField(b1, type) == FR_BODY_DYNAMIC) {
+        frBodyField(b1, mtn.velocity) = frVector2Subtract(
+            frBodyField(b1, mtn.velocity),
+            frVector2ScalarMultiply(impulse,
+                                    frBodyField(b1, mtn.inverseMass)));
+
+        frBodyField(b1, mtn.angularVelocity) -=
+            frBodyField(b1, mtn.inverseInertia)
+            * frVector2Cross(relPosition1, impulse);
+    }
+
+    if (frBodyField(b2, type) == FR_BODY_DYNAMIC) {
+        frBodyField(b2, mtn.velocity) = frVector2Add(
+            frBodyField(b2, mtn.velocity),
+            frVector2ScalarMultiply(impulse,
+                                    frBodyField(b2, mtn.inverseMass)));
+
+        frBodyField(b2, mtn.angularVelocity) +=
+            frBodyField(b2, mtn.inverseInertia)
+            * frVector2Cross(relPosition2, impulse);
+    }
+}
+
+/* 
+    Returns the velocity of `b2` relative to `b1` at the given positions 
+    relative to each body.
+*/
+static FR_API_INLINE frVector2 frGetContactVelocity(const frBody *b1,
+                                                    const frBody *b2,
+                                                    frVector2 relPosition1,
+                                                    frVector2 relPosition2) {
+    frVector2 pointVelocity1 = frVector2Add(
+        frBodyField(b1, mtn.velocity),
+        frVector2ScalarMultiply(frVector2LeftNormal(relPosition1),
+                                frBodyField(b1, mtn.angularVelocity)));
+
+    frVector2 pointVelocity2 = frVector2Add(
+        frBodyField(b2, mtn.velocity),
+        frVector2ScalarMultiply(frVector2LeftNormal(relPosition2),
+                                frBodyField(b2, mtn.angularVelocity)));
+
+    return frVector2Subtract(pointVelocity2, pointVelocity1);
+}
+
+/* Sets the `angle` of `b`, in radians, without waking `b` up. */
+static void frSetBodyRotation(frBody *b, float angle) {
+    frTransform *tx = &frBodyField(b, tx);
+
+    if (tx->angle == angle) return;
+
+    frSetTransformAngle(tx, angle);
+
+    frBodyField(b, aabb) = frGetShapeAABB(frBodyField(b, shape), *tx);
+}
+
+/* Sets the `angle` of `tx`, in radians. */
+static FR_API_INLINE void frSetTransformAngle(frTransform *tx, float angle) {
+    if (tx->angle == angle) return;
+
+    tx->angle = frNormalizeAngle(angle);
+
+    /*
+        NOTE: These values must be cached in order to 
+        avoid expensive computations as much as possible.
+    */
+    tx->rotation.sin_ = sinf(tx->angle);
+    tx->rotation.cos_ = cosf(tx->angle);
+}
+
+/* 
+    Returns the velocity bias of a contact with the given `depth`, 
+    which pushes two overlapping bodies apart or lets two separated 
+    bodies approach each other by their distance in a step.
+*/
+static FR_API_INLINE float frGetContactBiasScalar(float depth,
+                                                  float inverseDt,
+                                                  float baumgarteFactor,
+                                                  float baumgarteSlop) {
+    // NOTE: A negative depth means that this is a speculative contact
+    if (depth < 0.0f) return depth * inverseDt;
+
+    return -(baumgarteFactor * inverseDt)
+           * fminf(0.0f, -depth + baumgarteSlop);
+}
+
+/* Normalizes the `angle` to a range `[-2π, 2π]`. */
+static FR_API_INLINE float frNormalizeAngle(float angle) {
+    return angle - (TWO_PI * floorf((angle + -M_PI) * INVERSE_TWO_PI));
+}
+
+/* 
+    Resolves the collisions in `batch` at the same time, then returns 
+    the largest change in the accumulated impulses of `batch`.
+*/
+static float frResolveContactBatch(frContactBatch *batch) {
+    float velocityX[2][FR_SOLVER_LANE_COUNT] = { { 0.0f } };
+    float velocityY[2][FR_SOLVER_LANE_COUNT] = { { 0.0f } };
+    float angularVelocity[2][FR_SOLVER_LANE_COUNT] = { { 0.0f } };
+
+    for (int i = 0; i < batch->count; i++)
+        for (int j = 0; j < 2; j++) {
+            const frBody *b = batch->bodies[j][i];
+
+            frVector2 velocity = frBodyField(b, mtn.velocity);
+
+            velocityX[j][i] = velocity.x, velocityY[j][i] = velocity.y;
+
+            angularVelocity[j][i] = frBodyField(b, mtn.angularVelocity);
+        }
+
+    frFloatW v1x = frLoadFloatW(velocityX[0]);
+    frFloatW v1y = frLoadFloatW(velocityY[0]);
+    frFloatW w1 = frLoadFloatW(angularVelocity[0]);
+
+    frFloatW v2x = frLoadFloatW(velocityX[1]);
+    frFloatW v2y = frLoadFloatW(velocityY[1]);
+    frFloatW w2 = frLoadFloatW(angularVelocity[1]);
+
+    frFloatW inverseMass1 = frLoadFloatW(batch->inverseMasses[0]);
+    frFloatW inverseMass2 = frLoadFloatW(batch->inverseMasses[1]);
+
+    frFloatW inverseInertia1 = frLoadFloatW(batch->inverseInertias[0]);
+    frFloatW inverseInertia2 = frLoadFloatW(batch->inverseInertias[1]);
+
+    frFloatW normalX = frLoadFloatW(batch->normalX);
+    frFloatW normalY = frLoadFloatW(batch->normalY);
+
+    frFloatW tangentX = frLoadFloatW(batch->tangentX);
+    frFloatW tangentY = frLoadFloatW(batch->tangentY);
+
+    frFloatW friction = frLoadFloatW(batch->friction);
+    frFloatW restitution = frLoadFloatW(batch->restitution);
+
+    frFloatW zero = frSetFloatW(0.0f), maxImpulseScalar = zero;
+
+    /*
+        NOTE: This is the same computation as `frResolveCollision()`,
+        and the missing contacts of a collision have zero masses,
+        so their impulses will always be zero.
+    */
+    for (int k = 0; k < 2; k++) {
+        frFloatW r1x = frLoadFloatW(batch->contacts[k].relPositionX[0]);
+        frFloatW r1y = frLoadFloatW(batch->contacts[k].relPositionY[0]);
+
+        frFloatW r2x = frLoadFloatW(batch->contacts[k].relPositionX[1]);
+        frFloatW r2y = frLoadFloatW(batch->contacts[k].relPositionY[1]);
+
+        frFloatW n1x = frLoadFloatW(batch->contacts[k].relNormalX[0]);
+        frFloatW n1y = frLoadFloatW(batch->contacts[k].relNormalY[0]);
+
+        frFloatW n2x = frLoadFloatW(batch->contacts[k].relNormalX[1]);
+        frFloatW n2y = frLoadFloatW(batch->contacts[k].relNormalY[1]);
+
+        frFloatW relVelocityX = frSubtractFloatW(
+            frAddFloatW(v2x, frMultiplyFloatW(n2x, w2)),
+            frAddFloatW(v1x, frMultiplyFloatW(n1x, w1)));
+
+        frFloatW relVelocityY = frSubtractFloatW(
+            frAddFloatW(v2y, frMultiplyFloatW(n2y, w2)),
+            frAddFloatW(v1y, frMultiplyFloatW(n1y, w1)));
+
+        frFloatW relVelocityDot = frAddFloatW(
+            frMultiplyFloatW(relVelocityX, normalX),
+            frMultiplyFloatW(relVelocityY, normalY));
+
+        frFloatW normalScalar = frMultiplyFloatW(
+            frAddFloatW(frMultiplyFloatW(frSubtractFloatW(zero, restitution),
+                                         relVelocityDot),
+                        frLoadFloatW(batch->contacts[k].biasScalar)),
+            frLoadFloatW(batch->contacts[k].normalMass));
+
+        {
+            frFloatW oldNormalScalar = frLoadFloatW(
+                batch->contacts[k].normalScalar);
+
+            frFloatW newNormalScalar = frMaxFloatW(
+                zero, frAddFloatW(oldNormalScalar, normalScalar));
+
+            frStoreFloatW(batch->contacts[k].normalScalar, newNormalScalar);
+
+            normalScalar = frSubtractFloatW(newNormalScalar, oldNormalScalar);
+
+            maxImpulseScalar = frMaxFloatW(
+                maxImpulseScalar,
+                frMaxFloatW(normalScalar,
+                            frSubtractFloatW(zero, normalScalar)));
+        }
+
+        {
+            frFloatW impulseX = frMultiplyFloatW(normalX, normalScalar);
+            frFloatW impulseY = frMultiplyFloatW(normalY, normalScalar);
+
+            v1x = frSubtractFloatW(v1x,
+                                   frMultiplyFloatW(impulseX, inverseMass1));
+            v1y = frSubtractFloatW(v1y,
+                                   frMultiplyFloatW(impulseY, inverseMass1));
+
+            w1 = frSubtractFloatW(
+                w1,
+                frMultiplyFloatW(
+                    inverseInertia1,
+                    frSubtractFloatW(frMultiplyFloatW(r1x, impulseY),
+                                     frMultiplyFloatW(r1y, impulseX))));
+
+            v2x = frAddFloatW(v2x, frMultiplyFloatW(impulseX, inverseMass2));
+            v2y = frAddFloatW(v2y, frMultiplyFloatW(impulseY, inverseMass2));
+
+            w2 = frAddFloatW(
+                w2,
+                frMultiplyFloatW(
+                    inverseInertia2,
+                    frSubtractFloatW(frMultiplyFloatW(r2x, impulseY),
+                                     frMultiplyFloatW(r2y, impulseX))));
+        }
+
+        // NOTE: The friction must see the velocities after the normal impulse
+        relVelocityX = frSubtractFloatW(
+            frAddFloatW(v2x, frMultiplyFloatW(n2x, w2)),
+            frAddFloatW(v1x, frMultiplyFloatW(n1x, w1)));
+
+        relVelocityY = frSubtractFloatW(
+            frAddFloatW(v2y, frMultiplyFloatW(n2y, w2)),
+            frAddFloatW(v1y, frMultiplyFloatW(n1y, w1)));
+
+        frFloatW tangentScalar = frMultiplyFloatW(
+            frSubtractFloatW(zero,
+                             frAddFloatW(
+                                 frMultiplyFloatW(relVelocityX, tangentX),
+                                 frMultiplyFloatW(relVelocityY, tangentY))),
+            frLoadFloatW(batch->contacts[k].tangentMass));
+
+        {
+            // NOTE: Both the friction and the normal impulse are positive
+            frFloatW maxTangentScalar = frMultiplyFloatW(
+                friction, frLoadFloatW(batch->contacts[k].normalScalar));
+
+            frFloatW oldTangentScalar = frLoadFloatW(
+                batch->contacts[k].tangentScalar);
+
+            frFloatW newTangentScalar = frMinFloatW(
+                frMaxFloatW(frAddFloatW(oldTangentScalar, tangentScalar),
+                            frSubtractFloatW(zero, maxTangentScalar)),
+                maxTangentScalar);
+
+            frStoreFloatW(batch->contacts[k].tangentScalar, newTangentScalar);
+
+            tangentScalar = frSubtractFloatW(newTangentScalar,
+                                             oldTangentScalar);
+
+            maxImpulseScalar = frMaxFloatW(
+                maxImpulseScalar,
+                frMaxFloatW(tangentScalar,
+                            frSubtractFloatW(zero, tangentScalar)));
+        }
+
+        {
+            frFloatW impulseX = frMultiplyFloatW(tangentX, tangentScalar);
+            frFloatW impulseY = frMultiplyFloatW(tangentY, tangentScalar);
+
+            v1x = frSubtractFloatW(v1x,
+                                   frMultiplyFloatW(impulseX, inverseMass1));
+            v1y = frSubtractFloatW(v1y,
+                                   frMultiplyFloatW(impulseY, inverseMass1));
+
+            w1 = frSubtractFloatW(
+                w1,
+                frMultiplyFloatW(
+                    inverseInertia1,
+                    frSubtractFloatW(frMultiplyFloatW(r1x, impulseY),
+                                     frMultiplyFloatW(r1y, impulseX))));
+
+            v2x = frAddFloatW(v2x, frMultiplyFloatW(impulseX, inverseMass2));
+            v2y = frAddFloatW(v2y, frMultiplyFloatW(impulseY, inverseMass2));
+
+            w2 = frAddFloatW(
+                w2,
+                frMultiplyFloatW(
+                    inverseInertia2,
+                    frSubtractFloatW(frMultiplyFloatW(r2x, impulseY),
+                                     frMultiplyFloatW(r2y, impulseX))));
+        }
+    }
+
+    frStoreFloatW(velocityX[0], v1x), frStoreFloatW(velocityY[0], v1y);
+    frStoreFloatW(velocityX[1], v2x), frStoreFloatW(velocityY[1], v2y);
+
+    frStoreFloatW(angularVelocity[0], w1);
+    frStoreFloatW(angularVelocity[1], w2);
+
+    for (int i = 0; i < batch->count; i++)
+        for (int j = 0; j < 2; j++) {
+            frBody *b = batch->bodies[j][i];
+
+            if (frBodyField(b, type) != FR_BODY_DYNAMIC) continue;
+
+            frBodyField(b, mtn.velocity).x = velocityX[j][i];
+            frBodyField(b, mtn.velocity).y = velocityY[j][i];
+
+            frBodyField(b, mtn.angularVelocity) = angularVelocity[j][i];
+        }
+
+    float impulseScalars[FR_SOLVER_LANE_COUNT];
+
+    frStoreFloatW(impulseScalars, maxImpulseScalar);
+
+    float result = 0.0f;
+
+    for (int i = 0; i < batch->count; i++)
+        result = fmaxf(result, impulseScalars[i]);
+
+    return result;
+}
+
+#if defined(FR_SOLVER_AVX2)
+
+/* Returns a vector with all lanes set to `f`. */
+static FR_API_INLINE frFloatW frSetFloatW(float f) {
+    return _mm256_set1_ps(f);
+}
+
+/* Loads a vector from the given array of floats. */
+static FR_API_INLINE frFloatW frLoadFloatW(const float *ptr) {
+    return _mm256_loadu_ps(ptr);
+}
+
+/* Stores `v` to the given array of floats. */
+static FR_API_INLINE void frStoreFloatW(float *ptr, frFloatW v) {
+    _mm256_storeu_ps(ptr, v);
+}
+
+/* Adds `v1` and `v2`, lane by lane. */
+static FR_API_INLINE frFloatW frAddFloatW(frFloatW v1, frFloatW v2) {
+    return _mm256_add_ps(v1, v2);
+}
+
+/* Subtracts `v2` from `v1`, lane by lane. */
+static FR_API_INLINE frFloatW frSubtractFloatW(frFloatW v1, frFloatW v2) {
+    return _mm256_sub_ps(v1, v2);
+}
+
+/* Multiplies `v1` by `v2`, lane by lane. */
+static FR_API_INLINE frFloatW frMultiplyFloatW(frFloatW v1, frFloatW v2) {
+    return _mm256_mul_ps(v1, v2);
+}
+
+/* Returns the smaller of `v1` and `v2`, lane by lane. */
+static FR_API_INLINE frFloatW frMinFloatW(frFloatW v1, frFloatW v2) {
+    return _mm256_min_ps(v1, v2);
+}
+
+/* Returns the larger of `v1` and `v2`, lane by lane. */
+static FR_API_INLINE frFloatW frMaxFloatW(frFloatW v1, frFloatW v2) {
+    return _mm256_max_ps(v1, v2);
+}
+
+#elif defined(FR_SOLVER_SSE2)
+
+/* Returns a vector with all lanes set to `f`. */
+static FR_API_INLINE frFloatW frSetFloatW(float f) {
+    return _mm_set1_ps(f);
+}
+
+/* Loads a vector from the given array of floats. */
+static FR_API_INLINE frFloatW frLoadFloatW(const float *ptr) {
+    return _mm_loadu_ps(ptr);
+}
+
+/* Stores `v` to the given array of floats. */
+static FR_API_INLINE void frStoreFloatW(float *ptr, frFloatW v) {
+    _mm_storeu_ps(ptr, v);
+}
+
+/* Adds `v1` and `v2`, lane by lane. */
+static FR_API_INLINE frFloatW frAddFloatW(frFloatW v1, frFloatW v2) {
+    return _mm_add_ps(v1, v2);
+}
+
+/* Subtracts `v2` from `v1`, lane by lane. */
+static FR_API_INLINE frFloatW frSubtractFloatW(frFloatW v1, frFloatW v2) {
+    return _mm_sub_ps(v1, v2);
+}
+
+/* Multiplies `v1` by `v2`, lane by lane. */
+static FR_API_INLINE frFloatW frMultiplyFloatW(frFloatW v1, frFloatW v2) {
+    return _mm_mul_ps(v1, v2);
+}
+
+/* Returns the smaller of `v1` and `v2`, lane by lane. */
+static FR_API_INLINE frFloatW frMinFloatW(frFloatW v1, frFloatW v2) {
+    return _mm_min_ps(v1, v2);
+}
+
+/* Returns the larger of `v1` and `v2`, lane by lane. */
+static FR_API_INLINE frFloatW frMaxFloatW(frFloatW v1, frFloatW v2) {
+    return _mm_max_ps(v1, v2);
+}
+
+#elif defined(FR_SOLVER_NEON)
+
+/* Returns a vector with all lanes set to `f`. */
+static FR_API_INLINE frFloatW frSetFloatW(float f) {
+    return vdupq_n_f32(f);
+}
+
+/* Loads a vector from the given array of floats. */
+static FR_API_INLINE frFloatW frLoadFloatW(const float *ptr) {
+    return vld1q_f32(ptr);
+}
+
+/* Stores `v` to the given array of floats. */
+static FR_API_INLINE void frStoreFloatW(float *ptr, frFloatW v) {
+    vst1q_f32(ptr, v);
+}
+
+/* Adds `v1` and `v2`, lane by lane. */
+static FR_API_INLINE frFloatW frAddFloatW(frFloatW v1, frFloatW v2) {
+    return vaddq_f32(v1, v2);
+}
+
+/* Subtracts `v2` from `v1`, lane by lane. */
+static FR_API_INLINE frFloatW frSubtractFloatW(frFloatW v1, frFloatW v2) {
+    return vsubq_f32(v1, v2);
+}
+
+/* Multiplies `v1` by `v2`, lane by lane. */
+static FR_API_INLINE frFloatW frMultiplyFloatW(frFloatW v1, frFloatW v2) {
+    return vmulq_f32(v1, v2);
+}
+
+/* Returns the smaller of `v1` and `v2`, lane by lane. */
+static FR_API_INLINE frFloatW frMinFloatW(frFloatW v1, frFloatW v2) {
+    return vminq_f32(v1, v2);
+}
+
+/* Returns the larger of `v1` and `v2`, lane by lane. */
+static FR_API_INLINE frFloatW frMaxFloatW(frFloatW v1, frFloatW v2) {
+    return vmaxq_f32(v1, v2);
+}
+
+#else
+
+/* Returns a vector with all lanes set to `f`. */
+static FR_API_INLINE frFloatW frSetFloatW(float f) {
+    frFloatW result;
+
+    for (int i = 0; i < FR_SOLVER_LANE_COUNT; i++)
+        result.v[i] = f;
+
+    return result;
+}
+
+/* Loads a vector from the given array of floats. */
+static FR_API_INLINE frFloatW frLoadFloatW(const float *ptr) {
+    frFloatW result;
+
+    memcpy(result.v, ptr, sizeof result.v);
+
+    return result;
+}
+
+/* Stores `v` to the given array of floats. */
+static FR_API_INLINE void frStoreFloatW(float *ptr, frFloatW v) {
+    memcpy(ptr, v.v, sizeof v.v);
+}
+
+/* Adds `v1` and `v2`, lane by lane. */
+static FR_API_INLINE frFloatW frAddFloatW(frFloatW v1, frFloatW v2) {
+    for (int i = 0; i < FR_SOLVER_LANE_COUNT; i++)
+        v1.v[i] += v2.v[i];
+
+    return v1;
+}
+
+/* Subtracts `v2` from `v1`, lane by lane. */
+static FR_API_INLINE frFloatW frSubtractFloatW(frFloatW v1, frFloatW v2) {
+    for (int i = 0; i < FR_SOLVER_LANE_COUNT; i++)
+        v1.v[i] -= v2.v[i];
+
+    return v1;
+}
+
+/* Multiplies `v1` by `v2`, lane by lane. */
+static FR_API_INLINE frFloatW frMultiplyFloatW(frFloatW v1, frFloatW v2) {
+    for (int i = 0; i < FR_SOLVER_LANE_COUNT; i++)
+        v1.v[i] *= v2.v[i];
+
+    return v1;
+}
+
+/* Returns the smaller of `v1` and `v2`, lane by lane. */
+static FR_API_INLINE frFloatW frMinFloatW(frFloatW v1, frFloatW v2) {
+    for (int i = 0; i < FR_SOLVER_LANE_COUNT; i++)
+        v1.v[i] = fminf(v1.v[i], v2.v[i]);
+
+    return v1;
+}
+
+/* Returns the larger of `v1` and `v2`, lane by lane. */
+static FR_API_INLINE frFloatW frMaxFloatW(frFloatW v1, frFloatW v2) {
+    for (int i = 0; i < FR_SOLVER_LANE_COUNT; i++)
+        v1.v[i] = fmaxf(v1.v[i], v2.v[i]);
+
+    return v1;
+}
+
+#endif
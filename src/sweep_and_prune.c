@@ -0,0 +1,428 @@
+/*
+    Copyright (c) 2021-2025 Jaedeok Kim <jdeokkim@protonmail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a 
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation 
+    the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+    and/or sell copies of the Software, and to permit persons to whom the 
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included 
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Includes ===============================================================> */
+
+#include "external/ferox_utils.h"
+
+#include "ferox.h"
+
+/* Macros =================================================================> */
+
+/*
+    The number of elements that can be inserted between two sorts
+    before the endpoints are sorted from scratch.
+*/
+#define FR_SWEEP_AND_PRUNE_RESORT_THRESHOLD  32
+
+/* Typedefs ===============================================================> */
+
+/* A structure that represents an element of a sweep-and-prune structure. */
+typedef struct frSweepProxy_ {
+    frAABB aabb;
+    int value, next;
+    bool removed;
+} frSweepProxy;
+
+/*
+    A structure that represents the AABB of an element,
+    sorted along the x-axis.
+*/
+typedef struct frSweepEndpoint_ {
+    frAABB aabb;
+    int proxyId;
+} frSweepEndpoint;
+
+/* A structure that represents a sweep-and-prune structure. */
+struct frSweepAndPrune_ {
+    frDynArray(frSweepProxy) proxies;
+    frDynArray(frSweepEndpoint) endpoints;
+    frAABB bounds;
+    int freeList, removeList, sortedCount, insertCount;
+    bool dirty;
+};
+
+/* Private Function Prototypes ============================================> */
+
+/* Compares the minimum x-coordinates of two endpoints for `qsort()`. */
+static int frCompareSweepEndpoints(const void *e1, const void *e2);
+
+/* Checks if `a1` and `a2` overlap along the y-axis. */
+static FR_API_INLINE bool frAABBOverlapsY(frAABB a1, frAABB a2);
+
+/* Checks if the element of `endpoint` in `sap` has been removed. */
+static FR_API_INLINE bool frIsSweepEndpointRemoved(
+    const frSweepAndPrune *sap,
+    const frSweepEndpoint *endpoint);
+
+/* Public Functions =======================================================> */
+
+/* Creates a new sweep-and-prune structure. */
+frSweepAndPrune *frCreateSweepAndPrune(void) {
+    frSweepAndPrune *sap = calloc(1, sizeof *sap);
+
+    sap->freeList = sap->removeList = -1;
+
+    frInitDynArray(sap->proxies);
+    frInitDynArray(sap->endpoints);
+
+    return sap;
+}
+
+/* Releases the memory allocated for `sap`. */
+void frReleaseSweepAndPrune(frSweepAndPrune *sap) {
+    if (sap == NULL) return;
+
+    frReleaseDynArray(sap->proxies);
+    frReleaseDynArray(sap->endpoints);
+
+    free(sap);
+}
+
+/* Erases all elements from `sap`. */
+void frClearSweepAndPrune(frSweepAndPrune *sap) {
+    if (sap == NULL) return;
+
+    frSetDynArrayLength(sap->proxies, 0);
+    frSetDynArrayLength(sap->endpoints, 0);
+
+    sap->bounds = (frAABB) { .width = 0.0f };
+
+    sap->freeList = sap->removeList = -1;
+
+    sap->sortedCount = sap->insertCount = 0;
+}
+
+/*
+    Returns the bounds of all elements in `sap`,
+    as of the last call to `frSortSweepAndPrune()`.
+*/
+frAABB frGetSweepAndPruneBounds(const frSweepAndPrune *sap) {
+    return (sap != NULL) ? sap->bounds : (frAABB) { .width = 0.0f };
+}
+
+/*
+    Inserts a `key`-`value` pair into `sap`,
+    then returns the proxy ID of the new element.
+*/
+int frInsertIntoSweepAndPrune(frSweepAndPrune *sap, frAABB key, int value) {
+    if (sap == NULL) return -1;
+
+    int proxyId = sap->freeList;
+
+    if (proxyId >= 0) {
+        sap->freeList = frGetDynArrayValue(sap->proxies, proxyId).next;
+    } else {
+        proxyId = frGetDynArrayLength(sap->proxies);
+
+        frDynArrayPush(sap->proxies, (frSweepProxy) { .next = -1 });
+    }
+
+    frGetDynArrayValue(sap->proxies, proxyId) = (frSweepProxy) {
+        .aabb = key, .value = value, .next = -1
+    };
+
+    /*
+        NOTE: The new endpoint will be moved to its correct position
+        by the next call to `frSortSweepAndPrune()`.
+    */
+    frDynArrayPush(sap->endpoints,
+                   ((frSweepEndpoint) { .aabb = key, .proxyId = proxyId }));
+
+    sap->dirty = true, sap->insertCount++;
+
+    return proxyId;
+}
+
+/* Removes an element with the given `proxyId` from `sap`. */
+void frRemoveFromSweepAndPrune(frSweepAndPrune *sap, int proxyId) {
+    if (sap == NULL || proxyId < 0
+        || proxyId >= frGetDynArrayLength(sap->proxies))
+        return;
+
+    frSweepProxy *proxy = &frGetDynArrayValue(sap->proxies, proxyId);
+
+    if (proxy->removed) return;
+
+    /*
+        NOTE: The endpoint of this element will be dropped (and its proxy 
+        will be reused) by the next call to `frSortSweepAndPrune()`,
+        so removing `k` elements only takes a single pass over the endpoints.
+    */
+    proxy->value = -1, proxy->next = sap->removeList, proxy->removed = true;
+
+    sap->removeList = proxyId, sap->dirty = true;
+}
+
+/* Updates the `key` of an element with the given `proxyId` in `sap`. */
+void frUpdateSweepAndPrune(frSweepAndPrune *sap, int proxyId, frAABB key) {
+    if (sap == NULL || proxyId < 0
+        || proxyId >= frGetDynArrayLength(sap->proxies))
+        return;
+
+    frGetDynArrayValue(sap->proxies, proxyId).aabb = key;
+
+    sap->dirty = true;
+}
+
+/* Sets the `value` of an element with the given `proxyId` in `sap`. */
+void frSetSweepAndPruneValue(frSweepAndPrune *sap, int proxyId, int value) {
+    if (sap == NULL || proxyId < 0
+        || proxyId >= frGetDynArrayLength(sap->proxies))
+        return;
+
+    frGetDynArrayValue(sap->proxies, proxyId).value = value;
+}
+
+/*
+    Drops the endpoints of the removed elements in `sap`, copies the AABB 
+    of each element in `sap` to its endpoint, then sorts the endpoints 
+    by their minimum x-coordinates.
+*/
+void frSortSweepAndPrune(frSweepAndPrune *sap) {
+    if (sap == NULL || !sap->dirty) return;
+
+    int endpointCount = frGetDynArrayLength(sap->endpoints);
+
+    if (sap->removeList >= 0) {
+        int newCount = 0;
+
+        // NOTE: Keeping the order of the remaining endpoints keeps them sorted
+        for (int i = 0; i < endpointCount; i++) {
+            frSweepEndpoint endpoint = frGetDynArrayValue(sap->endpoints, i);
+
+            if (frGetDynArrayValue(sap->proxies, endpoint.proxyId).removed)
+                continue;
+
+            frGetDynArrayValue(sap->endpoints, newCount) = endpoint;
+
+            newCount++;
+        }
+
+        frSetDynArrayLength(sap->endpoints, newCount);
+
+        endpointCount = newCount;
+
+        // NOTE: The removed proxies can now be reused, most recent first
+        int lastId = sap->removeList;
+
+        while (frGetDynArrayValue(sap->proxies, lastId).next >= 0)
+            lastId = frGetDynArrayValue(sap->proxies, lastId).next;
+
+        frGetDynArrayValue(sap->proxies, lastId).next = sap->freeList;
+
+        sap->freeList = sap->removeList, sap->removeList = -1;
+    }
+
+    float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+
+    for (int i = 0; i < endpointCount; i++) {
+        frSweepEndpoint *endpoint = &frGetDynArrayValue(sap->endpoints, i);
+
+        endpoint->aabb = frGetDynArrayValue(sap->proxies, endpoint->proxyId)
+                             .aabb;
+
+        frAABB aabb = endpoint->aabb;
+
+        minX = fminf(minX, aabb.x), minY = fminf(minY, aabb.y);
+
+        maxX = fmaxf(maxX, aabb.x + aabb.width);
+        maxY = fmaxf(maxY, aabb.y + aabb.height);
+    }
+
+    sap->bounds = (endpointCount > 0)
+                      ? (frAABB) { .x = minX,
+                                   .y = minY,
+                                   .width = maxX - minX,
+                                   .height = maxY - minY }
+                      : (frAABB) { .width = 0.0f };
+
+    /*
+        NOTE: The new endpoints are appended in no particular order,
+        so inserting many elements at once (e.g. while loading a level)
+        would make insertion sort run in quadratic time.
+    */
+    if (sap->insertCount > FR_SWEEP_AND_PRUNE_RESORT_THRESHOLD) {
+        qsort(sap->endpoints.buffer,
+              endpointCount,
+              sizeof(frSweepEndpoint),
+              frCompareSweepEndpoints);
+    } else {
+        /*
+            NOTE: The order of the endpoints rarely changes much 
+            between steps, so insertion sort runs in nearly linear time here.
+        */
+        for (int i = 1; i < endpointCount; i++) {
+            frSweepEndpoint endpoint = frGetDynArrayValue(sap->endpoints, i);
+
+            int j = i - 1;
+
+            for (; j >= 0 && frGetDynArrayValue(sap->endpoints, j).aabb.x
+                                 > endpoint.aabb.x;
+                 j--)
+                frGetDynArrayValue(sap->endpoints, j + 1) =
+                    frGetDynArrayValue(sap->endpoints, j);
+
+            frGetDynArrayValue(sap->endpoints, j + 1) = endpoint;
+        }
+    }
+
+    sap->sortedCount = endpointCount, sap->dirty = false;
+
+    sap->insertCount = 0;
+}
+
+/*
+    Query `sap` for any objects that overlap the given `aabb`,
+    as of the last call to `frSortSweepAndPrune()`.
+*/
+void frQuerySweepAndPrune(const frSweepAndPrune *sap,
+                          frAABB aabb,
+                          frSweepQueryFunc func,
+                          void *userData) {
+    if (sap == NULL || func == NULL) return;
+
+    float maxX = aabb.x + aabb.width;
+
+    for (int i = 0; i < sap->sortedCount; i++) {
+        const frSweepEndpoint *endpoint = &frGetDynArrayValue(sap->endpoints,
+                                                              i);
+
+        // NOTE: No other endpoint can overlap `aabb` from now on
+        if (endpoint->aabb.x > maxX) break;
+
+        if (endpoint->aabb.x + endpoint->aabb.width < aabb.x
+            || !frAABBOverlapsY(endpoint->aabb, aabb)
+            || frIsSweepEndpointRemoved(sap, endpoint))
+            continue;
+
+        func((frContextNode) {
+            .id = frGetDynArrayValue(sap->proxies, endpoint->proxyId).value,
+            .ctx = userData });
+    }
+}
+
+/*
+    Query `sap` for all pairs of objects that overlap each other,
+    as of the last call to `frSortSweepAndPrune()`.
+*/
+void frQuerySweepAndPrunePairs(const frSweepAndPrune *sap,
+                               frPairQueryFunc func,
+                               void *userData) {
+    if (sap == NULL || func == NULL) return;
+
+    int endpointCount = sap->sortedCount;
+
+    for (int i = 0; i < endpointCount; i++) {
+        const frSweepEndpoint *e1 = &frGetDynArrayValue(sap->endpoints, i);
+
+        if (frIsSweepEndpointRemoved(sap, e1)) continue;
+
+        float maxX = e1->aabb.x + e1->aabb.width;
+
+        /*
+            NOTE: Since the endpoints are sorted by their minimum
+            x-coordinates, we only have to look at the endpoints
+            that start before `e1` ends along the x-axis.
+        */
+        for (int j = i + 1; j < endpointCount; j++) {
+            const frSweepEndpoint *e2 = &frGetDynArrayValue(sap->endpoints,
+                                                            j);
+
+            if (e2->aabb.x > maxX) break;
+
+            if (!frAABBOverlapsY(e1->aabb, e2->aabb)
+                || frIsSweepEndpointRemoved(sap, e2))
+                continue;
+
+            func(frGetDynArrayValue(sap->proxies, e1->proxyId).value,
+                 frGetDynArrayValue(sap->proxies, e2->proxyId).value,
+                 userData);
+        }
+    }
+}
+
+/*
+    Casts a `ray` against `sap`, then calls `func` for each object 
+    whose AABB is hit by `ray`, which returns the new maximum distance 
+    of `ray`, as of the last call to `frSortSweepAndPrune()`.
+*/
+void frRaycastSweepAndPrune(const frSweepAndPrune *sap,
+                            frRay ray,
+                            frSweepRaycastFunc func,
+                            void *userData) {
+    if (sap == NULL || func == NULL) return;
+
+    frVector2 direction = frVector2Normalize(ray.direction);
+
+    for (int i = 0; i < sap->sortedCount; i++) {
+        const frSweepEndpoint *endpoint = &frGetDynArrayValue(sap->endpoints,
+                                                              i);
+
+        // NOTE: No other endpoint can be hit by `ray` from now on
+        if (endpoint->aabb.x
+            > ray.origin.x + fmaxf(direction.x, 0.0f) * ray.maxDistance)
+            break;
+
+        if (!frComputeAABBRaycast(endpoint->aabb, ray, NULL)
+            || frIsSweepEndpointRemoved(sap, endpoint))
+            continue;
+
+        float newMaxDistance = func(
+            (frContextNode) {
+                .id = frGetDynArrayValue(sap->proxies, endpoint->proxyId)
+                          .value,
+                .ctx = userData },
+            ray.maxDistance);
+
+        // NOTE: The callback function wants us to stop right away
+        if (newMaxDistance <= 0.0f) return;
+
+        if (ray.maxDistance > newMaxDistance) ray.maxDistance = newMaxDistance;
+    }
+}
+
+/* Private Functions ======================================================> */
+
+/* Compares the minimum x-coordinates of two endpoints for `qsort()`. */
+static int frCompareSweepEndpoints(const void *e1, const void *e2) {
+    float x1 = ((const frSweepEndpoint *) e1)->aabb.x;
+    float x2 = ((const frSweepEndpoint *) e2)->aabb.x;
+
+    return (x1 > x2) - (x1 < x2);
+}
+
+/* Checks if `a1` and `a2` overlap along the y-axis. */
+static FR_API_INLINE bool frAABBOverlapsY(frAABB a1, frAABB a2) {
+    return (a1.y <= a2.y + a2.height && a2.y <= a1.y + a1.height);
+}
+
+/* Checks if the element of `endpoint` in `sap` has been removed. */
+static FR_API_INLINE bool frIsSweepEndpointRemoved(
+    const frSweepAndPrune *sap,
+    const frSweepEndpoint *endpoint) {
+    /*
+        NOTE: The endpoints of the removed elements are only dropped
+        by the next call to `frSortSweepAndPrune()`.
+    */
+    return frGetDynArrayValue(sap->proxies, endpoint->proxyId).removed;
+}
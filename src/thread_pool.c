@@ -0,0 +1,245 @@
+/*
+    Copyright (c) 2021-2025 Jaedeok Kim <jdeokkim@protonmail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a 
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation 
+    the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+    and/or sell copies of the Software, and to permit persons to whom the 
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included 
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/* Includes ===============================================================> */
+
+#include "external/ferox_utils.h"
+
+#include "ferox.h"
+
+/*
+    NOTE: MSVC does not ship with POSIX threads, so each thread pool
+    will run all of its tasks on the calling thread there.
+*/
+#ifndef _MSC_VER
+    #include <pthread.h>
+
+    #define FR_THREAD_POOL_PTHREADS
+#endif
+
+/* Typedefs ===============================================================> */
+
+/* A structure that represents a worker thread of a thread pool. */
+typedef struct frThreadWorker_ {
+    frThreadPool *tp;
+    int index;
+#ifdef FR_THREAD_POOL_PTHREADS
+    pthread_t thread;
+#endif
+} frThreadWorker;
+
+/* A structure that represents a pool of worker threads. */
+struct frThreadPool_ {
+    frThreadWorker *workers;
+    frThreadTaskFunc func;
+    void *userData;
+    int threadCount, taskCount;
+    int pendingCount;
+    unsigned int generation;
+    bool running;
+#ifdef FR_THREAD_POOL_PTHREADS
+    pthread_mutex_t mutex;
+    pthread_cond_t startCond, doneCond;
+#endif
+};
+
+/* Private Function Prototypes ============================================> */
+
+/* Runs the `i`-th range of the current task of `tp`. */
+static FR_API_INLINE void frRunThreadPoolRange(frThreadPool *tp, int i);
+
+#ifdef FR_THREAD_POOL_PTHREADS
+
+/* The entry point of each worker thread of a thread pool. */
+static void *frThreadWorkerMain(void *ctx);
+
+#endif
+
+/* Public Functions =======================================================> */
+
+/* 
+    Creates a thread pool with `threadCount` threads, 
+    including the calling thread.
+*/
+frThreadPool *frCreateThreadPool(int threadCount) {
+    if (threadCount < 1) threadCount = 1;
+
+#ifndef FR_THREAD_POOL_PTHREADS
+    threadCount = 1;
+#endif
+
+    frThreadPool *result = calloc(1, sizeof *result);
+
+    result->threadCount = threadCount;
+    result->running = true;
+
+    result->workers = calloc(threadCount, sizeof *result->workers);
+
+#ifdef FR_THREAD_POOL_PTHREADS
+    pthread_mutex_init(&result->mutex, NULL);
+
+    pthread_cond_init(&result->startCond, NULL);
+    pthread_cond_init(&result->doneCond, NULL);
+
+    // NOTE: The first 'worker' is the thread that calls `frRunThreadPool()`
+    for (int i = 1; i < threadCount; i++) {
+        frThreadWorker *worker = &result->workers[i];
+
+        worker->tp = result, worker->index = i;
+
+        if (pthread_create(&worker->thread, NULL, frThreadWorkerMain, worker)
+            != 0) {
+            result->threadCount = i;
+
+            break;
+        }
+    }
+#endif
+
+    return result;
+}
+
+/* Releases the memory allocated for `tp`, then joins all of its threads. */
+void frReleaseThreadPool(frThreadPool *tp) {
+    if (tp == NULL) return;
+
+#ifdef FR_THREAD_POOL_PTHREADS
+    pthread_mutex_lock(&tp->mutex);
+
+    tp->running = false;
+
+    pthread_cond_broadcast(&tp->startCond);
+    pthread_mutex_unlock(&tp->mutex);
+
+    for (int i = 1; i < tp->threadCount; i++)
+        pthread_join(tp->workers[i].thread, NULL);
+
+    pthread_cond_destroy(&tp->doneCond);
+    pthread_cond_destroy(&tp->startCond);
+
+    pthread_mutex_destroy(&tp->mutex);
+#endif
+
+    free(tp->workers);
+
+    free(tp);
+}
+
+/* Returns the number of threads in `tp`, including the calling thread. */
+int frGetThreadPoolSize(const frThreadPool *tp) {
+    return (tp != NULL) ? tp->threadCount : 1;
+}
+
+/* 
+    Splits the range `[0, count)` into contiguous ranges, one for 
+    each thread in `tp`, then calls `func` for each range and 
+    waits for all of them to finish.
+
+    NOTE: The `i`-th range is always given to the `i`-th thread, so the 
+    ranges only depend on `count` and the number of threads in `tp`.
+*/
+void frRunThreadPool(frThreadPool *tp,
+                     int count,
+                     frThreadTaskFunc func,
+                     void *userData) {
+    if (func == NULL || count <= 0) return;
+
+    if (tp == NULL || tp->threadCount <= 1) {
+        func(0, 0, count, userData);
+
+        return;
+    }
+
+    tp->func = func, tp->userData = userData, tp->taskCount = count;
+
+#ifdef FR_THREAD_POOL_PTHREADS
+    pthread_mutex_lock(&tp->mutex);
+
+    tp->pendingCount = tp->threadCount - 1;
+    tp->generation++;
+
+    pthread_cond_broadcast(&tp->startCond);
+    pthread_mutex_unlock(&tp->mutex);
+#endif
+
+    frRunThreadPoolRange(tp, 0);
+
+#ifdef FR_THREAD_POOL_PTHREADS
+    pthread_mutex_lock(&tp->mutex);
+
+    while (tp->pendingCount > 0)
+        pthread_cond_wait(&tp->doneCond, &tp->mutex);
+
+    pthread_mutex_unlock(&tp->mutex);
+#endif
+}
+
+/* Private Functions ======================================================> */
+
+/* Runs the `i`-th range of the current task of `tp`. */
+static FR_API_INLINE void frRunThreadPoolRange(frThreadPool *tp, int i) {
+    int begin = (int) (((long long) tp->taskCount * i) / tp->threadCount);
+    int end = (int) (((long long) tp->taskCount * (i + 1)) / tp->threadCount);
+
+    if (begin < end) tp->func(i, begin, end, tp->userData);
+}
+
+#ifdef FR_THREAD_POOL_PTHREADS
+
+/* The entry point of each worker thread of a thread pool. */
+static void *frThreadWorkerMain(void *ctx) {
+    frThreadWorker *worker = ctx;
+
+    frThreadPool *tp = worker->tp;
+
+    unsigned int generation = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&tp->mutex);
+
+        while (tp->running && tp->generation == generation)
+            pthread_cond_wait(&tp->startCond, &tp->mutex);
+
+        if (!tp->running) {
+            pthread_mutex_unlock(&tp->mutex);
+
+            break;
+        }
+
+        generation = tp->generation;
+
+        pthread_mutex_unlock(&tp->mutex);
+
+        frRunThreadPoolRange(tp, worker->index);
+
+        pthread_mutex_lock(&tp->mutex);
+
+        if (--tp->pendingCount == 0) pthread_cond_signal(&tp->doneCond);
+
+        pthread_mutex_unlock(&tp->mutex);
+    }
+
+    return NULL;
+}
+
+#endif
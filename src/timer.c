@@ -45,11 +45,16 @@ static bool initialized = false;
 
 /* Returns the current time of the monotonic clock, in seconds. */
 float frGetCurrentTime(void) {
+    return frGetCurrentTicks() * TICKS_TO_SECONDS;
+}
+
+/* Returns the current time of the monotonic clock, in nanoseconds. */
+unsigned long long frGetCurrentTicks(void) {
     if (!initialized) {
         initialized = true;
 
         stm_setup();
     }
 
-    return stm_now() * TICKS_TO_SECONDS;
+    return stm_now();
 }
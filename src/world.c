@@ -29,8 +29,56 @@
 
 #include "ferox.h"
 
+/* Macros =================================================================> */
+
+// clang-format off
+
+/* The maximum number of colors for the graph-coloring solver. */
+#define FR_SOLVER_MAX_COLOR_COUNT      64
+
+/* 
+    The minimum number of pairs in a color 
+    for the color to be solved in parallel.
+*/
+#define FR_SOLVER_MIN_PARALLEL_COUNT   32
+
+#if FR_WORLD_ENABLE_PROFILING
+    /* Resets the profiling data of `w`. */
+    #define frResetWorldStats(w)  \
+        ((w)->stats = frStructZero(frWorldStats))
+
+    /* Starts a timer with the given `name`. */
+    #define frBeginWorldTimer(name)  \
+        unsigned long long name = frGetCurrentTicks()
+
+    /* 
+        Adds the time elapsed since the timer with the given `name` 
+        started to the `field` of the profiling data of `w`.
+    */
+    #define frEndWorldTimer(w, name, field)                                  \
+        ((w)->stats.field += 1e-6f * (float) (frGetCurrentTicks() - (name)))
+
+    /* Adds `value` to the `field` of the profiling data of `w`. */
+    #define frAddWorldCounter(w, field, value)  \
+        ((w)->stats.field += (value))
+#else
+    #define frResetWorldStats(w)                ((void) 0)
+    #define frBeginWorldTimer(name)             ((void) 0)
+    #define frEndWorldTimer(w, name, field)     ((void) 0)
+    #define frAddWorldCounter(w, field, value)  ((void) 0)
+#endif
+
+// clang-format on
+
 /* Typedefs ===============================================================> */
 
+/* An enumeration that represents the type of a raycast query. */
+typedef enum frRaycastType_ {
+    FR_RAYCAST_ALL,
+    FR_RAYCAST_CLOSEST,
+    FR_RAYCAST_ANY
+} frRaycastType;
+
 /* A structure that represents the type of an operation for a world. */
 typedef enum frWorldOpType_ {
     FR_OPT_UNKNOWN,
@@ -42,59 +90,363 @@ typedef enum frWorldOpType_ {
 typedef struct frContactCacheEntry_ {
     frBodyPair key;
     frCollision value;
+    int indices[2], proxyIds[2];
+    int color;
+    unsigned int stepCount;
 } frContactCacheEntry;
 
+/* 
+    A structure that represents a ray in `frComputeWorldRaycastBatch()`,
+    along with the cell its origin lies in.
+*/
+typedef struct frRaycastBatchEntry_ {
+    frAABB aabb;
+    int cellX, cellY;
+    int index, group;
+} frRaycastBatchEntry;
+
+/* 
+    A structure that represents a group of rays that start in the same cell,
+    along with the range of the bodies that any of those rays might hit.
+*/
+typedef struct frRaycastBatchGroup_ {
+    frAABB aabb;
+    int offset, count;
+} frRaycastBatchGroup;
+
+/* A structure that represents a node of the island graph of a world. */
+typedef struct frIslandNode_ {
+    int parent;
+    float sleepTime;
+    bool awake;
+} frIslandNode;
+
+/*
+    A structure that represents the context data 
+    for `frBulletQueryCallback()`.
+*/
+typedef struct frBulletQueryCtx_ {
+    frWorld *world;
+    frBody *body;
+    const frBody *other;
+    float dt, toi;
+} frBulletQueryCtx;
+
 /* A structure that represents a simulation container. */
 struct frWorld_ {
     frDynArray(frBody *) bodies;
+    frBodyStorage *storage;
+    frDynArray(int) proxyIds;
+    frDynArray(frAABB) newAABBs;
+    frDynArray(int) newIndices, newProxyIds;
+    frDynArray(frBulletQueryCtx) bullets;
     frRingBuffer(frContextNode) rbf;
+    frBroadPhaseType broadPhaseType;
     frSpatialHash *hash;
+    frDynamicTree *tree;
+    frSweepAndPrune *sap;
     frContactCacheEntry *cache;
-    float accumulator, timestamp;
+    frDynArray(frRaycastBatchEntry) rayEntries;
+    frDynArray(frRaycastBatchGroup) rayGroups;
+    frDynArray(int) rayCandidates;
+    frDynArray(frIslandNode) islands;
+    frDynArray(unsigned long long) colorMasks;
+    frDynArray(int) colorIndices;
+    frDynArray(float) impulseScalars;
+    int colorOffsets[FR_SOLVER_MAX_COLOR_COUNT + 2];
+    int batchOffsets[FR_SOLVER_MAX_COLOR_COUNT + 1];
+    frContactSolver *solver;
+    frSolverType solverType;
+    int iterationCount, substepCount;
+    float baumgarteFactor, baumgarteSlop;
+    float convergenceThreshold;
+    frThreadPool *pool;
+    float accumulator, timestamp, dt;
+    unsigned int stepCount;
     frCollisionHandler handler;
     frVector2 gravity;
+    frWorldStats stats;
+    bool speculative, staticDirty, locked;
 };
 
+/*
+    A structure that represents the context data 
+    for `frRaycastQueryCallback()`.
+*/
+typedef struct frRaycastQueryCtx_ {
+    frRaycastType type;
+    frRaycastQueryFunc func;
+    frRaycastHit raycastHit;
+    frWorld *world;
+    frRay ray;
+    void *ctx;
+    bool hit;
+} frRaycastQueryCtx;
+
 /* 
     A structure that represents the context data 
-    for `frPreStepHashQueryCallback()`. 
+    for `frRaycastBatchTaskCallback()`.
 */
-typedef struct frPreStepHashQueryCtx_ {
+typedef struct frRaycastBatchCtx_ {
     frWorld *world;
-    int bodyIndex;
-} frPreStepHashQueryCtx;
+    const frRay *rays;
+    frRaycastHit *raycastHits;
+} frRaycastBatchCtx;
 
-/*
+/* 
     A structure that represents the context data 
-    for `frRaycastHashQueryCallback()`.
+    for `frSolverTaskCallback()`.
 */
-typedef struct frRaycastHashQueryCtx_ {
-    frRaycastQueryFunc func;
+typedef struct frSolverTaskCtx_ {
     frWorld *world;
-    frRay ray;
-    void *ctx;
-} frRaycastHashQueryCtx;
+    const int *indices;
+    float inverseDt;
+    int offset;
+} frSolverTaskCtx;
 
 /* Private Function Prototypes ============================================> */
 
 /* 
-    A callback function for `frQuerySpatialHash()` 
+    Queues an operation to be performed on `w` after the current step,
+    growing the operation queue of `w` if it is full.
+*/
+static bool frPushWorldOperation(frWorld *w, frContextNode node);
+
+/* 
+    A callback function for `frQuerySpatialHashPairs()`, 
+    `frQueryDynamicTreePairs()` and `frQuerySweepAndPrunePairs()` 
     that will be called during `frPreStepWorld()`. 
 */
-static bool frPreStepHashQueryCallback(frContextNode ctx);
+static void frPreStepPairQueryCallback(int first, int second, void *ctx);
+
+/* 
+    A callback function for `frRunThreadPool()` that will be called 
+    during `frPreStepWorld()`, which computes the collision of each pair 
+    in the given range of the contact cache.
+*/
+static void frPreStepNarrowPhaseCallback(int threadIndex,
+                                         int begin,
+                                         int end,
+                                         void *ctx);
+
+/* 
+    A callback function for `frRaycastSpatialHash()`, `frRaycastDynamicTree()`
+    and `frRaycastSweepAndPrune()` that will be called 
+    during `frCastRayInWorld()`.
+*/
+static float frRaycastQueryCallback(frContextNode ctxNode, float maxDistance);
+
+/* 
+    A callback function for `frQuerySpatialHash()`, `frQueryDynamicTree()`
+    and `frQuerySweepAndPrune()` that will be called for 
+    each body in the AABB of a group of rays.
+*/
+static bool frRaycastBatchQueryCallback(frContextNode ctxNode);
+
+/* 
+    A comparison function for `qsort()`, which sorts the rays 
+    in `frComputeWorldRaycastBatch()` by the cells they start in.
+*/
+static int frCompareRaycastBatchEntries(const void *x, const void *y);
+
+/* 
+    A callback function for `frQuerySpatialHash()`, `frQueryDynamicTree()`
+    and `frQuerySweepAndPrune()` that will be called for 
+    each body in the swept AABB of a 'bullet' body.
+*/
+static bool frBulletQueryCallback(frContextNode ctxNode);
+
+/* 
+    Adds a pair of bodies with the given indices to the contact cache of `w`,
+    if the pair is not already in the contact cache.
+*/
+static void frAddPairToWorld(frWorld *w, int firstIndex, int secondIndex);
+
+/* 
+    Removes all pairs that contain a body which is no longer in `w` 
+    from the contact cache of `w`, then updates the body indices 
+    of the remaining pairs.
+*/
+static void frRemoveStalePairsFromWorld(frWorld *w);
+
+/* Updates the broad-phase data of each body in `w`. */
+static void frUpdateWorldBroadPhase(frWorld *w);
+
+/* 
+    Assigns a color to each pair of bodies in `w` that must be solved, 
+    so that no two pairs of the same color share a dynamic body.
+*/
+static void frColorWorldPairs(frWorld *w);
+
+/* 
+    Calls `func` for the pairs of each color in `w`, one color at a time, 
+    with the given `inverseDt`, then returns the largest change 
+    in the accumulated impulses reported by `func`.
+*/
+static float frSolveWorldPairs(frWorld *w,
+                               frThreadTaskFunc func,
+                               float inverseDt);
+
+/* 
+    Moves the pairs of each color in `w` (except the last one) 
+    to the contact solver of `w`, with the given `inverseDt`.
+*/
+static void frBatchWorldPairs(frWorld *w, float inverseDt);
+
+/* 
+    Resolves the contact batches of each color in `w`, one color 
+    at a time, then solves the pairs of the last color and returns
+    the largest change in the accumulated impulses.
+*/
+static float frSolveWorldBatches(frWorld *w, float inverseDt);
+
+/* 
+    A callback function for `frRunThreadPool()` that will be called 
+    during `frSolveWorldPairs()`, which applies the accumulated impulses
+    of each pair in the given range.
+*/
+static void frWarmStartTaskCallback(int threadIndex,
+                                    int begin,
+                                    int end,
+                                    void *ctx);
+
+/* 
+    A callback function for `frRunThreadPool()` that will be called 
+    during `frSolveWorldBatches()`, which resolves the contact batches
+    in the given range.
+*/
+static void frBatchTaskCallback(int threadIndex,
+                                int begin,
+                                int end,
+                                void *ctx);
+
+/* 
+    Resets the largest change in the accumulated impulses 
+    reported by each thread of `w`.
+*/
+static void frResetWorldImpulseScalars(frWorld *w);
+
+/* 
+    Returns the largest change in the accumulated impulses 
+    reported by all threads of `w`.
+*/
+static float frGetWorldImpulseScalar(const frWorld *w);
+
+/* 
+    A callback function for `frRunThreadPool()` that will be called 
+    during `frSolveWorldPairs()`, which resolves the collision 
+    of each pair in the given range.
+*/
+static void frSolverTaskCallback(int threadIndex,
+                                 int begin,
+                                 int end,
+                                 void *ctx);
+
+/* Casts a ray against all objects in `w`, as described in `queryCtx`. */
+static void frCastRayInWorld(frWorld *w, frRaycastQueryCtx *queryCtx);
+
+/* Returns the bounds of all bodies in the broad-phase data of `w`. */
+static frAABB frGetWorldBounds(const frWorld *w);
+
+/* 
+    Groups the `count` rays in `rays` by the cells of `w` they start in, 
+    then finds the bodies that any ray of each group might hit.
+*/
+static void frGroupWorldRays(frWorld *w, const frRay *rays, int count);
+
+/* 
+    A callback function for `frRunThreadPool()` that will be called 
+    during `frComputeWorldRaycastBatch()`, which casts each ray 
+    in the given range of the grouped rays.
+*/
+static void frRaycastBatchTaskCallback(int threadIndex,
+                                       int begin,
+                                       int end,
+                                       void *ctx);
+
+/* 
+    Finds the earliest time of impact of each 'bullet' body in `w`
+    with a static or kinematic body over `dt`.
+*/
+static void frComputeWorldBullets(frWorld *w, float dt);
+
+/* 
+    Moves each 'bullet' body in `w` that hit a static or kinematic body
+    back to its time of impact.
+*/
+static void frRewindWorldBullets(frWorld *w, float dt);
+
+/* 
+    Integrates the velocities of the bodies in `w`, resolves the collision 
+    of each pair with the iteration count of `w`, 
+    then integrates the positions of the bodies in `w` over `dt`.
+*/
+static void frIterateWorld(frWorld *w, float dt);
+
+/* 
+    Splits `dt` into the sub-steps of `w`, each of which integrates 
+    the velocities of the bodies in `w`, resolves the collision of each pair 
+    as a soft constraint, integrates the positions of the bodies in `w`
+    and then relaxes the contacts, with the contacts found at the start 
+    of the step.
+*/
+static void frSubstepWorld(frWorld *w, float dt);
+
+/* 
+    Returns the index of the node that represents the island 
+    containing the body at the given `i`ndex in `w`.
+*/
+static int frFindWorldIsland(frWorld *w, int i);
+
+/* 
+    Groups the dynamic bodies in `w` that are touching each other 
+    into islands, then wakes up each island that has an awake body.
+*/
+static void frBuildWorldIslands(frWorld *w);
+
+/* 
+    Updates the sleep timer of each body in `w`, then puts each island 
+    whose bodies have been resting for long enough to sleep.
+*/
+static void frSleepWorldIslands(frWorld *w, float dt);
+
+/* Checks if the solver can skip the given pair of bodies. */
+static FR_API_INLINE bool frIsPairSleeping(frBodyPair key);
+
+/* Checks if neither body of the pair with the given `key` can move. */
+static FR_API_INLINE bool frIsPairResting(frBodyPair key);
+
+/* Checks if `b` is a kinematic body that is moving. */
+static FR_API_INLINE bool frIsKinematicBodyMoving(const frBody *b);
+
+/* 
+    Returns how far apart two bodies moving with the relative `velocity` 
+    can be for their contacts to be found in the next step of `w`.
+*/
+static FR_API_INLINE float frGetSpeculativeMargin(const frWorld *w,
+                                                  frVector2 velocity);
 
 /* 
-    A callback function for `frQuerySpatialHash()` 
-    that will be called during `frComputeRaycastForWorld()`.
+    Returns the AABB of `b` in `w`, which also covers the motion of `b`
+    in the next step if `w` uses speculative contacts.
 */
-static bool frRaycastHashQueryCallback(frContextNode ctx);
+static frAABB frGetWorldBodyAABB(const frWorld *w, const frBody *b);
 
 /* Finds all pairs of bodies in `w` that are colliding. */
 static void frPreStepWorld(frWorld *w);
 
+/* 
+    Moves the data of the given `b`ody into `w`, 
+    then returns `true` if `b` has been added to `w`.
+*/
+static bool frInsertBodyIntoWorld(frWorld *w, frBody *b);
+
+/* Applies all pending operations (e.g. adding a body) on `w`. */
+static void frApplyWorldOperations(frWorld *w);
+
 /* 
     Clears the accumulated forces on each body in `w`, 
-    then clears the spatial hash of `w`. 
+    then updates the broad-phase data of `w`. 
 */
 static void frPostStepWorld(frWorld *w);
 
@@ -105,14 +457,38 @@ static void frPostStepWorld(frWorld *w);
     for broad-phase collision detection.
 */
 frWorld *frCreateWorld(frVector2 gravity, float cellSize) {
+    return frCreateWorldWithCapacity(gravity, 
+                                     cellSize, 
+                                     FR_WORLD_DEFAULT_CAPACITY);
+}
+
+/* 
+    Creates a world with the `gravity` vector and `cellSize` 
+    for broad-phase collision detection, which reserves memory
+    for at least `capacity` rigid bodies.
+*/
+frWorld *frCreateWorldWithCapacity(frVector2 gravity, 
+                                   float cellSize, 
+                                   int capacity) {
     frWorld *result = calloc(1, sizeof *result);
 
     result->gravity = gravity;
+
+    result->broadPhaseType = FR_BROAD_PHASE_SPATIAL_HASH;
     result->hash = frCreateSpatialHash(cellSize);
 
-    frSetDynArrayCapacity(result->bodies, FR_WORLD_MAX_OBJECT_COUNT);
+    result->solverType = FR_SOLVER_SEQUENTIAL;
+    result->iterationCount = FR_WORLD_ITERATION_COUNT;
+    result->substepCount = FR_WORLD_SUBSTEP_COUNT;
 
-    frInitRingBuffer(result->rbf, FR_WORLD_MAX_OBJECT_COUNT);
+    result->baumgarteFactor = FR_WORLD_BAUMGARTE_FACTOR;
+    result->baumgarteSlop = FR_WORLD_BAUMGARTE_SLOP;
+
+    result->storage = frCreateBodyStorage();
+
+    frInitRingBuffer(result->rbf, FR_WORLD_DEFAULT_CAPACITY);
+
+    frReserveWorld(result, capacity);
 
     return result;
 }
@@ -124,11 +500,33 @@ void frReleaseWorld(frWorld *w) {
     for (int i = 0; i < frGetDynArrayLength(w->bodies); i++)
         frReleaseBody(frGetDynArrayValue(w->bodies, i));
 
+    frReleaseBodyStorage(w->storage);
+
     frReleaseSpatialHash(w->hash);
+    frReleaseDynamicTree(w->tree);
+    frReleaseSweepAndPrune(w->sap);
 
     frReleaseDynArray(w->bodies);
+    frReleaseDynArray(w->proxyIds);
+    frReleaseDynArray(w->newAABBs);
+    frReleaseDynArray(w->newIndices);
+    frReleaseDynArray(w->newProxyIds);
+    frReleaseDynArray(w->bullets);
     frReleaseRingBuffer(w->rbf);
 
+    frReleaseDynArray(w->rayEntries);
+    frReleaseDynArray(w->rayGroups);
+    frReleaseDynArray(w->rayCandidates);
+
+    frReleaseDynArray(w->islands);
+    frReleaseDynArray(w->colorMasks);
+    frReleaseDynArray(w->colorIndices);
+    frReleaseDynArray(w->impulseScalars);
+
+    frReleaseThreadPool(w->pool);
+
+    frReleaseContactSolver(w->solver);
+
     hmfree(w->cache);
 
     free(w);
@@ -139,38 +537,114 @@ void frClearWorld(frWorld *w) {
     if (w == NULL) return;
 
     frClearSpatialHash(w->hash);
+    frClearDynamicTree(w->tree);
+    frClearSweepAndPrune(w->sap);
+
+    for (int i = 0; i < frGetDynArrayLength(w->bodies); i++)
+        frSetBodySleepFlag(frGetDynArrayValue(w->bodies, i), NULL);
+
+    frClearBodyStorage(w->storage);
 
     frSetDynArrayLength(w->bodies, 0);
+    frSetDynArrayLength(w->proxyIds, 0);
+
+    hmfree(w->cache);
+}
+
+/* Reserves memory for at least `capacity` rigid bodies in `w`. */
+void frReserveWorld(frWorld *w, int capacity) {
+    if (w == NULL || capacity <= 0) return;
+
+    frReserveDynArray(w->bodies, capacity);
+    frReserveDynArray(w->proxyIds, capacity);
+
+    frReserveBodyStorage(w->storage, capacity);
+
+    // NOTE: One slot of the ring buffer is always left empty
+    while (w->rbf.length <= (size_t) capacity) {
+        size_t oldLength = w->rbf.length;
+
+        frGrowRingBuffer(w->rbf);
+
+        if (w->rbf.length == oldLength) break;
+    }
 }
 
 /* Adds a rigid `b`ody to `w`. */
 bool frAddBodyToWorld(frWorld *w, frBody *b) {
-    if (w == NULL || b == NULL
-        || frGetDynArrayLength(w->bodies) >= FR_WORLD_MAX_OBJECT_COUNT)
-        return false;
+    if (w == NULL || b == NULL) return false;
+
+    return frPushWorldOperation(w,
+                                ((frContextNode) { .id = FR_OPT_ADD_BODY,
+                                                   .ctx = b }));
+}
+
+/* 
+    Adds `count` rigid `bodies` to `w`, then returns 
+    the number of bodies that have been (or will be) added.
+*/
+int frAddBodiesToWorld(frWorld *w, frBody **bodies, int count) {
+    if (w == NULL || bodies == NULL || count <= 0) return 0;
+
+    /*
+        NOTE: Reserving memory for all bodies at once means that
+        no array of `w` has to be resized while they are being added.
+    */
+    frReserveWorld(w, frGetDynArrayLength(w->bodies) + count);
+
+    int result = 0;
+
+    // NOTE: The bodies of `w` cannot change in the middle of a step
+    if (w->locked) {
+        for (int i = 0; i < count; i++)
+            if (frAddBodyToWorld(w, bodies[i])) result++;
+
+        return result;
+    }
 
-    return frAddToRingBuffer(w->rbf,
-                             ((frContextNode) { .id = FR_OPT_ADD_BODY,
-                                                .ctx = b }));
+    // NOTE: The pending operations on `w` must be applied first, in order
+    frApplyWorldOperations(w);
+
+    for (int i = 0; i < count; i++)
+        if (frInsertBodyIntoWorld(w, bodies[i])) result++;
+
+    /*
+        NOTE: All new bodies are handed to the broad phase at once,
+        so a dynamic AABB tree can be built top-down and 
+        a sweep-and-prune structure only has to be sorted once.
+    */
+    frUpdateWorldBroadPhase(w);
+
+    return result;
 }
 
 /* Removes a rigid `b`ody from `w`. */
 bool frRemoveBodyFromWorld(frWorld *w, frBody *b) {
     if (w == NULL || b == NULL) return false;
 
-    return frAddToRingBuffer(w->rbf,
-                             ((frContextNode) { .id = FR_OPT_REMOVE_BODY,
-                                                .ctx = b }));
+    return frPushWorldOperation(w,
+                                ((frContextNode) { .id = FR_OPT_REMOVE_BODY,
+                                                   .ctx = b }));
 }
 
-/* Checks if the given `b`ody is in `w`. */
-bool frIsBodyInWorld(const frWorld *w, frBody *b) {
-    if (w == NULL || b == NULL) return false;
+/* 
+    Removes `count` rigid `bodies` from `w`, then returns 
+    the number of bodies that will be removed.
+*/
+int frRemoveBodiesFromWorld(frWorld *w, frBody **bodies, int count) {
+    if (w == NULL || bodies == NULL) return 0;
 
-    for (int i = 0; i < frGetDynArrayLength(w->bodies); i++)
-        if (frGetDynArrayValue(w->bodies, i) == b) return true;
+    int result = 0;
+
+    for (int i = 0; i < count; i++)
+        if (frRemoveBodyFromWorld(w, bodies[i])) result++;
+
+    return result;
+}
 
-    return false;
+/* Checks if the given `b`ody is in `w`. */
+bool frIsBodyInWorld(const frWorld *w, frBody *b) {
+    return (w != NULL && b != NULL) && frGetBodyStorage(b) == w->storage;
 }
 
 /* Returns a rigid body at the given `i`ndex in `w`. */
@@ -185,301 +659,1967 @@ int frGetBodyCountInWorld(const frWorld *w) {
     return (w != NULL) ? frGetDynArrayLength(w->bodies) : 0;
 }
 
+/* Returns the 'bias factor' of `w` for the Baumgarte stabilization scheme. */
+float frGetWorldBaumgarteFactor(const frWorld *w) {
+    return (w != NULL) ? w->baumgarteFactor : 0.0f;
+}
+
+/* Returns the 'slop' of `w` for the Baumgarte stabilization scheme. */
+float frGetWorldBaumgarteSlop(const frWorld *w) {
+    return (w != NULL) ? w->baumgarteSlop : 0.0f;
+}
+
+/* Returns the broad-phase algorithm type of `w`. */
+frBroadPhaseType frGetWorldBroadPhaseType(const frWorld *w) {
+    return (w != NULL) ? w->broadPhaseType : FR_BROAD_PHASE_UNKNOWN;
+}
+
+/* 
+    Returns the largest change in the accumulated impulses 
+    below which the constraint solver of `w` stops iterating.
+*/
+float frGetWorldConvergenceThreshold(const frWorld *w) {
+    return (w != NULL) ? w->convergenceThreshold : 0.0f;
+}
+
 /* Returns the gravity acceleration vector of `w`. */
 frVector2 frGetWorldGravity(const frWorld *w) {
     return (w != NULL) ? w->gravity : frStructZero(frVector2);
 }
 
-/* Sets the collision event `handler` of `w`. */
-void frSetWorldCollisionHandler(frWorld *w, frCollisionHandler handler) {
-    if (w != NULL) w->handler = handler;
+/* Returns the iteration count of `w` for the constraint solver. */
+int frGetWorldIterationCount(const frWorld *w) {
+    return (w != NULL) ? w->iterationCount : 0;
 }
 
-/* Sets the `gravity` acceleration vector of `w`. */
-void frSetWorldGravity(frWorld *w, frVector2 gravity) {
-    if (w != NULL) w->gravity = gravity;
+/* Returns the constraint solver type of `w`. */
+frSolverType frGetWorldSolverType(const frWorld *w) {
+    return (w != NULL) ? w->solverType : FR_SOLVER_UNKNOWN;
 }
 
-/* Proceeds the simulation over the time step `dt`, in seconds. */
-void frStepWorld(frWorld *w, float dt) {
-    if (w == NULL || dt <= 0.0f) return;
+/* Checks if `w` uses speculative contacts. */
+bool frGetWorldSpeculativeContacts(const frWorld *w) {
+    return (w != NULL) ? w->speculative : false;
+}
 
-    frPreStepWorld(w);
+/* Returns the number of sub-steps of `w` for the 'soft step' solver. */
+int frGetWorldSubstepCount(const frWorld *w) {
+    return (w != NULL) ? w->substepCount : 0;
+}
 
-    for (int j = 0; j < hmlen(w->cache); j++) {
-        frCollision *collision = &w->cache[j].value;
+/* 
+    Returns the profiling data of `w` for the last step.
 
-        if (w->handler.preStep != NULL && collision->count > 0)
-            w->handler.preStep(w->cache[j].key, collision);
-    }
+    NOTE: All values will be zero unless the library has been built
+    with `FR_WORLD_ENABLE_PROFILING` set to a nonzero value.
+*/
+frWorldStats frGetWorldStats(const frWorld *w) {
+    return (w != NULL) ? w->stats : frStructZero(frWorldStats);
+}
 
-    for (int i = 0; i < frGetDynArrayLength(w->bodies); i++) {
-        frApplyGravityToBody(frGetDynArrayValue(w->bodies, i), w->gravity);
+/* Returns the number of threads used by `w` on each step. */
+int frGetWorldThreadCount(const frWorld *w) {
+    return (w != NULL) ? frGetThreadPoolSize(w->pool) : 0;
+}
 
-        frIntegrateForBodyVelocity(frGetDynArrayValue(w->bodies, i), dt);
-    }
+/* 
+    Sets the 'bias factor' of `w` for the Baumgarte stabilization scheme,
+    which must be in the range `[0, 1]`.
+*/
+void frSetWorldBaumgarteFactor(frWorld *w, float baumgarteFactor) {
+    if (w == NULL || baumgarteFactor < 0.0f || baumgarteFactor > 1.0f)
+        return;
 
-    int entryCount = hmlen(w->cache);
+    w->baumgarteFactor = baumgarteFactor;
+}
 
-    for (int j = 0; j < entryCount; j++) {
-        frBodyPair key = w->cache[j].key;
+/* Sets the 'slop' of `w` for the Baumgarte stabilization scheme. */
+void frSetWorldBaumgarteSlop(frWorld *w, float baumgarteSlop) {
+    if (w == NULL || baumgarteSlop < 0.0f) return;
 
-        const frCollision *value = &w->cache[j].value;
+    w->baumgarteSlop = baumgarteSlop;
+}
 
-        for (int k = 0; k < value->count; k++)
-            if (w->timestamp - value->contacts[k].timestamp > dt) {
-                hmdel(w->cache, key);
+/* Sets the broad-phase algorithm `type` of `w`. */
+void frSetWorldBroadPhaseType(frWorld *w, frBroadPhaseType type) {
+    if (w == NULL || w->broadPhaseType == type
+        || type < FR_BROAD_PHASE_SPATIAL_HASH
+        || type > FR_BROAD_PHASE_SWEEP_AND_PRUNE)
+        return;
 
-                break;
-            }
-    }
+    if (type == FR_BROAD_PHASE_DYNAMIC_TREE && w->tree == NULL)
+        w->tree = frCreateDynamicTree(FR_BROAD_PHASE_AABB_MARGIN);
 
-    for (int j = 0; j < hmlen(w->cache); j++)
-        frApplyAccumulatedImpulses(w->cache[j].key.first,
-                                   w->cache[j].key.second,
-                                   &w->cache[j].value);
+    if (type == FR_BROAD_PHASE_SWEEP_AND_PRUNE && w->sap == NULL)
+        w->sap = frCreateSweepAndPrune();
 
-    float inverseDt = 1.0f / dt;
+    frClearSpatialHash(w->hash);
+    frClearDynamicTree(w->tree);
+    frClearSweepAndPrune(w->sap);
 
-    for (int i = 0; i < FR_WORLD_ITERATION_COUNT; i++)
-        for (int j = 0; j < hmlen(w->cache); j++)
-            frResolveCollision(w->cache[j].key.first,
-                               w->cache[j].key.second,
-                               &w->cache[j].value,
-                               inverseDt);
+    for (int i = 0; i < frGetDynArrayLength(w->proxyIds); i++)
+        frGetDynArrayValue(w->proxyIds, i) = -1;
 
-    for (int i = 0; i < frGetDynArrayLength(w->bodies); i++)
-        frIntegrateForBodyPosition(frGetDynArrayValue(w->bodies, i), dt);
+    w->staticDirty = true;
 
-    for (int j = 0; j < hmlen(w->cache); j++) {
-        frCollision *collision = &w->cache[j].value;
+    /*
+        NOTE: The contact cache must be cleared, since each backend
+        has its own way of discarding the pairs that no longer overlap.
+    */
+    hmfree(w->cache);
 
-        if (w->handler.postStep != NULL && collision->count > 0)
-            w->handler.postStep(w->cache[j].key, collision);
-    }
+    w->broadPhaseType = type;
 
-    frPostStepWorld(w);
+    frUpdateWorldBroadPhase(w);
+}
+
+/* Sets the collision event `handler` of `w`. */
+void frSetWorldCollisionHandler(frWorld *w, frCollisionHandler handler) {
+    if (w != NULL) w->handler = handler;
 }
 
 /* 
-    Proceeds the simulation over the time step `dt`, in seconds,
-    which will always run independent of the framerate.
+    Sets the largest change in the accumulated impulses 
+    below which the constraint solver of `w` stops iterating.
+
+    NOTE: The constraint solver of `w` always runs all iterations 
+    if `threshold` is zero (which is the default value), and 
+    `FR_SOLVER_SOFT_STEP` does not iterate on each sub-step.
 */
-void frUpdateWorld(frWorld *w, float dt) {
-    if (w == NULL || dt <= 0.0f) return;
+void frSetWorldConvergenceThreshold(frWorld *w, float threshold) {
+    if (w == NULL || threshold < 0.0f) return;
 
-    float currentTime = frGetCurrentTime();
+    w->convergenceThreshold = threshold;
+}
 
-    if (w->timestamp <= 0.0f) {
-        w->timestamp = currentTime;
+/* Sets the `gravity` acceleration vector of `w`. */
+void frSetWorldGravity(frWorld *w, frVector2 gravity) {
+    if (w != NULL) w->gravity = gravity;
+}
 
-        return;
-    }
+/* Sets the iteration count of `w` for the constraint solver. */
+void frSetWorldIterationCount(frWorld *w, int iterationCount) {
+    if (w == NULL || iterationCount <= 0) return;
 
-    float elapsedTime = currentTime - w->timestamp;
+    w->iterationCount = iterationCount;
+}
 
-    w->timestamp = currentTime, w->accumulator += elapsedTime;
+/* 
+    Sets the constraint solver `type` of `w`.
+
+    NOTE: `FR_SOLVER_GRAPH_COLORING` solves the pairs that do not share 
+    any dynamic body in parallel, so it will only be faster than 
+    `FR_SOLVER_SEQUENTIAL` if `w` uses more than one thread. 
+    `FR_SOLVER_WIDE` also solves 4 or 8 of those pairs at once 
+    with SIMD instructions on each thread. `FR_SOLVER_SOFT_STEP` splits 
+    each step into sub-steps with soft contact constraints instead of 
+    solving the contacts over and over, which keeps tall stacks stable 
+    without a higher iteration count.
+*/
+void frSetWorldSolverType(frWorld *w, frSolverType type) {
+    if (w == NULL || type < FR_SOLVER_SEQUENTIAL || type > FR_SOLVER_SOFT_STEP)
+        return;
 
-    for (; w->accumulator >= dt; w->accumulator -= dt)
-        frStepWorld(w, dt);
+    if (type == FR_SOLVER_WIDE && w->solver == NULL)
+        w->solver = frCreateContactSolver();
+
+    w->solverType = type;
 }
 
 /* 
-    Casts a `ray` against all objects in `w`, 
-    then calls `func` for each object that collides with `ray`. 
+    Enables or disables speculative contacts for `w`.
+
+    NOTE: Two bodies that are about to collide in the next step 
+    will have contacts with a negative depth (and the collision event
+    handlers will be called for them), so that larger time steps 
+    can be used without tunneling.
 */
-void frComputeWorldRaycast(frWorld *w,
-                           frRay ray,
+void frSetWorldSpeculativeContacts(frWorld *w, bool enabled) {
+    if (w != NULL) w->speculative = enabled;
+}
+
+/* 
+    Sets the number of sub-steps of `w` for the 'soft step' solver.
+
+    NOTE: The contacts are found only once in a step, and then moved 
+    along with their bodies on each sub-step.
+*/
+void frSetWorldSubstepCount(frWorld *w, int substepCount) {
+    if (w == NULL || substepCount <= 0) return;
+
+    w->substepCount = substepCount;
+}
+
+/* 
+    Sets the number of threads used by `w` on each step, 
+    including the calling thread.
+
+    NOTE: The results of each step do not depend on `threadCount`.
+*/
+void frSetWorldThreadCount(frWorld *w, int threadCount) {
+    if (w == NULL || frGetThreadPoolSize(w->pool) == threadCount) return;
+
+    frReleaseThreadPool(w->pool);
+
+    w->pool = (threadCount > 1) ? frCreateThreadPool(threadCount) : NULL;
+}
+
+/* Proceeds the simulation over the time step `dt`, in seconds. */
+void frStepWorld(frWorld *w, float dt) {
+    if (w == NULL || dt <= 0.0f) return;
+
+    w->locked = true;
+
+    frResetWorldStats(w);
+
+    frBeginWorldTimer(stepTimer);
+
+    w->dt = dt;
+
+    frPreStepWorld(w);
+
+    {
+        frBeginWorldTimer(callbackTimer);
+
+        for (int j = 0; j < hmlen(w->cache); j++) {
+            frCollision *collision = &w->cache[j].value;
+
+            if (w->handler.preStep != NULL && collision->count > 0)
+                w->handler.preStep(w->cache[j].key, collision);
+        }
+
+        frEndWorldTimer(w, callbackTimer, callbackTime);
+    }
+
+    if (w->solverType == FR_SOLVER_SOFT_STEP)
+        frSubstepWorld(w, dt);
+    else
+        frIterateWorld(w, dt);
+
+    {
+        frBeginWorldTimer(callbackTimer);
+
+        for (int j = 0; j < hmlen(w->cache); j++) {
+            frCollision *collision = &w->cache[j].value;
+
+            if (w->handler.postStep != NULL && collision->count > 0)
+                w->handler.postStep(w->cache[j].key, collision);
+        }
+
+        frEndWorldTimer(w, callbackTimer, callbackTime);
+    }
+
+    frSleepWorldIslands(w, dt);
+
+    w->locked = false;
+
+    frPostStepWorld(w);
+
+    frEndWorldTimer(w, stepTimer, stepTime);
+}
+
+/* 
+    Proceeds the simulation over the time step `dt`, in seconds,
+    which will always run independent of the framerate.
+*/
+void frUpdateWorld(frWorld *w, float dt) {
+    if (w == NULL || dt <= 0.0f) return;
+
+    float currentTime = frGetCurrentTime();
+
+    if (w->timestamp <= 0.0f) {
+        w->timestamp = currentTime;
+
+        return;
+    }
+
+    float elapsedTime = currentTime - w->timestamp;
+
+    w->timestamp = currentTime, w->accumulator += elapsedTime;
+
+    for (; w->accumulator >= dt; w->accumulator -= dt)
+        frStepWorld(w, dt);
+}
+
+/* 
+    Casts a `ray` against all objects in `w`, 
+    then calls `func` for each object that collides with `ray`. 
+
+    NOTE: The broad-phase data of `w` will only be updated 
+    at the end of each step, so the objects that have been moved 
+    since the last step might not be found.
+*/
+void frComputeWorldRaycast(frWorld *w,
+                           frRay ray,
                            frRaycastQueryFunc func,
                            void *userData) {
     if (w == NULL || func == NULL) return;
 
-    frClearSpatialHash(w->hash);
+    frCastRayInWorld(w,
+                     &(frRaycastQueryCtx) { .type = FR_RAYCAST_ALL,
+                                            .func = func,
+                                            .ray = ray,
+                                            .ctx = userData });
+}
+
+/* 
+    Casts a `ray` against all objects in `w`, then stores 
+    the information of the closest hit to `raycastHit`.
+*/
+bool frComputeWorldRaycastClosest(frWorld *w,
+                                  frRay ray,
+                                  frRaycastHit *raycastHit) {
+    if (w == NULL) return false;
+
+    frRaycastQueryCtx queryCtx = { .type = FR_RAYCAST_CLOSEST, .ray = ray };
+
+    frCastRayInWorld(w, &queryCtx);
+
+    if (queryCtx.hit && raycastHit != NULL)
+        *raycastHit = queryCtx.raycastHit;
+
+    return queryCtx.hit;
+}
+
+/* 
+    Casts a `ray` against all objects in `w`, then stores 
+    the information of the first hit found to `raycastHit`, 
+    which might not be the closest one.
+*/
+bool frComputeWorldRaycastAny(frWorld *w, frRay ray, frRaycastHit *raycastHit) {
+    if (w == NULL) return false;
+
+    frRaycastQueryCtx queryCtx = { .type = FR_RAYCAST_ANY, .ray = ray };
+
+    frCastRayInWorld(w, &queryCtx);
+
+    if (queryCtx.hit && raycastHit != NULL)
+        *raycastHit = queryCtx.raycastHit;
+
+    return queryCtx.hit;
+}
+
+/* 
+    Casts each of the `count` rays in `rays` against all objects in `w`, 
+    then stores the information of the closest hit of each ray 
+    to `raycastHits`, and returns the number of rays that hit an object.
+
+    NOTE: A ray that does not hit any object will have its hit information 
+    zeroed out. Since this function never modifies `w`, the rays 
+    can be split into several ranges and cast from multiple threads, 
+    as long as `w` is not being updated at the same time.
+*/
+int frComputeWorldRaycastBatch(frWorld *w,
+                               const frRay *rays,
+                               frRaycastHit *raycastHits,
+                               int count) {
+    if (w == NULL || rays == NULL || raycastHits == NULL || count <= 0)
+        return 0;
+
+    for (int i = 0; i < count; i++)
+        raycastHits[i] = (frRaycastHit) { .body = NULL };
+
+    frGroupWorldRays(w, rays, count);
+
+    frRaycastBatchCtx batchCtx = { .world = w,
+                                   .rays = rays,
+                                   .raycastHits = raycastHits };
+
+    // NOTE: Each ray only writes to its own hit information
+    frRunThreadPool(w->pool,
+                    frGetDynArrayLength(w->rayEntries),
+                    frRaycastBatchTaskCallback,
+                    &batchCtx);
+
+    int result = 0;
+
+    for (int i = 0; i < count; i++)
+        if (raycastHits[i].body != NULL) result++;
+
+    return result;
+}
+
+/* Private Functions ======================================================> */
+
+/* 
+    Queues an operation to be performed on `w` after the current step,
+    growing the operation queue of `w` if it is full.
+*/
+static bool frPushWorldOperation(frWorld *w, frContextNode node) {
+    if (frIsRingBufferFull(w->rbf)) frGrowRingBuffer(w->rbf);
+
+    return frAddToRingBuffer(w->rbf, node);
+}
+
+/* 
+    A callback function for `frQuerySpatialHashPairs()`, 
+    `frQueryDynamicTreePairs()` and `frQuerySweepAndPrunePairs()` 
+    that will be called during `frPreStepWorld()`. 
+*/
+static void frPreStepPairQueryCallback(int first, int second, void *ctx) {
+    frAddWorldCounter((frWorld *) ctx, candidatePairCount, 1);
+
+    if (first < second)
+        frAddPairToWorld(ctx, first, second);
+    else
+        frAddPairToWorld(ctx, second, first);
+}
+
+/* 
+    A callback function for `frRunThreadPool()` that will be called 
+    during `frPreStepWorld()`, which computes the collision of each pair 
+    in the given range of the contact cache.
+*/
+static void frPreStepNarrowPhaseCallback(int threadIndex,
+                                         int begin,
+                                         int end,
+                                         void *ctx) {
+    frWorld *w = ctx;
+
+    for (int j = begin; j < end; j++) {
+        frContactCacheEntry *entry = &w->cache[j];
+
+        frBody *b1 = entry->key.first, *b2 = entry->key.second;
+
+        // NOTE: Keep the old contacts of a resting pair for warm starting
+        if (frIsPairResting(entry->key)) continue;
+
+        frCollision collision = { .count = 0 };
+
+        /*
+            NOTE: A speculative contact lets the solver stop two bodies 
+            that are about to collide before they pass through each other.
+        */
+        float margin = frGetSpeculativeMargin(
+            w,
+            frVector2Subtract(frGetBodyVelocity(b2), frGetBodyVelocity(b1)));
+
+        (void) frComputeSpeculativeCollision(b1, b2, margin, &collision);
+
+        collision.friction = entry->value.friction;
+        collision.restitution = entry->value.restitution;
+
+        for (int i = 0; i < collision.count; i++) {
+            frContact *newContact = &collision.contacts[i];
+
+            newContact->timestamp = w->timestamp;
+
+            for (int k = 0; k < entry->value.count; k++) {
+                const frContact *oldContact = &entry->value.contacts[k];
+
+                if (newContact->id != oldContact->id) continue;
+
+                newContact->cache.normalScalar = oldContact->cache.normalScalar;
+                newContact->cache.tangentScalar =
+                    oldContact->cache.tangentScalar;
+
+                break;
+            }
+        }
+
+        entry->value = collision;
+    }
+}
+
+/* 
+    A callback function for `frRaycastSpatialHash()`, `frRaycastDynamicTree()`
+    and `frRaycastSweepAndPrune()` that will be called 
+    during `frCastRayInWorld()`.
+*/
+static float frRaycastQueryCallback(frContextNode ctxNode, float maxDistance) {
+    frRaycastQueryCtx *queryCtx = ctxNode.ctx;
+
+    const frBody *body = frGetDynArrayValue(queryCtx->world->bodies,
+                                            ctxNode.id);
+
+    frRay ray = queryCtx->ray;
+
+    ray.maxDistance = maxDistance;
+
+    frRaycastHit raycastHit = { .distance = 0.0f };
+
+    if (!frComputeRaycast(body, ray, &raycastHit)) return maxDistance;
+
+    switch (queryCtx->type) {
+        case FR_RAYCAST_CLOSEST:
+            queryCtx->raycastHit = raycastHit, queryCtx->hit = true;
+
+            // NOTE: Any object farther than this one can be skipped
+            return raycastHit.distance;
+
+        case FR_RAYCAST_ANY:
+            queryCtx->raycastHit = raycastHit, queryCtx->hit = true;
+
+            return 0.0f;
+
+        default:
+            queryCtx->func(raycastHit, queryCtx->ctx);
+
+            return maxDistance;
+    }
+}
+
+/* 
+    A callback function for `frQuerySpatialHash()`, `frQueryDynamicTree()`
+    and `frQuerySweepAndPrune()` that will be called for 
+    each body in the AABB of a group of rays.
+*/
+static bool frRaycastBatchQueryCallback(frContextNode ctxNode) {
+    frWorld *w = ctxNode.ctx;
+
+    frDynArrayPush(w->rayCandidates, ctxNode.id);
+
+    return true;
+}
+
+/* 
+    A comparison function for `qsort()`, which sorts the rays 
+    in `frComputeWorldRaycastBatch()` by the cells they start in.
+*/
+static int frCompareRaycastBatchEntries(const void *x, const void *y) {
+    const frRaycastBatchEntry *e1 = x, *e2 = y;
+
+    if (e1->cellX != e2->cellX) return (e1->cellX < e2->cellX) ? -1 : 1;
+    if (e1->cellY != e2->cellY) return (e1->cellY < e2->cellY) ? -1 : 1;
+
+    return (e1->index > e2->index) - (e1->index < e2->index);
+}
+
+/* 
+    A callback function for `frQuerySpatialHash()`, `frQueryDynamicTree()`
+    and `frQuerySweepAndPrune()` that will be called for 
+    each body in the swept AABB of a 'bullet' body.
+*/
+static bool frBulletQueryCallback(frContextNode ctxNode) {
+    frBulletQueryCtx *queryCtx = ctxNode.ctx;
+
+    const frBody *body = frGetDynArrayValue(queryCtx->world->bodies,
+                                            ctxNode.id);
+
+    // NOTE: Dynamic bodies are left to the discrete collision detection
+    if (frGetBodyType(body) == FR_BODY_DYNAMIC) return true;
+
+    float toi = 1.0f;
+
+    if (frComputeTimeOfImpact(queryCtx->body,
+                              body,
+                              queryCtx->dt,
+                              queryCtx->world->baumgarteSlop,
+                              &toi)
+        && queryCtx->toi > toi)
+        queryCtx->toi = toi, queryCtx->other = body;
+
+    return true;
+}
+
+/* 
+    Adds a pair of bodies with the given indices to the contact cache of `w`,
+    if the pair is not already in the contact cache.
+*/
+static void frAddPairToWorld(frWorld *w, int firstIndex, int secondIndex) {
+    frBody *b1 = frGetDynArrayValue(w->bodies, firstIndex);
+    frBody *b2 = frGetDynArrayValue(w->bodies, secondIndex);
+
+    if (frGetBodyInverseMass(b1) + frGetBodyInverseMass(b2) <= 0.0f) return;
+
+    frBodyPair key = { .first = b1, .second = b2 };
+
+    frContactCacheEntry *entry = hmgetp_null(w->cache, key);
+
+    if (entry != NULL) {
+        entry->stepCount = w->stepCount;
+
+        return;
+    }
+
+    const frShape *s1 = frGetBodyShape(b1), *s2 = frGetBodyShape(b2);
+
+    frCollision collision = { .count = 0 };
+
+    collision.friction = 0.5f
+                         * (frGetShapeFriction(s1) + frGetShapeFriction(s2));
+    collision.restitution = fminf(frGetShapeRestitution(s1),
+                                  frGetShapeRestitution(s2));
+
+    if (collision.friction < 0.0f) collision.friction = 0.0f;
+    if (collision.restitution < 0.0f) collision.restitution = 0.0f;
+
+    frAddWorldCounter(w, cacheInsertCount, 1);
+
+    hmputs(w->cache,
+           ((frContactCacheEntry) {
+               .key = key,
+               .value = collision,
+               .indices = { firstIndex, secondIndex },
+               .proxyIds = { frGetDynArrayValue(w->proxyIds, firstIndex),
+                             frGetDynArrayValue(w->proxyIds, secondIndex) },
+               .stepCount = w->stepCount }));
+}
+
+/* 
+    Removes all pairs that contain a body which is no longer in `w` 
+    from the contact cache of `w`, then updates the body indices 
+    of the remaining pairs.
+*/
+static void frRemoveStalePairsFromWorld(frWorld *w) {
+    // NOTE: `hmdel()` moves the last entry into the deleted one
+    for (int j = hmlen(w->cache) - 1; j >= 0; j--) {
+        frContactCacheEntry *entry = &w->cache[j];
+
+        if (!frIsBodyInWorld(w, entry->key.first)
+            || !frIsBodyInWorld(w, entry->key.second)) {
+            frAddWorldCounter(w, cacheDeleteCount, 1);
+
+            hmdel(w->cache, entry->key);
+
+            continue;
+        }
+
+        entry->indices[0] = frGetBodyStorageIndex(entry->key.first);
+        entry->indices[1] = frGetBodyStorageIndex(entry->key.second);
+    }
+}
+
+/* Updates the broad-phase data of each body in `w`. */
+static void frUpdateWorldBroadPhase(frWorld *w) {
+    /*
+        NOTE: Sleeping bodies never move, so their proxies in a dynamic 
+        AABB tree or a sweep-and-prune structure can be left as they are.
+    */
+    if (w->broadPhaseType == FR_BROAD_PHASE_DYNAMIC_TREE) {
+        frSetDynArrayLength(w->newAABBs, 0);
+        frSetDynArrayLength(w->newIndices, 0);
+
+        for (int i = 0; i < frGetDynArrayLength(w->bodies); i++) {
+            const frBody *b = frGetDynArrayValue(w->bodies, i);
+
+            int proxyId = frGetDynArrayValue(w->proxyIds, i);
+
+            if (proxyId >= 0 && frIsBodySleeping(b)) continue;
+
+            frAABB aabb = frGetWorldBodyAABB(w, b);
+
+            /*
+                NOTE: A body will be re-inserted into the tree
+                only if it moved out of its 'fat' AABB.
+            */
+            if (proxyId >= 0) {
+                (void) frUpdateDynamicTree(w->tree, proxyId, aabb);
+            } else {
+                frDynArrayPush(w->newAABBs, aabb);
+                frDynArrayPush(w->newIndices, i);
+            }
+        }
+
+        int newCount = frGetDynArrayLength(w->newIndices);
+
+        if (newCount > 0) {
+            frReserveDynArray(w->newProxyIds, newCount);
+
+            // NOTE: The tree is built top-down when many bodies are added
+            frInsertManyIntoDynamicTree(w->tree,
+                                        w->newAABBs.buffer,
+                                        w->newIndices.buffer,
+                                        newCount,
+                                        w->newProxyIds.buffer);
+
+            for (int i = 0; i < newCount; i++)
+                frGetDynArrayValue(w->proxyIds,
+                                   frGetDynArrayValue(w->newIndices, i)) =
+                    frGetDynArrayValue(w->newProxyIds, i);
+        }
+    } else if (w->broadPhaseType == FR_BROAD_PHASE_SWEEP_AND_PRUNE) {
+        for (int i = 0; i < frGetDynArrayLength(w->bodies); i++) {
+            const frBody *b = frGetDynArrayValue(w->bodies, i);
+
+            int *proxyId = &frGetDynArrayValue(w->proxyIds, i);
+
+            if (*proxyId >= 0 && frIsBodySleeping(b)) continue;
+
+            frAABB aabb = frGetWorldBodyAABB(w, b);
+
+            if (*proxyId < 0)
+                *proxyId = frInsertIntoSweepAndPrune(w->sap, aabb, i);
+            else
+                frUpdateSweepAndPrune(w->sap, *proxyId, aabb);
+        }
+
+        /*
+            NOTE: Sorting the endpoints here (instead of during the queries)
+            keeps all queries on `w` read-only until the next step.
+        */
+        frSortSweepAndPrune(w->sap);
+    } else {
+        int bodyCount = frGetDynArrayLength(w->bodies);
+
+        /*
+            NOTE: Sleeping bodies are kept in the static layer 
+            of the spatial hash (with a proxy ID of `0`), which is only
+            rebuilt when a body falls asleep, wakes up or is removed.
+        */
+        if (w->staticDirty) {
+            frClearSpatialHash(w->hash);
+
+            for (int i = 0; i < bodyCount; i++) {
+                const frBody *b = frGetDynArrayValue(w->bodies, i);
+
+                int *proxyId = &frGetDynArrayValue(w->proxyIds, i);
+
+                *proxyId = frIsBodySleeping(b) ? 0 : -1;
+
+                if (*proxyId >= 0)
+                    frInsertIntoSpatialHash(w->hash, frGetBodyAABB(b), i);
+            }
+
+            frMarkSpatialHashStatic(w->hash);
+
+            w->staticDirty = false;
+        } else {
+            frClearSpatialHashDynamic(w->hash);
+        }
+
+        for (int i = 0; i < bodyCount; i++) {
+            if (frGetDynArrayValue(w->proxyIds, i) >= 0) continue;
+
+            frInsertIntoSpatialHash(w->hash,
+                                    frGetWorldBodyAABB(
+                                        w,
+                                        frGetDynArrayValue(w->bodies, i)),
+                                    i);
+        }
+
+        frBuildSpatialHash(w->hash);
+    }
+}
+
+/* 
+    Assigns a color to each pair of bodies in `w` that must be solved, 
+    so that no two pairs of the same color share a dynamic body.
+*/
+static void frColorWorldPairs(frWorld *w) {
+    int bodyCount = frGetDynArrayLength(w->bodies);
+
+    if (frGetDynArrayCapacity(w->colorMasks) < bodyCount)
+        frSetDynArrayCapacity(w->colorMasks, bodyCount);
+
+    frSetDynArrayLength(w->colorMasks, bodyCount);
+
+    memset(w->colorMasks.buffer, 0, bodyCount * sizeof *w->colorMasks.buffer);
+
+    int colorCounts[FR_SOLVER_MAX_COLOR_COUNT + 1] = { 0 };
+
+    /*
+        NOTE: Each pair gets the lowest color not yet used by any of its
+        dynamic bodies, and the pairs that run out of colors will be
+        solved on a single thread after all other colors.
+    */
+    for (int j = 0; j < hmlen(w->cache); j++) {
+        frContactCacheEntry *entry = &w->cache[j];
+
+        entry->color = -1;
+
+        if (entry->value.count <= 0 || frIsPairSleeping(entry->key))
+            continue;
+
+        bool dynamic1 = (frGetBodyType(entry->key.first) == FR_BODY_DYNAMIC);
+        bool dynamic2 = (frGetBodyType(entry->key.second) == FR_BODY_DYNAMIC);
+
+        unsigned long long *mask1 = &frGetDynArrayValue(w->colorMasks,
+                                                        entry->indices[0]);
+        unsigned long long *mask2 = &frGetDynArrayValue(w->colorMasks,
+                                                        entry->indices[1]);
+
+        unsigned long long usedColors = (dynamic1 ? *mask1 : 0ull)
+                                        | (dynamic2 ? *mask2 : 0ull);
+
+        int color = 0;
+
+        while (color < FR_SOLVER_MAX_COLOR_COUNT
+               && (usedColors & (1ull << color)))
+            color++;
+
+        if (color < FR_SOLVER_MAX_COLOR_COUNT) {
+            if (dynamic1) *mask1 |= (1ull << color);
+            if (dynamic2) *mask2 |= (1ull << color);
+        }
+
+        entry->color = color, colorCounts[color]++;
+    }
+
+    w->colorOffsets[0] = 0;
+
+    for (int i = 0; i <= FR_SOLVER_MAX_COLOR_COUNT; i++)
+        w->colorOffsets[i + 1] = w->colorOffsets[i] + colorCounts[i];
+
+    int pairCount = w->colorOffsets[FR_SOLVER_MAX_COLOR_COUNT + 1];
+
+    if (frGetDynArrayCapacity(w->colorIndices) < pairCount)
+        frSetDynArrayCapacity(w->colorIndices, pairCount);
+
+    frSetDynArrayLength(w->colorIndices, pairCount);
+
+    // NOTE: The pairs of each color are stored in the order of the cache
+    for (int j = 0; j < hmlen(w->cache); j++) {
+        int color = w->cache[j].color;
+
+        if (color < 0) continue;
+
+        int offset = w->colorOffsets[color + 1] - colorCounts[color]--;
+
+        frGetDynArrayValue(w->colorIndices, offset) = j;
+    }
+}
+
+/* 
+    Calls `func` for the pairs of each color in `w`, one color at a time, 
+    with the given `inverseDt`, then returns the largest change 
+    in the accumulated impulses reported by `func`.
+*/
+static float frSolveWorldPairs(frWorld *w,
+                               frThreadTaskFunc func,
+                               float inverseDt) {
+    frResetWorldImpulseScalars(w);
+
+    for (int i = 0; i <= FR_SOLVER_MAX_COLOR_COUNT; i++) {
+        int offset = w->colorOffsets[i];
+        int count = w->colorOffsets[i + 1] - offset;
+
+        if (count <= 0) continue;
+
+        frSolverTaskCtx taskCtx = {
+            .world = w,
+            .indices = &frGetDynArrayValue(w->colorIndices, offset),
+            .inverseDt = inverseDt
+        };
+
+        /*
+            NOTE: The pairs of the last 'color' may share dynamic bodies,
+            and small colors are not worth waking up the worker threads.
+        */
+        bool parallel = (i < FR_SOLVER_MAX_COLOR_COUNT
+                         && count >= FR_SOLVER_MIN_PARALLEL_COUNT);
+
+        frRunThreadPool(parallel ? w->pool : NULL, count, func, &taskCtx);
+    }
+
+    return frGetWorldImpulseScalar(w);
+}
+
+/* 
+    Moves the pairs of each color in `w` (except the last one) 
+    to the contact solver of `w`, with the given `inverseDt`.
+*/
+static void frBatchWorldPairs(frWorld *w, float inverseDt) {
+    frClearContactSolver(w->solver);
+
+    for (int i = 0; i < FR_SOLVER_MAX_COLOR_COUNT; i++) {
+        w->batchOffsets[i] = frGetContactSolverBatchCount(w->solver);
+
+        for (int j = w->colorOffsets[i]; j < w->colorOffsets[i + 1]; j++) {
+            frContactCacheEntry *entry = &w->cache[frGetDynArrayValue(
+                w->colorIndices, j)];
+
+            frAddToContactSolver(w->solver,
+                                 entry->key.first,
+                                 entry->key.second,
+                                 &entry->value,
+                                 inverseDt,
+                                 w->baumgarteFactor,
+                                 w->baumgarteSlop);
+        }
+
+        // NOTE: A contact batch must not contain pairs of different colors
+        frCloseContactSolverBatch(w->solver);
+    }
+
+    w->batchOffsets[FR_SOLVER_MAX_COLOR_COUNT] =
+        frGetContactSolverBatchCount(w->solver);
+}
+
+/* 
+    Resolves the contact batches of each color in `w`, one color 
+    at a time, then solves the pairs of the last color and returns
+    the largest change in the accumulated impulses.
+*/
+static float frSolveWorldBatches(frWorld *w, float inverseDt) {
+    frResetWorldImpulseScalars(w);
+
+    for (int i = 0; i < FR_SOLVER_MAX_COLOR_COUNT; i++) {
+        int offset = w->batchOffsets[i];
+        int count = w->batchOffsets[i + 1] - offset;
+
+        if (count <= 0) continue;
+
+        frSolverTaskCtx taskCtx = { .world = w, .offset = offset };
+
+        bool parallel = (w->colorOffsets[i + 1] - w->colorOffsets[i]
+                         >= FR_SOLVER_MIN_PARALLEL_COUNT);
+
+        frRunThreadPool(parallel ? w->pool : NULL,
+                        count,
+                        frBatchTaskCallback,
+                        &taskCtx);
+    }
+
+    int offset = w->colorOffsets[FR_SOLVER_MAX_COLOR_COUNT];
+    int count = w->colorOffsets[FR_SOLVER_MAX_COLOR_COUNT + 1] - offset;
+
+    if (count <= 0) return frGetWorldImpulseScalar(w);
+
+    // NOTE: The pairs of the last 'color' may share dynamic bodies
+    frSolverTaskCallback(0,
+                         0,
+                         count,
+                         &(frSolverTaskCtx) {
+                             .world = w,
+                             .indices = &frGetDynArrayValue(w->colorIndices,
+                                                            offset),
+                             .inverseDt = inverseDt });
+
+    return frGetWorldImpulseScalar(w);
+}
+
+/* 
+    A callback function for `frRunThreadPool()` that will be called 
+    during `frSolveWorldPairs()`, which applies the accumulated impulses
+    of each pair in the given range.
+*/
+static void frWarmStartTaskCallback(int threadIndex,
+                                    int begin,
+                                    int end,
+                                    void *ctx) {
+    frSolverTaskCtx *taskCtx = ctx;
+
+    for (int i = begin; i < end; i++) {
+        frContactCacheEntry *entry = &taskCtx->world
+                                          ->cache[taskCtx->indices[i]];
+
+        frApplyAccumulatedImpulses(entry->key.first,
+                                   entry->key.second,
+                                   &entry->value);
+    }
+}
+
+/* 
+    A callback function for `frRunThreadPool()` that will be called 
+    during `frSolveWorldBatches()`, which resolves the contact batches
+    in the given range.
+*/
+static void frBatchTaskCallback(int threadIndex,
+                                int begin,
+                                int end,
+                                void *ctx) {
+    frSolverTaskCtx *taskCtx = ctx;
+
+    float *impulseScalar = &frGetDynArrayValue(taskCtx->world->impulseScalars,
+                                               threadIndex);
+
+    *impulseScalar = fmaxf(
+        *impulseScalar,
+        frResolveContactSolverBatches(taskCtx->world->solver,
+                                      taskCtx->offset + begin,
+                                      taskCtx->offset + end));
+}
+
+/* 
+    Resets the largest change in the accumulated impulses 
+    reported by each thread of `w`.
+*/
+static void frResetWorldImpulseScalars(frWorld *w) {
+    int threadCount = frGetThreadPoolSize(w->pool);
+
+    if (frGetDynArrayCapacity(w->impulseScalars) < threadCount)
+        frSetDynArrayCapacity(w->impulseScalars, threadCount);
+
+    frSetDynArrayLength(w->impulseScalars, threadCount);
+
+    // NOTE: Each thread only writes to its own slot
+    for (int i = 0; i < threadCount; i++)
+        frGetDynArrayValue(w->impulseScalars, i) = 0.0f;
+}
+
+/* 
+    Returns the largest change in the accumulated impulses 
+    reported by all threads of `w`.
+*/
+static float frGetWorldImpulseScalar(const frWorld *w) {
+    float result = 0.0f;
+
+    for (int i = 0; i < frGetDynArrayLength(w->impulseScalars); i++)
+        result = fmaxf(result, frGetDynArrayValue(w->impulseScalars, i));
+
+    return result;
+}
+
+/* 
+    A callback function for `frRunThreadPool()` that will be called 
+    during `frSolveWorldPairs()`, which resolves the collision 
+    of each pair in the given range.
+*/
+static void frSolverTaskCallback(int threadIndex,
+                                 int begin,
+                                 int end,
+                                 void *ctx) {
+    frSolverTaskCtx *taskCtx = ctx;
+
+    frWorld *w = taskCtx->world;
+
+    float *impulseScalar = &frGetDynArrayValue(w->impulseScalars,
+                                               threadIndex);
+
+    for (int i = begin; i < end; i++) {
+        frContactCacheEntry *entry = &w->cache[taskCtx->indices[i]];
+
+        *impulseScalar = fmaxf(*impulseScalar,
+                               frResolveCollision(entry->key.first,
+                                                  entry->key.second,
+                                                  &entry->value,
+                                                  taskCtx->inverseDt,
+                                                  w->baumgarteFactor,
+                                                  w->baumgarteSlop));
+    }
+}
+
+/* Casts a ray against all objects in `w`, as described in `queryCtx`. */
+static void frCastRayInWorld(frWorld *w, frRaycastQueryCtx *queryCtx) {
+    queryCtx->world = w;
+
+    if (w->broadPhaseType == FR_BROAD_PHASE_DYNAMIC_TREE)
+        frRaycastDynamicTree(w->tree,
+                             queryCtx->ray,
+                             frRaycastQueryCallback,
+                             queryCtx);
+    else if (w->broadPhaseType == FR_BROAD_PHASE_SWEEP_AND_PRUNE)
+        frRaycastSweepAndPrune(w->sap,
+                               queryCtx->ray,
+                               frRaycastQueryCallback,
+                               queryCtx);
+    else
+        frRaycastSpatialHash(w->hash,
+                             queryCtx->ray,
+                             frRaycastQueryCallback,
+                             queryCtx);
+}
+
+/* Returns the bounds of all bodies in the broad-phase data of `w`. */
+static frAABB frGetWorldBounds(const frWorld *w) {
+    if (w->broadPhaseType == FR_BROAD_PHASE_DYNAMIC_TREE)
+        return frGetDynamicTreeBounds(w->tree);
+    else if (w->broadPhaseType == FR_BROAD_PHASE_SWEEP_AND_PRUNE)
+        return frGetSweepAndPruneBounds(w->sap);
+    else
+        return frGetSpatialHashBounds(w->hash);
+}
+
+/* 
+    Groups the `count` rays in `rays` by the cells of `w` they start in, 
+    then finds the bodies that any ray of each group might hit.
+*/
+static void frGroupWorldRays(frWorld *w, const frRay *rays, int count) {
+    frSetDynArrayLength(w->rayEntries, 0);
+    frSetDynArrayLength(w->rayGroups, 0);
+    frSetDynArrayLength(w->rayCandidates, 0);
+
+    if (frGetDynArrayLength(w->bodies) <= 0) return;
+
+    frAABB bounds = frGetWorldBounds(w);
+
+    float inverseCellSize = 1.0f / frGetSpatialHashCellSize(w->hash);
+
+    for (int i = 0; i < count; i++) {
+        frRaycastBatchEntry entry = { .index = i, .group = -1 };
+
+        frVector2 direction = frVector2Normalize(rays[i].direction);
+
+        /*
+            NOTE: Any hit must lie within the bounds of all bodies, 
+            so each ray only has to look at the part of its segment
+            that overlaps those bounds.
+        */
+        frVector2 start = rays[i].origin;
+        frVector2 end = frVector2Add(
+            start, frVector2ScalarMultiply(direction, rays[i].maxDistance));
+
+        float minX = fmaxf(fminf(start.x, end.x), bounds.x);
+        float minY = fmaxf(fminf(start.y, end.y), bounds.y);
+
+        float maxX = fminf(fmaxf(start.x, end.x), bounds.x + bounds.width);
+        float maxY = fminf(fmaxf(start.y, end.y), bounds.y + bounds.height);
+
+        // NOTE: This ray does not cross the bounds of any body
+        if (minX > maxX || minY > maxY) continue;
+
+        entry.aabb = (frAABB) { .x = minX,
+                                .y = minY,
+                                .width = maxX - minX,
+                                .height = maxY - minY };
+
+        int spanX = (int) floorf(maxX * inverseCellSize)
+                    - (int) floorf(minX * inverseCellSize);
+        int spanY = (int) floorf(maxY * inverseCellSize)
+                    - (int) floorf(minY * inverseCellSize);
+
+        /*
+            NOTE: A long ray would make the AABB of its group too large,
+            so it will walk the cells (or nodes) it crosses on its own.
+        */
+        if (spanX >= FR_WORLD_RAYCAST_GROUP_SIZE
+            || spanY >= FR_WORLD_RAYCAST_GROUP_SIZE) {
+            entry.cellX = entry.cellY = INT_MAX;
+        } else {
+            float startX = fminf(fmaxf(start.x, minX), maxX);
+            float startY = fminf(fmaxf(start.y, minY), maxY);
+
+            entry.cellX = (int) floorf(startX * inverseCellSize);
+            entry.cellY = (int) floorf(startY * inverseCellSize);
+
+            entry.group = 0;
+        }
+
+        frDynArrayPush(w->rayEntries, entry);
+    }
+
+    int entryCount = frGetDynArrayLength(w->rayEntries);
+
+    /*
+        NOTE: Sorting the rays by their cells makes the rays 
+        of each group contiguous in `w->rayEntries`.
+    */
+    qsort(w->rayEntries.buffer,
+          entryCount,
+          sizeof *(w->rayEntries.buffer),
+          frCompareRaycastBatchEntries);
+
+    for (int i = 0; i < entryCount; i++) {
+        frRaycastBatchEntry *entry = &frGetDynArrayValue(w->rayEntries, i);
 
-    for (int i = 0; i < frGetDynArrayLength(w->bodies); i++)
-        frInsertIntoSpatialHash(w->hash,
-                                frGetBodyAABB(frGetDynArrayValue(w->bodies, i)),
-                                i);
-
-    frVector2 minVertex = ray.origin,
-              maxVertex = frVector2Add(
-                  ray.origin,
-                  frVector2ScalarMultiply(frVector2Normalize(ray.direction),
-                                          ray.maxDistance));
-
-    frQuerySpatialHash(w->hash,
-                       (frAABB) { .x = fminf(minVertex.x, maxVertex.x),
-                                  .y = fminf(minVertex.y, maxVertex.y),
-                                  .width = fabsf(maxVertex.x - minVertex.x),
-                                  .height = fabsf(maxVertex.y - minVertex.y) },
-                       frRaycastHashQueryCallback,
-                       &(frRaycastHashQueryCtx) { .ctx = userData,
-                                                  .ray = ray,
-                                                  .world = w,
-                                                  .func = func });
+        if (entry->group < 0) continue;
+
+        int groupCount = frGetDynArrayLength(w->rayGroups);
+
+        const frRaycastBatchEntry *prevEntry =
+            (i > 0) ? &frGetDynArrayValue(w->rayEntries, i - 1) : NULL;
+
+        if (prevEntry == NULL || prevEntry->cellX != entry->cellX
+            || prevEntry->cellY != entry->cellY) {
+            frDynArrayPush(w->rayGroups,
+                           ((frRaycastBatchGroup) { .aabb = entry->aabb }));
+
+            entry->group = groupCount;
+
+            continue;
+        }
+
+        frRaycastBatchGroup *group = &frGetDynArrayValue(w->rayGroups,
+                                                         groupCount - 1);
+
+        float maxX = fmaxf(group->aabb.x + group->aabb.width,
+                           entry->aabb.x + entry->aabb.width);
+        float maxY = fmaxf(group->aabb.y + group->aabb.height,
+                           entry->aabb.y + entry->aabb.height);
+
+        group->aabb.x = fminf(group->aabb.x, entry->aabb.x);
+        group->aabb.y = fminf(group->aabb.y, entry->aabb.y);
+
+        group->aabb.width = maxX - group->aabb.x;
+        group->aabb.height = maxY - group->aabb.y;
+
+        entry->group = groupCount - 1;
+    }
+
+    // NOTE: Each group walks the broad phase of `w` only once
+    for (int i = 0; i < frGetDynArrayLength(w->rayGroups); i++) {
+        frRaycastBatchGroup *group = &frGetDynArrayValue(w->rayGroups, i);
+
+        group->offset = frGetDynArrayLength(w->rayCandidates);
+
+        if (w->broadPhaseType == FR_BROAD_PHASE_DYNAMIC_TREE)
+            frQueryDynamicTree(w->tree,
+                               group->aabb,
+                               frRaycastBatchQueryCallback,
+                               w);
+        else if (w->broadPhaseType == FR_BROAD_PHASE_SWEEP_AND_PRUNE)
+            frQuerySweepAndPrune(w->sap,
+                                 group->aabb,
+                                 frRaycastBatchQueryCallback,
+                                 w);
+        else
+            frQuerySpatialHash(w->hash,
+                               group->aabb,
+                               frRaycastBatchQueryCallback,
+                               w);
+
+        group->count = frGetDynArrayLength(w->rayCandidates) - group->offset;
+    }
 }
 
-/* Private Functions ======================================================> */
+/* 
+    A callback function for `frRunThreadPool()` that will be called 
+    during `frComputeWorldRaycastBatch()`, which casts each ray 
+    in the given range of the grouped rays.
+*/
+static void frRaycastBatchTaskCallback(int threadIndex,
+                                       int begin,
+                                       int end,
+                                       void *ctx) {
+    frRaycastBatchCtx *batchCtx = ctx;
+
+    frWorld *w = batchCtx->world;
+
+    for (int i = begin; i < end; i++) {
+        const frRaycastBatchEntry *entry = &frGetDynArrayValue(w->rayEntries,
+                                                               i);
+
+        frRaycastHit *raycastHit = &batchCtx->raycastHits[entry->index];
+
+        frRay ray = batchCtx->rays[entry->index];
+
+        if (entry->group < 0) {
+            frRaycastQueryCtx queryCtx = { .type = FR_RAYCAST_CLOSEST,
+                                           .ray = ray };
+
+            frCastRayInWorld(w, &queryCtx);
+
+            if (queryCtx.hit) *raycastHit = queryCtx.raycastHit;
+
+            continue;
+        }
+
+        const frRaycastBatchGroup *group = &frGetDynArrayValue(w->rayGroups,
+                                                               entry->group);
+
+        for (int j = group->offset; j < group->offset + group->count; j++) {
+            const frBody *body = frGetDynArrayValue(
+                w->bodies, frGetDynArrayValue(w->rayCandidates, j));
+
+            if (!frComputeAABBRaycast(frGetBodyAABB(body), ray, NULL))
+                continue;
+
+            frRaycastHit newHit = { .distance = 0.0f };
+
+            if (!frComputeRaycast(body, ray, &newHit)) continue;
+
+            // NOTE: Any object farther than this one can be skipped
+            *raycastHit = newHit, ray.maxDistance = newHit.distance;
+        }
+    }
+}
 
 /* 
-    A callback function for `frQuerySpatialHash()` 
-    that will be called during `frPreStepWorld()`. 
+    Finds the earliest time of impact of each 'bullet' body in `w`
+    with a static or kinematic body over `dt`.
 */
-static bool frPreStepHashQueryCallback(frContextNode queryResult) {
-    frPreStepHashQueryCtx *queryCtx = queryResult.ctx;
+static void frComputeWorldBullets(frWorld *w, float dt) {
+    frSetDynArrayLength(w->bullets, 0);
 
-    int firstIndex = queryCtx->bodyIndex, secondIndex = queryResult.id;
+    for (int i = 0; i < frGetDynArrayLength(w->bodies); i++) {
+        frBody *b = frGetDynArrayValue(w->bodies, i);
 
-    if (firstIndex >= secondIndex) return false;
+        if (!(frGetBodyFlags(b) & FR_FLAG_BULLET)
+            || frGetBodyType(b) != FR_BODY_DYNAMIC || frIsBodySleeping(b))
+            continue;
 
-    frWorld *world = queryCtx->world;
+        const frShape *s = frGetBodyShape(b);
 
-    frBody *b1 = frGetDynArrayValue(world->bodies, firstIndex);
-    frBody *b2 = frGetDynArrayValue(world->bodies, secondIndex);
+        if (s == NULL) continue;
 
-    if (frGetBodyInverseMass(b1) + frGetBodyInverseMass(b2) <= 0.0f)
-        return false;
+        frTransform tx = frGetBodyTransform(b);
 
-    frBodyPair key = { .first = b1, .second = b2 };
+        tx.position = frVector2Add(
+            tx.position,
+            frVector2ScalarMultiply(frGetBodyVelocity(b), dt));
 
-    frCollision collision = { .count = 0 };
+        tx.angle += frGetBodyAngularVelocity(b) * dt;
+
+        tx.rotation.sin_ = sinf(tx.angle);
+        tx.rotation.cos_ = cosf(tx.angle);
 
-    if (!frComputeCollision(b1, b2, &collision)) {
         /*
-            NOTE: `hmdel()` returns `0` if `key` is not 
-            in `world->cache`!
+            NOTE: The broad-phase data of `w` still holds the AABBs 
+            at the start of this step, so `b` is queried with the AABB 
+            that covers both ends of its motion.
         */
+        frAABB aabb = frGetBodyAABB(b), endAABB = frGetShapeAABB(s, tx);
+
+        float minX = fminf(aabb.x, endAABB.x);
+        float minY = fminf(aabb.y, endAABB.y);
+
+        frAABB sweptAABB = {
+            .x = minX,
+            .y = minY,
+            .width = fmaxf(aabb.x + aabb.width, endAABB.x + endAABB.width)
+                     - minX,
+            .height = fmaxf(aabb.y + aabb.height,
+                            endAABB.y + endAABB.height)
+                      - minY
+        };
+
+        frBulletQueryCtx queryCtx = {
+            .world = w, .body = b, .dt = dt, .toi = 1.0f
+        };
+
+        if (w->broadPhaseType == FR_BROAD_PHASE_DYNAMIC_TREE)
+            frQueryDynamicTree(w->tree,
+                               sweptAABB,
+                               frBulletQueryCallback,
+                               &queryCtx);
+        else if (w->broadPhaseType == FR_BROAD_PHASE_SWEEP_AND_PRUNE)
+            frQuerySweepAndPrune(w->sap,
+                                 sweptAABB,
+                                 frBulletQueryCallback,
+                                 &queryCtx);
+        else
+            frQuerySpatialHash(w->hash,
+                               sweptAABB,
+                               frBulletQueryCallback,
+                               &queryCtx);
+
+        if (queryCtx.toi < 1.0f) frDynArrayPush(w->bullets, queryCtx);
+    }
+}
+
+/* 
+    Moves each 'bullet' body in `w` that hit a static or kinematic body
+    back to its time of impact.
+*/
+static void frRewindWorldBullets(frWorld *w, float dt) {
+    for (int i = 0; i < frGetDynArrayLength(w->bullets); i++) {
+        const frBulletQueryCtx *queryCtx = &w->bullets.buffer[i];
+
+        frBody *b = queryCtx->body;
 
-        hmdel(world->cache, key);
+        float remainingDt = (1.0f - queryCtx->toi) * dt;
 
-        return false;
+        /*
+            NOTE: `b` moves along with the body it hit after the time 
+            of impact, so that a kinematic body does not run over `b`.
+            The velocity of `b` is kept as it is, since the solver will 
+            resolve their contact in the next step.
+        */
+        frVector2 relVelocity = frVector2Subtract(
+            frGetBodyVelocity(b),
+            frGetBodyVelocity(queryCtx->other));
+
+        frSetBodyPosition(
+            b,
+            frVector2Subtract(frGetBodyPosition(b),
+                              frVector2ScalarMultiply(relVelocity,
+                                                      remainingDt)));
+
+        frSetBodyAngle(b,
+                       frGetBodyAngle(b)
+                           - (frGetBodyAngularVelocity(b) * remainingDt));
     }
+}
 
-    frContactCacheEntry *entry = hmgetp_null(world->cache, key);
+/* 
+    Integrates the velocities of the bodies in `w`, resolves the collision 
+    of each pair with the iteration count of `w`, 
+    then integrates the positions of the bodies in `w` over `dt`.
+*/
+static void frIterateWorld(frWorld *w, float dt) {
+    {
+        frBeginWorldTimer(integrationTimer);
 
-    const frShape *s1 = frGetBodyShape(b1), *s2 = frGetBodyShape(b2);
+        frIntegrateForBodyStorageVelocities(w->storage, w->gravity, dt);
 
-    for (int i = 0; i < collision.count; i++)
-        collision.contacts[i].timestamp = world->timestamp;
+        frEndWorldTimer(w, integrationTimer, integrationTime);
+    }
 
-    if (entry != NULL) {
-        collision.friction = entry->value.friction;
-        collision.restitution = entry->value.restitution;
+    float inverseDt = 1.0f / dt;
 
-        for (int i = 0; i < collision.count; i++) {
-            int newIndex = i, oldIndex = -1;
+    frBeginWorldTimer(warmStartTimer);
 
-            for (int j = 0; j < entry->value.count; j++) {
-                int newContactId = collision.contacts[newIndex].id;
-                int oldContactId = entry->value.contacts[j].id;
+    if (w->solverType == FR_SOLVER_WIDE) {
+        frColorWorldPairs(w);
 
-                if (newContactId == oldContactId) {
-                    oldIndex = j;
+        frSolveWorldPairs(w, frWarmStartTaskCallback, inverseDt);
 
-                    break;
-                }
-            }
+        frBatchWorldPairs(w, inverseDt);
+
+        frEndWorldTimer(w, warmStartTimer, warmStartTime);
+
+        frBeginWorldTimer(solverTimer);
 
-            if (oldIndex < 0) continue;
+        for (int i = 0; i < w->iterationCount; i++) {
+            frAddWorldCounter(w, solverIterationCount, 1);
 
-            const frContact *oldContact = &entry->value.contacts[oldIndex];
+            if (frSolveWorldBatches(w, inverseDt) < w->convergenceThreshold)
+                break;
+        }
+
+        frStoreContactSolverImpulses(w->solver);
+
+        frEndWorldTimer(w, solverTimer, solverTime);
+    } else if (w->solverType == FR_SOLVER_GRAPH_COLORING) {
+        frColorWorldPairs(w);
 
-            frContact *newContact = &collision.contacts[newIndex];
+        frSolveWorldPairs(w, frWarmStartTaskCallback, inverseDt);
 
-            float oldNormalScalar = oldContact->cache.normalScalar;
-            float oldTangentScalar = oldContact->cache.tangentScalar;
+        frEndWorldTimer(w, warmStartTimer, warmStartTime);
 
-            newContact->cache.normalScalar = oldNormalScalar;
-            newContact->cache.tangentScalar = oldTangentScalar;
+        frBeginWorldTimer(solverTimer);
+
+        for (int i = 0; i < w->iterationCount; i++) {
+            frAddWorldCounter(w, solverIterationCount, 1);
+
+            if (frSolveWorldPairs(w, frSolverTaskCallback, inverseDt)
+                < w->convergenceThreshold)
+                break;
         }
+
+        frEndWorldTimer(w, solverTimer, solverTime);
     } else {
-        collision.friction = 0.5f
-                             * (frGetShapeFriction(s1)
-                                + frGetShapeFriction(s2));
-        collision.restitution = fminf(frGetShapeRestitution(s1),
-                                      frGetShapeRestitution(s2));
+        for (int j = 0; j < hmlen(w->cache); j++) {
+            if (frIsPairSleeping(w->cache[j].key)) continue;
+
+            frApplyAccumulatedImpulses(w->cache[j].key.first,
+                                       w->cache[j].key.second,
+                                       &w->cache[j].value);
+        }
+
+        frEndWorldTimer(w, warmStartTimer, warmStartTime);
+
+        frBeginWorldTimer(solverTimer);
+
+        for (int i = 0; i < w->iterationCount; i++) {
+            float maxImpulseScalar = 0.0f;
+
+            for (int j = 0; j < hmlen(w->cache); j++) {
+                if (frIsPairSleeping(w->cache[j].key)) continue;
+
+                maxImpulseScalar = fmaxf(
+                    maxImpulseScalar,
+                    frResolveCollision(w->cache[j].key.first,
+                                       w->cache[j].key.second,
+                                       &w->cache[j].value,
+                                       inverseDt,
+                                       w->baumgarteFactor,
+                                       w->baumgarteSlop));
+            }
 
-        if (collision.friction < 0.0f) collision.friction = 0.0f;
-        if (collision.restitution < 0.0f) collision.restitution = 0.0f;
+            frAddWorldCounter(w, solverIterationCount, 1);
+
+            // NOTE: The solver has converged if no impulse has changed much
+            if (maxImpulseScalar < w->convergenceThreshold) break;
+        }
+
+        frEndWorldTimer(w, solverTimer, solverTime);
     }
 
-    hmputs(queryCtx->world->cache,
-           ((frContactCacheEntry) { .key = key, .value = collision }));
+    {
+        frBeginWorldTimer(integrationTimer);
 
-    return true;
+        // NOTE: Only the 'bullet' bodies pay for continuous collision
+        frComputeWorldBullets(w, dt);
+
+        frIntegrateForBodyStoragePositions(w->storage, dt);
+
+        frRewindWorldBullets(w, dt);
+
+        frEndWorldTimer(w, integrationTimer, integrationTime);
+    }
 }
 
 /* 
-    A callback function for `frQuerySpatialHash()` 
-    that will be called during `frComputeRaycastForWorld()`.
+    Splits `dt` into the sub-steps of `w`, each of which integrates 
+    the velocities of the bodies in `w`, resolves the collision of each pair 
+    as a soft constraint, integrates the positions of the bodies in `w`
+    and then relaxes the contacts, with the contacts found at the start 
+    of the step.
 */
-static bool frRaycastHashQueryCallback(frContextNode ctxNode) {
-    frRaycastHashQueryCtx *queryCtx = ctxNode.ctx;
+static void frSubstepWorld(frWorld *w, float dt) {
+    float substepDt = dt / w->substepCount, inverseSubstepDt = 1.0f / substepDt;
 
-    const frBody *body = frGetDynArrayValue(queryCtx->world->bodies,
-                                            ctxNode.id);
+    {
+        frBeginWorldTimer(warmStartTimer);
 
-    frRaycastHit raycastHit = { .distance = 0.0f };
+        for (int j = 0; j < hmlen(w->cache); j++) {
+            if (frIsPairSleeping(w->cache[j].key)) continue;
+
+            frStoreCollisionVelocities(w->cache[j].key.first,
+                                       w->cache[j].key.second,
+                                       &w->cache[j].value);
+        }
+
+        frEndWorldTimer(w, warmStartTimer, warmStartTime);
+    }
 
-    if (!frComputeRaycast(body, queryCtx->ray, &raycastHit)) return false;
+    for (int i = 0; i < w->substepCount; i++) {
+        {
+            frBeginWorldTimer(integrationTimer);
 
-    queryCtx->func(raycastHit, queryCtx->ctx);
+            /*
+                NOTE: The gravity force is added to the accumulated forces 
+                on each body, so it must be added only once in a step.
+            */
+            frIntegrateForBodyStorageVelocities(
+                w->storage,
+                (i == 0) ? w->gravity : frStructZero(frVector2),
+                substepDt);
 
-    return true;
+            frEndWorldTimer(w, integrationTimer, integrationTime);
+        }
+
+        {
+            frBeginWorldTimer(warmStartTimer);
+
+            /*
+                NOTE: The accumulated impulses are applied again 
+                on each sub-step, since they are the impulses 
+                of a single sub-step.
+            */
+            for (int j = 0; j < hmlen(w->cache); j++) {
+                if (frIsPairSleeping(w->cache[j].key)) continue;
+
+                frApplyAccumulatedImpulses(w->cache[j].key.first,
+                                           w->cache[j].key.second,
+                                           &w->cache[j].value);
+            }
+
+            frEndWorldTimer(w, warmStartTimer, warmStartTime);
+        }
+
+        {
+            frBeginWorldTimer(solverTimer);
+
+            for (int j = 0; j < hmlen(w->cache); j++) {
+                if (frIsPairSleeping(w->cache[j].key)) continue;
+
+                frResolveCollisionSoft(w->cache[j].key.first,
+                                       w->cache[j].key.second,
+                                       &w->cache[j].value,
+                                       inverseSubstepDt,
+                                       w->baumgarteSlop,
+                                       true);
+
+                // NOTE: The contacts move along with the bodies
+                frUpdateCollisionDepths(w->cache[j].key.first,
+                                        w->cache[j].key.second,
+                                        &w->cache[j].value,
+                                        substepDt);
+            }
+
+            frEndWorldTimer(w, solverTimer, solverTime);
+        }
+
+        {
+            frBeginWorldTimer(integrationTimer);
+
+            frComputeWorldBullets(w, substepDt);
+
+            frIntegrateForBodyStoragePositions(w->storage, substepDt);
+
+            frRewindWorldBullets(w, substepDt);
+
+            frEndWorldTimer(w, integrationTimer, integrationTime);
+        }
+
+        {
+            frBeginWorldTimer(solverTimer);
+
+            /*
+                NOTE: Relaxing the contacts removes the velocities 
+                gained from pushing the overlapping bodies apart.
+            */
+            for (int j = 0; j < hmlen(w->cache); j++) {
+                if (frIsPairSleeping(w->cache[j].key)) continue;
+
+                frResolveCollisionSoft(w->cache[j].key.first,
+                                       w->cache[j].key.second,
+                                       &w->cache[j].value,
+                                       inverseSubstepDt,
+                                       w->baumgarteSlop,
+                                       false);
+            }
+
+            frEndWorldTimer(w, solverTimer, solverTime);
+        }
+    }
+
+    {
+        frBeginWorldTimer(solverTimer);
+
+        for (int j = 0; j < hmlen(w->cache); j++) {
+            if (frIsPairSleeping(w->cache[j].key)) continue;
+
+            frApplyCollisionRestitution(w->cache[j].key.first,
+                                        w->cache[j].key.second,
+                                        &w->cache[j].value);
+        }
+
+        frEndWorldTimer(w, solverTimer, solverTime);
+    }
+}
+
+/* 
+    Returns the index of the node that represents the island 
+    containing the body at the given `i`ndex in `w`.
+*/
+static int frFindWorldIsland(frWorld *w, int i) {
+    while (frGetDynArrayValue(w->islands, i).parent != i) {
+        frIslandNode *node = &frGetDynArrayValue(w->islands, i);
+
+        // NOTE: Path halving keeps the island graph shallow
+        node->parent = frGetDynArrayValue(w->islands, node->parent).parent;
+
+        i = node->parent;
+    }
+
+    return i;
+}
+
+/* 
+    Groups the dynamic bodies in `w` that are touching each other 
+    into islands, then wakes up each island that has an awake body.
+*/
+static void frBuildWorldIslands(frWorld *w) {
+    int bodyCount = frGetDynArrayLength(w->bodies);
+
+    if (frGetDynArrayCapacity(w->islands) < bodyCount)
+        frSetDynArrayCapacity(w->islands, bodyCount);
+
+    frSetDynArrayLength(w->islands, bodyCount);
+
+    for (int i = 0; i < bodyCount; i++)
+        frGetDynArrayValue(w->islands, i) = (frIslandNode) {
+            .parent = i, .sleepTime = FLT_MAX
+        };
+
+    for (int j = 0; j < hmlen(w->cache); j++) {
+        const frContactCacheEntry *entry = &w->cache[j];
+
+        /*
+            NOTE: Static and kinematic bodies are shared by many islands,
+            so they must not connect the bodies touching them.
+        */
+        if (entry->value.count <= 0
+            || frGetBodyType(entry->key.first) != FR_BODY_DYNAMIC
+            || frGetBodyType(entry->key.second) != FR_BODY_DYNAMIC)
+            continue;
+
+        int root1 = frFindWorldIsland(w, entry->indices[0]);
+        int root2 = frFindWorldIsland(w, entry->indices[1]);
+
+        if (root1 != root2) frGetDynArrayValue(w->islands, root1).parent = root2;
+    }
+
+    for (int i = 0; i < bodyCount; i++) {
+        const frBody *b = frGetDynArrayValue(w->bodies, i);
+
+        if (frGetBodyType(b) == FR_BODY_DYNAMIC && !frIsBodySleeping(b))
+            frGetDynArrayValue(w->islands, frFindWorldIsland(w, i)).awake =
+                true;
+    }
+
+    for (int i = 0; i < bodyCount; i++) {
+        frBody *b = frGetDynArrayValue(w->bodies, i);
+
+        if (frIsBodySleeping(b)
+            && frGetDynArrayValue(w->islands, frFindWorldIsland(w, i)).awake)
+            frSetBodySleeping(b, false);
+    }
+}
+
+/* 
+    Updates the sleep timer of each body in `w`, then puts each island 
+    whose bodies have been resting for long enough to sleep.
+*/
+static void frSleepWorldIslands(frWorld *w, float dt) {
+    int bodyCount = frGetDynArrayLength(w->islands);
+
+    for (int i = 0; i < bodyCount; i++) {
+        frBody *b = frGetDynArrayValue(w->bodies, i);
+
+        if (frGetBodyType(b) != FR_BODY_DYNAMIC) continue;
+
+        frUpdateBodySleepTime(b, dt);
+
+        frIslandNode *node = &frGetDynArrayValue(w->islands,
+                                                 frFindWorldIsland(w, i));
+
+        if (node->sleepTime > frGetBodySleepTime(b))
+            node->sleepTime = frGetBodySleepTime(b);
+    }
+
+    for (int i = 0; i < bodyCount; i++) {
+        frBody *b = frGetDynArrayValue(w->bodies, i);
+
+        if (frGetBodyType(b) != FR_BODY_DYNAMIC || frIsBodySleeping(b))
+            continue;
+
+        if (frGetDynArrayValue(w->islands, frFindWorldIsland(w, i)).sleepTime
+            >= FR_WORLD_SLEEP_TIME)
+            frSetBodySleeping(b, true);
+    }
+}
+
+/* Checks if the solver can skip the given pair of bodies. */
+static FR_API_INLINE bool frIsPairSleeping(frBodyPair key) {
+    /*
+        NOTE: Two dynamic bodies touching each other always belong to
+        the same island, so either both of them are sleeping or neither is.
+    */
+    return frIsBodySleeping(key.first) || frIsBodySleeping(key.second);
+}
+
+/* Checks if neither body of the pair with the given `key` can move. */
+static FR_API_INLINE bool frIsPairResting(frBodyPair key) {
+    return (frIsBodySleeping(key.first)
+            || frGetBodyType(key.first) == FR_BODY_STATIC)
+           && (frIsBodySleeping(key.second)
+               || frGetBodyType(key.second) == FR_BODY_STATIC);
+}
+
+/* Checks if `b` is a kinematic body that is moving. */
+static FR_API_INLINE bool frIsKinematicBodyMoving(const frBody *b) {
+    if (frGetBodyType(b) != FR_BODY_KINEMATIC) return false;
+
+    frVector2 velocity = frGetBodyVelocity(b);
+
+    return velocity.x != 0.0f || velocity.y != 0.0f
+           || frGetBodyAngularVelocity(b) != 0.0f;
+}
+
+/* 
+    Returns how far apart two bodies moving with the relative `velocity` 
+    can be for their contacts to be found in the next step of `w`.
+*/
+static FR_API_INLINE float frGetSpeculativeMargin(const frWorld *w,
+                                                  frVector2 velocity) {
+    if (!w->speculative) return 0.0f;
+
+    // NOTE: The gravity accelerates each body before the solver runs
+    return (frVector2Magnitude(velocity)
+            + frVector2Magnitude(w->gravity) * w->dt)
+           * w->dt;
+}
+
+/* 
+    Returns the AABB of `b` in `w`, which also covers the motion of `b`
+    in the next step if `w` uses speculative contacts.
+*/
+static frAABB frGetWorldBodyAABB(const frWorld *w, const frBody *b) {
+    frAABB result = frGetBodyAABB(b);
+
+    if (!w->speculative) return result;
+
+    frVector2 deltaPosition = frVector2ScalarMultiply(frGetBodyVelocity(b),
+                                                      w->dt);
+
+    float margin = frGetSpeculativeMargin(w, frStructZero(frVector2));
+
+    result.x += fminf(deltaPosition.x, 0.0f) - margin;
+    result.y += fminf(deltaPosition.y, 0.0f) - margin;
+
+    result.width += fabsf(deltaPosition.x) + 2.0f * margin;
+    result.height += fabsf(deltaPosition.y) + 2.0f * margin;
+
+    return result;
 }
 
 /* Finds all pairs of bodies in `w` that are colliding. */
 static void frPreStepWorld(frWorld *w) {
-    for (int i = 0; i < frGetDynArrayLength(w->bodies); i++)
-        frInsertIntoSpatialHash(w->hash,
-                                frGetBodyAABB(frGetDynArrayValue(w->bodies, i)),
-                                i);
+    w->stepCount++;
 
-    for (int i = 0; i < frGetDynArrayLength(w->bodies); i++)
-        frQuerySpatialHash(w->hash,
-                           frGetBodyAABB(frGetDynArrayValue(w->bodies, i)),
-                           frPreStepHashQueryCallback,
-                           &(frPreStepHashQueryCtx) { .world = w,
-                                                      .bodyIndex = i });
+    frBeginWorldTimer(broadPhaseTimer);
+
+    if (w->broadPhaseType == FR_BROAD_PHASE_DYNAMIC_TREE) {
+        frQueryDynamicTreePairs(w->tree, frPreStepPairQueryCallback, w);
+    } else if (w->broadPhaseType == FR_BROAD_PHASE_SWEEP_AND_PRUNE) {
+        frQuerySweepAndPrunePairs(w->sap, frPreStepPairQueryCallback, w);
+    } else {
+        frQuerySpatialHashPairs(w->hash, frPreStepPairQueryCallback, w);
+
+        frAddWorldCounter(w, 
+                          hashCellCount, 
+                          frGetSpatialHashCellCount(w->hash));
+    }
+
+    // NOTE: `hmdel()` moves the last entry into the deleted one
+    for (int j = hmlen(w->cache) - 1; j >= 0; j--) {
+        frContactCacheEntry *entry = &w->cache[j];
+
+        /*
+            NOTE: A spatial hash and a sweep-and-prune structure report
+            every overlapping pair on each step, while a dynamic AABB tree
+            only reports the new ones, so the pairs in the latter must be
+            kept until their 'fat' AABBs stop overlapping. A spatial hash
+            skips the pairs of sleeping bodies, which cannot move apart
+            and must be kept to hold their islands together.
+        */
+        bool overlaps = (w->broadPhaseType == FR_BROAD_PHASE_DYNAMIC_TREE)
+                            ? frCheckDynamicTreeOverlap(w->tree,
+                                                        entry->proxyIds[0],
+                                                        entry->proxyIds[1])
+                            : (entry->stepCount == w->stepCount
+                               || frIsPairSleeping(entry->key));
+
+        if (overlaps) continue;
+
+        frAddWorldCounter(w, cacheDeleteCount, 1);
+
+        hmdel(w->cache, entry->key);
+    }
+
+    frEndWorldTimer(w, broadPhaseTimer, broadPhaseTime);
+
+    frBeginWorldTimer(narrowPhaseTimer);
+
+    /*
+        NOTE: Each pair only writes to its own entry of the contact cache,
+        so the pairs can be split across threads in any way.
+    */
+    frRunThreadPool(w->pool,
+                    hmlen(w->cache),
+                    frPreStepNarrowPhaseCallback,
+                    w);
+
+    frEndWorldTimer(w, narrowPhaseTimer, narrowPhaseTime);
+
+    for (int j = 0; j < hmlen(w->cache); j++) {
+        const frContactCacheEntry *entry = &w->cache[j];
+
+        frBody *b1 = entry->key.first, *b2 = entry->key.second;
+
+        frAddWorldCounter(w, narrowPhaseTestCount, 
+                          !frIsPairResting(entry->key));
+        frAddWorldCounter(w, contactCount, entry->value.count);
+
+        /*
+            NOTE: A sleeping body touched by a moving kinematic body 
+            must be woken up here, since kinematic bodies never 
+            belong to any island.
+        */
+        if (entry->value.count > 0) {
+            if (frIsBodySleeping(b1) && frIsKinematicBodyMoving(b2))
+                frSetBodySleeping(b1, false);
+
+            if (frIsBodySleeping(b2) && frIsKinematicBodyMoving(b1))
+                frSetBodySleeping(b2, false);
+        }
+    }
+
+    frBuildWorldIslands(w);
 }
 
 /* 
-    Clears the accumulated forces on each body in `w`, 
-    then clears the spatial hash of `w`. 
+    Moves the data of the given `b`ody into `w`, 
+    then returns `true` if `b` has been added to `w`.
 */
-static void frPostStepWorld(frWorld *w) {
+static bool frInsertBodyIntoWorld(frWorld *w, frBody *b) {
+    // NOTE: A body cannot be in more than one world at a time
+    if (!frAddToBodyStorage(w->storage, b)) return false;
+
+    frDynArrayPush(w->bodies, b);
+    frDynArrayPush(w->proxyIds, -1);
+
+    frSetBodySleepFlag(b, &w->staticDirty);
+
+    return true;
+}
+
+/* Applies all pending operations (e.g. adding a body) on `w`. */
+static void frApplyWorldOperations(frWorld *w) {
     frContextNode node = { .id = FR_OPT_UNKNOWN };
 
+    int removedCount = 0;
+
     while (frRemoveFromRingBuffer(w->rbf, &node)) {
         switch (node.id) {
             case FR_OPT_ADD_BODY:
-                frDynArrayPush(w->bodies, node.ctx);
+                // NOTE: A removed body might be added back in the same step
+                if (removedCount > 0) {
+                    frRemoveStalePairsFromWorld(w);
+
+                    removedCount = 0;
+                }
+
+                (void) frInsertBodyIntoWorld(w, node.ctx);
 
                 break;
 
-            case FR_OPT_REMOVE_BODY:
-                for (int i = 0; i < frGetDynArrayLength(w->bodies); i++)
-                    if (frGetDynArrayValue(w->bodies, i) == node.ctx) {
-                        frDynArraySwap(frBody *,
-                                       w->bodies,
-                                       i,
-                                       frGetDynArrayLength(w->bodies) - 1);
+            case FR_OPT_REMOVE_BODY: {
+                // NOTE: A body can be removed more than once in a step
+                if (!frIsBodyInWorld(w, node.ctx)) break;
+
+                /*
+                    NOTE: The bodies of `w` are stored in the same order 
+                    as in the body storage of `w`.
+                */
+                int i = frGetBodyStorageIndex(node.ctx);
+
+                int lastIndex = frGetDynArrayLength(w->bodies) - 1;
+
+                int proxyId = frGetDynArrayValue(w->proxyIds, i);
+
+                if (w->broadPhaseType == FR_BROAD_PHASE_DYNAMIC_TREE)
+                    frRemoveFromDynamicTree(w->tree, proxyId);
+                else if (w->broadPhaseType == FR_BROAD_PHASE_SWEEP_AND_PRUNE)
+                    frRemoveFromSweepAndPrune(w->sap, proxyId);
+                else if (proxyId >= 0
+                         || frGetDynArrayValue(w->proxyIds, lastIndex) >= 0)
+                    /*
+                        NOTE: The static layer of the spatial hash refers to
+                        the sleeping bodies by their indices.
+                    */
+                    w->staticDirty = true;
+
+                frSetBodySleepFlag(node.ctx, NULL);
+
+                frRemoveFromBodyStorage(w->storage, node.ctx);
 
-                        frSetDynArrayLength(w->bodies,
-                                            frGetDynArrayLength(w->bodies) - 1);
+                frDynArraySwap(frBody *, w->bodies, i, lastIndex);
+                frDynArraySwap(int, w->proxyIds, i, lastIndex);
 
-                        break;
-                    }
+                frSetDynArrayLength(w->bodies, lastIndex);
+                frSetDynArrayLength(w->proxyIds, lastIndex);
+
+                // NOTE: The last body has been moved to `i`
+                if (i < lastIndex) {
+                    proxyId = frGetDynArrayValue(w->proxyIds, i);
+
+                    if (w->broadPhaseType == FR_BROAD_PHASE_DYNAMIC_TREE)
+                        frSetDynamicTreeValue(w->tree, proxyId, i);
+                    else if (w->broadPhaseType
+                             == FR_BROAD_PHASE_SWEEP_AND_PRUNE)
+                        frSetSweepAndPruneValue(w->sap, proxyId, i);
+                }
+
+                removedCount++;
 
                 break;
+            }
 
             default:
                 break;
         }
     }
 
-    for (int i = 0; i < frGetDynArrayLength(w->bodies); i++)
-        frClearBodyForces(frGetDynArrayValue(w->bodies, i));
+    /*
+        NOTE: The contact cache is updated once for all removed bodies,
+        so removing `k` bodies costs `O(k + P)` instead of `O(k * P)`,
+        where `P` is the number of pairs.
+    */
+    if (removedCount > 0) frRemoveStalePairsFromWorld(w);
+}
 
-    frClearSpatialHash(w->hash);
+/* 
+    Clears the accumulated forces on each body in `w`, 
+    then updates the broad-phase data of `w`. 
+*/
+static void frPostStepWorld(frWorld *w) {
+    frApplyWorldOperations(w);
+
+    frClearBodyStorageForces(w->storage);
+
+    frBeginWorldTimer(broadPhaseTimer);
+
+    /*
+        NOTE: The broad-phase data will be kept until the next step,
+        so that it can be shared by `frPreStepWorld()` and all raycasts.
+    */
+    frUpdateWorldBroadPhase(w);
+
+    frEndWorldTimer(w, broadPhaseTimer, broadPhaseTime);
 }
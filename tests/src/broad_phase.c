@@ -27,22 +27,547 @@
 
 /* Macros =================================================================> */
 
-/* TODO: ... */
+#define AABB_COUNT  ((1 << 6) + 1)
 
 /* Constants ==============================================================> */
 
-/* TODO: ... */
+static const float CELL_SIZE = 2.0f;
+
+static const float TREE_MARGIN = 0.1f;
+
+/* Private Variables ======================================================> */
+
+static frAABB aabbs[AABB_COUNT];
+
+static int queryCount, pairCount;
+
+static int queryResults[AABB_COUNT], closestIndex;
+
+static frRay queryRay;
+
+static bool closestHit;
 
 /* Private Function Prototypes ============================================> */
 
-/* TODO: ... */
+TEST utDynamicTreeOps(void);
+
+TEST utDynamicTreeBulkOps(void);
+
+TEST utSpatialHashOps(void);
+
+TEST utSpatialHashRaycast(void);
+
+TEST utSweepAndPruneOps(void);
+
+static void InitAABBs(void);
+
+static bool AABBsOverlap(frAABB a1, frAABB a2);
+
+static float RaycastAABB(frRay ray, frAABB aabb);
+
+static frAABB CellifyAABB(frAABB aabb);
+
+static frAABB FattenAABB(frAABB aabb, float margin);
+
+static bool OnQuery(frContextNode ctxNode);
+
+static void OnPairQuery(int first, int second, void *ctx);
+
+static float OnRaycastQuery(frContextNode ctxNode, float maxDistance);
 
 /* Public Functions =======================================================> */
 
 SUITE(broad_phase) {
-    /* TODO: ... */
+    RUN_TEST(utDynamicTreeOps);
+    RUN_TEST(utDynamicTreeBulkOps);
+    RUN_TEST(utSpatialHashOps);
+    RUN_TEST(utSpatialHashRaycast);
+    RUN_TEST(utSweepAndPruneOps);
 }
 
 /* Private Functions ======================================================> */
 
-/* TODO: ... */
+TEST utDynamicTreeOps(void) {
+    frDynamicTree *dt = frCreateDynamicTree(TREE_MARGIN);
+
+    int proxyIds[AABB_COUNT];
+
+    InitAABBs();
+
+    for (int i = 0; i < AABB_COUNT; i++)
+        proxyIds[i] = frInsertIntoDynamicTree(dt, aabbs[i], i);
+
+    {
+        int expectedCount = 0;
+
+        for (int i = 0; i < AABB_COUNT; i++)
+            for (int j = i + 1; j < AABB_COUNT; j++)
+                if (AABBsOverlap(FattenAABB(aabbs[i], TREE_MARGIN),
+                                 FattenAABB(aabbs[j], TREE_MARGIN)))
+                    expectedCount++;
+
+        pairCount = 0;
+
+        frQueryDynamicTreePairs(dt, OnPairQuery, NULL);
+
+        ASSERT_EQ(expectedCount, pairCount);
+
+        pairCount = 0;
+
+        frQueryDynamicTreePairs(dt, OnPairQuery, NULL);
+
+        ASSERT_EQ(0, pairCount);
+    }
+
+    {
+        frAABB queryAABB = {
+            .x = 4.0f, .y = 4.0f, .width = 6.0f, .height = 6.0f
+        };
+
+        int expectedCount = 0;
+
+        for (int i = 0; i < AABB_COUNT; i++)
+            if (AABBsOverlap(FattenAABB(aabbs[i], TREE_MARGIN), queryAABB))
+                expectedCount++;
+
+        queryCount = 0;
+
+        frQueryDynamicTree(dt, queryAABB, OnQuery, NULL);
+
+        ASSERT_EQ(expectedCount, queryCount);
+    }
+
+    {
+        frAABB aabb = aabbs[0];
+
+        aabb.x += 0.5f * TREE_MARGIN;
+
+        ASSERT_EQ(false, frUpdateDynamicTree(dt, proxyIds[0], aabb));
+
+        aabb.x += 2.0f * TREE_MARGIN;
+
+        ASSERT_EQ(true, frUpdateDynamicTree(dt, proxyIds[0], aabb));
+
+        for (int i = 1; i < AABB_COUNT; i += 2)
+            frRemoveFromDynamicTree(dt, proxyIds[i]);
+
+        frAABB queryAABB = { .width = 32.0f, .height = 32.0f };
+
+        queryCount = 0;
+
+        frQueryDynamicTree(dt, queryAABB, OnQuery, NULL);
+
+        ASSERT_EQ((AABB_COUNT + 1) >> 1, queryCount);
+    }
+
+    frReleaseDynamicTree(dt);
+
+    PASS();
+}
+
+TEST utDynamicTreeBulkOps(void) {
+    frDynamicTree *dt = frCreateDynamicTree(TREE_MARGIN);
+
+    int values[AABB_COUNT], proxyIds[AABB_COUNT];
+
+    InitAABBs();
+
+    for (int i = 0; i < AABB_COUNT; i++)
+        values[i] = i;
+
+    // NOTE: The first batch is built top-down, and the second is inserted
+    frInsertManyIntoDynamicTree(dt, aabbs, values, AABB_COUNT - 4, proxyIds);
+
+    frInsertManyIntoDynamicTree(dt,
+                                aabbs + (AABB_COUNT - 4),
+                                values + (AABB_COUNT - 4),
+                                4,
+                                proxyIds + (AABB_COUNT - 4));
+
+    {
+        int expectedCount = 0;
+
+        for (int i = 0; i < AABB_COUNT; i++)
+            for (int j = i + 1; j < AABB_COUNT; j++)
+                if (AABBsOverlap(FattenAABB(aabbs[i], TREE_MARGIN),
+                                 FattenAABB(aabbs[j], TREE_MARGIN)))
+                    expectedCount++;
+
+        pairCount = 0;
+
+        frQueryDynamicTreePairs(dt, OnPairQuery, NULL);
+
+        ASSERT_EQ(expectedCount, pairCount);
+    }
+
+    {
+        for (int i = 1; i < AABB_COUNT; i += 2)
+            frRemoveFromDynamicTree(dt, proxyIds[i]);
+
+        frAABB queryAABB = { .width = 32.0f, .height = 32.0f };
+
+        queryCount = 0;
+
+        frQueryDynamicTree(dt, queryAABB, OnQuery, NULL);
+
+        ASSERT_EQ((AABB_COUNT + 1) >> 1, queryCount);
+    }
+
+    frReleaseDynamicTree(dt);
+
+    PASS();
+}
+
+TEST utSpatialHashOps(void) {
+    frSpatialHash *sh = frCreateSpatialHash(CELL_SIZE);
+
+    InitAABBs();
+
+    for (int i = 0; i < AABB_COUNT; i++)
+        frInsertIntoSpatialHash(sh, aabbs[i], i);
+
+    frAABB queryAABB = { .x = 4.0f, .y = 4.0f, .width = 6.0f, .height = 6.0f };
+
+    // NOTE: Each object must be reported only once, even if it spans many cells
+    for (int k = 0; k < 2; k++) {
+        int expectedCount = 0;
+
+        for (int i = 0; i < AABB_COUNT; i++)
+            if (AABBsOverlap(CellifyAABB(aabbs[i]), CellifyAABB(queryAABB)))
+                expectedCount++;
+
+        queryCount = 0;
+
+        frQuerySpatialHash(sh, queryAABB, OnQuery, NULL);
+
+        ASSERT_EQ(expectedCount, queryCount);
+    }
+
+    {
+        int expectedCount = 0;
+
+        for (int i = 0; i < AABB_COUNT; i++)
+            for (int j = i + 1; j < AABB_COUNT; j++)
+                if (AABBsOverlap(CellifyAABB(aabbs[i]), CellifyAABB(aabbs[j])))
+                    expectedCount++;
+
+        pairCount = 0;
+
+        frQuerySpatialHashPairs(sh, OnPairQuery, NULL);
+
+        ASSERT_EQ(expectedCount, pairCount);
+    }
+
+    {
+        frClearSpatialHash(sh);
+
+        for (int i = 0; i < AABB_COUNT / 2; i++)
+            frInsertIntoSpatialHash(sh, aabbs[i], i);
+
+        frMarkSpatialHashStatic(sh);
+
+        frAABB queryAABB = { .width = 32.0f, .height = 32.0f };
+
+        int expectedCount = 0;
+
+        // NOTE: The pairs of two static elements must not be reported
+        for (int i = 0; i < AABB_COUNT; i++)
+            for (int j = AABB_COUNT / 2; j < AABB_COUNT; j++)
+                if (i < j
+                    && AABBsOverlap(CellifyAABB(aabbs[i]),
+                                    CellifyAABB(aabbs[j])))
+                    expectedCount++;
+
+        // NOTE: The static elements must be kept by every step
+        for (int k = 0; k < 4; k++) {
+            frClearSpatialHashDynamic(sh);
+
+            if (k & 1) {
+                queryCount = pairCount = 0;
+
+                frQuerySpatialHash(sh, queryAABB, OnQuery, NULL);
+                frQuerySpatialHashPairs(sh, OnPairQuery, NULL);
+
+                ASSERT_EQ(AABB_COUNT / 2, queryCount);
+                ASSERT_EQ(0, pairCount);
+
+                continue;
+            }
+
+            for (int i = AABB_COUNT / 2; i < AABB_COUNT; i++)
+                frInsertIntoSpatialHash(sh, aabbs[i], i);
+
+            pairCount = 0;
+
+            frQuerySpatialHashPairs(sh, OnPairQuery, NULL);
+
+            ASSERT_EQ(expectedCount, pairCount);
+        }
+    }
+
+    frReleaseSpatialHash(sh);
+
+    PASS();
+}
+
+TEST utSpatialHashRaycast(void) {
+    frSpatialHash *sh = frCreateSpatialHash(CELL_SIZE);
+
+    InitAABBs();
+
+    for (int i = 0; i < AABB_COUNT; i++)
+        frInsertIntoSpatialHash(sh, aabbs[i], i);
+
+    const frRay rays[] = {
+        { .origin = { .x = -8.0f, .y = -4.0f },
+          .direction = { .x = 1.0f, .y = 0.75f },
+          .maxDistance = 64.0f },
+        { .origin = { .x = 12.0f, .y = 40.0f },
+          .direction = { .x = 0.0f, .y = -1.0f },
+          .maxDistance = 64.0f },
+        { .origin = { .x = 5.5f, .y = 5.5f },
+          .direction = { .x = -1.0f, .y = 2.0f },
+          .maxDistance = 12.0f }
+    };
+
+    for (int i = 0, j = (sizeof rays / sizeof *rays); i < j; i++) {
+        float expectedDistance = FLT_MAX;
+
+        for (int k = 0; k < AABB_COUNT; k++) {
+            float distance = RaycastAABB(rays[i], aabbs[k]);
+
+            if (expectedDistance > distance) expectedDistance = distance;
+        }
+
+        // NOTE: Each object hit by the ray must be reported exactly once
+        {
+            for (int k = 0; k < AABB_COUNT; k++)
+                queryResults[k] = 0;
+
+            queryRay = rays[i], closestHit = false;
+
+            frRaycastSpatialHash(sh, rays[i], OnRaycastQuery, NULL);
+
+            for (int k = 0; k < AABB_COUNT; k++) {
+                ASSERT_LT(queryResults[k], 2);
+
+                if (RaycastAABB(rays[i], aabbs[k]) < FLT_MAX)
+                    ASSERT_EQ(1, queryResults[k]);
+            }
+        }
+
+        {
+            queryRay = rays[i], closestHit = true, closestIndex = -1;
+
+            frRaycastSpatialHash(sh, rays[i], OnRaycastQuery, NULL);
+
+            ASSERT(closestIndex >= 0 || expectedDistance == FLT_MAX);
+
+            if (closestIndex >= 0)
+                ASSERT_IN_RANGE(expectedDistance,
+                                RaycastAABB(rays[i], aabbs[closestIndex]),
+                                FLT_EPSILON);
+        }
+    }
+
+    frReleaseSpatialHash(sh);
+
+    PASS();
+}
+
+TEST utSweepAndPruneOps(void) {
+    frSweepAndPrune *sap = frCreateSweepAndPrune();
+
+    int proxyIds[AABB_COUNT];
+
+    InitAABBs();
+
+    for (int i = 0; i < AABB_COUNT; i++)
+        proxyIds[i] = frInsertIntoSweepAndPrune(sap, aabbs[i], i);
+
+    frSortSweepAndPrune(sap);
+
+    {
+        int expectedCount = 0;
+
+        for (int i = 0; i < AABB_COUNT; i++)
+            for (int j = i + 1; j < AABB_COUNT; j++)
+                if (AABBsOverlap(aabbs[i], aabbs[j])) expectedCount++;
+
+        pairCount = 0;
+
+        frQuerySweepAndPrunePairs(sap, OnPairQuery, NULL);
+
+        ASSERT_EQ(expectedCount, pairCount);
+
+        pairCount = 0;
+
+        frQuerySweepAndPrunePairs(sap, OnPairQuery, NULL);
+
+        ASSERT_EQ(expectedCount, pairCount);
+    }
+
+    {
+        for (int i = 0; i < AABB_COUNT; i++) {
+            aabbs[i].x = 24.0f - aabbs[i].x;
+
+            frUpdateSweepAndPrune(sap, proxyIds[i], aabbs[i]);
+        }
+
+        frSortSweepAndPrune(sap);
+
+        int expectedCount = 0;
+
+        for (int i = 0; i < AABB_COUNT; i++)
+            for (int j = i + 1; j < AABB_COUNT; j++)
+                if (AABBsOverlap(aabbs[i], aabbs[j])) expectedCount++;
+
+        pairCount = 0;
+
+        frQuerySweepAndPrunePairs(sap, OnPairQuery, NULL);
+
+        ASSERT_EQ(expectedCount, pairCount);
+    }
+
+    {
+        frAABB queryAABB = {
+            .x = 4.0f, .y = 4.0f, .width = 6.0f, .height = 6.0f
+        };
+
+        int expectedCount = 0;
+
+        for (int i = 0; i < AABB_COUNT; i++)
+            if (AABBsOverlap(aabbs[i], queryAABB)) expectedCount++;
+
+        queryCount = 0;
+
+        frQuerySweepAndPrune(sap, queryAABB, OnQuery, NULL);
+
+        ASSERT_EQ(expectedCount, queryCount);
+    }
+
+    {
+        for (int i = 1; i < AABB_COUNT; i += 2)
+            frRemoveFromSweepAndPrune(sap, proxyIds[i]);
+
+        frAABB queryAABB = { .width = 32.0f, .height = 32.0f };
+
+        queryCount = 0;
+
+        frQuerySweepAndPrune(sap, queryAABB, OnQuery, NULL);
+
+        // NOTE: The removed elements must be skipped before the next sort
+        ASSERT_EQ((AABB_COUNT + 1) >> 1, queryCount);
+
+        frSortSweepAndPrune(sap);
+
+        queryCount = 0;
+
+        frQuerySweepAndPrune(sap, queryAABB, OnQuery, NULL);
+
+        ASSERT_EQ((AABB_COUNT + 1) >> 1, queryCount);
+
+        int proxyId = frInsertIntoSweepAndPrune(sap, aabbs[1], 1);
+
+        ASSERT_EQ(proxyIds[AABB_COUNT - 2], proxyId);
+    }
+
+    frReleaseSweepAndPrune(sap);
+
+    PASS();
+}
+
+static void InitAABBs(void) {
+    unsigned int seed = 0x5EEDu;
+
+    for (int i = 0; i < AABB_COUNT; i++) {
+        // NOTE: https://en.wikipedia.org/wiki/Linear_congruential_generator
+        seed = (1103515245u * seed) + 12345u;
+
+        aabbs[i].x = (float) ((seed >> 16) % 24);
+
+        seed = (1103515245u * seed) + 12345u;
+
+        aabbs[i].y = (float) ((seed >> 16) % 24);
+
+        aabbs[i].width = 1.0f + (i % 3), aabbs[i].height = 1.0f + (i % 2);
+    }
+}
+
+static bool AABBsOverlap(frAABB a1, frAABB a2) {
+    return (a1.x <= a2.x + a2.width && a2.x <= a1.x + a1.width)
+           && (a1.y <= a2.y + a2.height && a2.y <= a1.y + a1.height);
+}
+
+static float RaycastAABB(frRay ray, frAABB aabb) {
+    frVector2 direction = frVector2Normalize(ray.direction);
+
+    float minBounds[2] = { aabb.x, aabb.y };
+    float maxBounds[2] = { aabb.x + aabb.width, aabb.y + aabb.height };
+
+    float origin[2] = { ray.origin.x, ray.origin.y };
+    float delta[2] = { direction.x, direction.y };
+
+    float minDistance = 0.0f, maxDistance = ray.maxDistance;
+
+    for (int i = 0; i < 2; i++) {
+        if (delta[i] == 0.0f) {
+            if (origin[i] < minBounds[i] || origin[i] > maxBounds[i])
+                return FLT_MAX;
+        } else {
+            float t1 = (minBounds[i] - origin[i]) / delta[i];
+            float t2 = (maxBounds[i] - origin[i]) / delta[i];
+
+            minDistance = fmaxf(minDistance, fminf(t1, t2));
+            maxDistance = fminf(maxDistance, fmaxf(t1, t2));
+        }
+    }
+
+    return (minDistance <= maxDistance) ? minDistance : FLT_MAX;
+}
+
+static frAABB CellifyAABB(frAABB aabb) {
+    int minX = floorf(aabb.x / CELL_SIZE), minY = floorf(aabb.y / CELL_SIZE);
+
+    int maxX = floorf((aabb.x + aabb.width) / CELL_SIZE);
+    int maxY = floorf((aabb.y + aabb.height) / CELL_SIZE);
+
+    // NOTE: Two cell ranges overlap if and only if these AABBs overlap
+    return (frAABB) { .x = minX,
+                      .y = minY,
+                      .width = maxX - minX,
+                      .height = maxY - minY };
+}
+
+static frAABB FattenAABB(frAABB aabb, float margin) {
+    return (frAABB) { .x = aabb.x - margin,
+                      .y = aabb.y - margin,
+                      .width = aabb.width + (2.0f * margin),
+                      .height = aabb.height + (2.0f * margin) };
+}
+
+static bool OnQuery(frContextNode ctxNode) {
+    queryCount++;
+
+    return true;
+}
+
+static void OnPairQuery(int first, int second, void *ctx) {
+    if (first != second) pairCount++;
+}
+
+static float OnRaycastQuery(frContextNode ctxNode, float maxDistance) {
+    if (!closestHit) {
+        queryResults[ctxNode.id]++;
+
+        return maxDistance;
+    }
+
+    float distance = RaycastAABB(queryRay, aabbs[ctxNode.id]);
+
+    if (distance > maxDistance) return maxDistance;
+
+    closestIndex = ctxNode.id;
+
+    return distance;
+}
@@ -32,6 +32,8 @@
 TEST utCircleVsCircle(void);
 TEST utCircleVsPolygon(void);
 TEST utPolygonVsPolygon(void);
+TEST utPolygonRaycast(void);
+TEST utTimeOfImpact(void);
 
 /* Public Functions =======================================================> */
 
@@ -39,6 +41,8 @@ SUITE(collision) {
     RUN_TEST(utCircleVsCircle);
     RUN_TEST(utCircleVsPolygon);
     RUN_TEST(utPolygonVsPolygon);
+    RUN_TEST(utPolygonRaycast);
+    RUN_TEST(utTimeOfImpact);
 }
 
 /* Private Functions ======================================================> */
@@ -204,4 +208,102 @@ TEST utPolygonVsPolygon(void) {
     /* TODO: ... */
 
     PASS();
-}
\ No newline at end of file
+}
+
+TEST utPolygonRaycast(void) {
+    frShape *s = frCreateRectangle(frStructZero(frMaterial), 2.0f, 2.0f);
+
+    frBody *b = frCreateBodyFromShape(FR_BODY_STATIC,
+                                      (frVector2) { .x = 4.0f },
+                                      s);
+
+    frRaycastHit raycastHit = { .distance = 0.0f };
+
+    {
+        frRay ray = { .direction = { .x = 2.0f }, .maxDistance = 8.0f };
+
+        ASSERT(frComputeRaycast(b, ray, &raycastHit));
+
+        ASSERT_EQ(b, raycastHit.body);
+        ASSERT_EQ(false, raycastHit.inside);
+
+        ASSERT_IN_RANGE(3.0f, raycastHit.distance, FLT_EPSILON);
+
+        ASSERT_IN_RANGE(3.0f, raycastHit.point.x, FLT_EPSILON);
+        ASSERT_IN_RANGE(0.0f, raycastHit.point.y, FLT_EPSILON);
+
+        ASSERT_IN_RANGE(-1.0f, raycastHit.normal.x, FLT_EPSILON);
+        ASSERT_IN_RANGE(0.0f, raycastHit.normal.y, FLT_EPSILON);
+    }
+
+    {
+        frRay ray = { .direction = { .x = 1.0f }, .maxDistance = 2.5f };
+
+        ASSERT_FALSE(frComputeRaycast(b, ray, &raycastHit));
+
+        ray.direction = (frVector2) { .x = -1.0f }, ray.maxDistance = 8.0f;
+
+        ASSERT_FALSE(frComputeRaycast(b, ray, &raycastHit));
+    }
+
+    {
+        frRay ray = { .origin = { .x = 4.0f },
+                      .direction = { .x = 1.0f },
+                      .maxDistance = 8.0f };
+
+        ASSERT_FALSE(frComputeRaycast(b, ray, &raycastHit));
+
+        ASSERT_EQ(true, raycastHit.inside);
+    }
+
+    {
+        frSetBodyAngle(b, 0.25f * (float) M_PI);
+
+        frRay ray = { .direction = { .x = 1.0f }, .maxDistance = 8.0f };
+
+        ASSERT(frComputeRaycast(b, ray, &raycastHit));
+
+        ASSERT_IN_RANGE(4.0f - sqrtf(2.0f), raycastHit.distance, 0.0001f);
+    }
+
+    frReleaseShape(s), frReleaseBody(b);
+
+    PASS();
+}
+
+TEST utTimeOfImpact(void) {
+    frShape *s1 = frCreateCircle(frStructZero(frMaterial), 0.5f);
+    frShape *s2 = frCreateRectangle(frStructZero(frMaterial), 1.0f, 8.0f);
+
+    frBody *b1 = frCreateBodyFromShape(FR_BODY_DYNAMIC,
+                                       frStructZero(frVector2),
+                                       s1);
+
+    frBody *b2 = frCreateBodyFromShape(FR_BODY_STATIC,
+                                       (frVector2) { .x = 5.0f },
+                                       s2);
+
+    frSetBodyVelocity(b1, (frVector2) { .x = 10.0f });
+
+    // NOTE: `b1` must stop about half of the slop into `b2`
+    {
+        float toi1 = 1.0f, toi2 = 1.0f;
+
+        ASSERT(frComputeTimeOfImpact(b1, b2, 1.0f, 0.1f, &toi1));
+        ASSERT(frComputeTimeOfImpact(b1, b2, 1.0f, 0.5f, &toi2));
+
+        ASSERT_IN_RANGE(0.405f, toi1, 0.0025f);
+        ASSERT_IN_RANGE(0.425f, toi2, 0.0125f);
+    }
+
+    {
+        frSetBodyVelocity(b1, (frVector2) { .x = -10.0f });
+
+        ASSERT_FALSE(frComputeTimeOfImpact(b1, b2, 1.0f, 0.1f, NULL));
+    }
+
+    frReleaseShape(s1), frReleaseBody(b1);
+    frReleaseShape(s2), frReleaseBody(b2);
+
+    PASS();
+}
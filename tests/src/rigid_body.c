@@ -25,16 +25,135 @@
 #include "ferox.h"
 #include "greatest.h"
 
+/* Macros =================================================================> */
+
+#define BODY_COUNT  100
+
+/* Constants ==============================================================> */
+
+static const frMaterial MATERIAL_BOX = { .density = 1.0f, .friction = 0.5f };
+
+/* Private Variables ======================================================> */
+
+static size_t allocatedSize;
+
 /* Private Function Prototypes ============================================> */
 
-/* TODO: ... */
+TEST utBodyHandles(void);
+
+TEST utPoolAllocator(void);
+
+static void *OnAllocate(size_t size, void *userData);
+
+static void OnDeallocate(void *ptr, size_t size, void *userData);
 
 /* Public Functions =======================================================> */
 
 SUITE(rigid_body) {
-    /* TODO: ... */
+    RUN_TEST(utBodyHandles);
+    RUN_TEST(utPoolAllocator);
 }
 
 /* Private Functions ======================================================> */
 
-/* TODO: ... */
+TEST utBodyHandles(void) {
+    frBody *bodies[BODY_COUNT];
+
+    frHandle handles[BODY_COUNT];
+
+    for (int i = 0; i < BODY_COUNT; i++) {
+        bodies[i] = frCreateBodyFromShape(
+            FR_BODY_DYNAMIC,
+            (frVector2) { .x = 1.0f * i },
+            frCreateRectangle(MATERIAL_BOX, 1.0f, 1.0f));
+
+        handles[i] = frGetBodyHandle(bodies[i]);
+
+        ASSERT_EQ(bodies[i], frGetBodyFromHandle(handles[i]));
+    }
+
+    frHandle shapeHandle = frGetShapeHandle(frGetBodyShape(bodies[0]));
+
+    ASSERT_EQ(frGetBodyShape(bodies[0]), frGetShapeFromHandle(shapeHandle));
+
+    for (int i = 0; i < BODY_COUNT; i += 2) {
+        frReleaseShape(frGetBodyShape(bodies[i]));
+        frReleaseBody(bodies[i]);
+    }
+
+    // NOTE: Handles to released bodies must be caught, even after reuse
+    for (int i = 0; i < BODY_COUNT; i += 2) {
+        frBody *body = frCreateBody(FR_BODY_STATIC, frStructZero(frVector2));
+
+        ASSERT_EQ(NULL, frGetBodyFromHandle(handles[i]));
+
+        frReleaseBody(body);
+    }
+
+    ASSERT_EQ(NULL, frGetShapeFromHandle(shapeHandle));
+
+    for (int i = 1; i < BODY_COUNT; i += 2) {
+        ASSERT_EQ(bodies[i], frGetBodyFromHandle(handles[i]));
+
+        frReleaseShape(frGetBodyShape(bodies[i]));
+        frReleaseBody(bodies[i]);
+    }
+
+    ASSERT_EQ(NULL, frGetBodyFromHandle(frStructZero(frHandle)));
+
+    PASS();
+}
+
+TEST utPoolAllocator(void) {
+    frSetAllocator(&(const frAllocator) { .allocate = OnAllocate,
+                                          .deallocate = OnDeallocate });
+
+    frPool *pool = frCreatePool(sizeof(double));
+
+    frSetAllocator(NULL);
+
+    void *blocks[BODY_COUNT];
+
+    for (int i = 0; i < BODY_COUNT; i++) {
+        blocks[i] = frAllocateFromPool(pool);
+
+        ASSERT_EQ(0.0, *(double *) blocks[i]);
+
+        *(double *) blocks[i] = i;
+    }
+
+    ASSERT_EQ(BODY_COUNT, frGetPoolBlockCount(pool));
+    ASSERT_GT(allocatedSize, BODY_COUNT * sizeof(double));
+
+    size_t oldAllocatedSize = allocatedSize;
+
+    // NOTE: Freed blocks must be reused without allocating any more memory
+    for (int i = 0; i < BODY_COUNT; i++) {
+        frFreeToPool(pool, blocks[i]);
+
+        blocks[i] = frAllocateFromPool(pool);
+    }
+
+    frFreeToPool(pool, blocks[0]), frFreeToPool(pool, blocks[0]);
+
+    ASSERT_EQ(BODY_COUNT - 1, frGetPoolBlockCount(pool));
+    ASSERT_EQ(oldAllocatedSize, allocatedSize);
+
+    frReleasePool(pool);
+
+    ASSERT_EQ(0, allocatedSize);
+
+    PASS();
+}
+
+static void *OnAllocate(size_t size, void *userData) {
+    allocatedSize += size;
+
+    return malloc(size);
+}
+
+static void OnDeallocate(void *ptr, size_t size, void *userData) {
+    allocatedSize -= size;
+
+    free(ptr);
+}
@@ -117,6 +117,29 @@ TEST utRingBufferOps(void) {
             ASSERT_EQ(0, node.id & 1);
     }
 
+    {
+        frContextNode node = { .id = -1 };
+
+        // NOTE: The values that wrapped around must keep their order
+        for (int i = 0; i < (RING_BUFFER_LENGTH >> 1); i++) {
+            node.id = i;
+
+            ASSERT_EQ(true, frAddToRingBuffer(rbf, node));
+            ASSERT_EQ(true, frRemoveFromRingBuffer(rbf, &node));
+        }
+
+        for (int i = 0; i < (RING_BUFFER_LENGTH << 2); i++) {
+            node.id = i;
+
+            if (frIsRingBufferFull(rbf)) frGrowRingBuffer(rbf);
+
+            ASSERT_EQ(true, frAddToRingBuffer(rbf, node));
+        }
+
+        for (int i = 0; frRemoveFromRingBuffer(rbf, &node); i++)
+            ASSERT_EQ(i, node.id);
+    }
+
     frReleaseRingBuffer(rbf);
 
     PASS();
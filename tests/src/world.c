@@ -22,23 +22,1217 @@
 
 /* Includes ===============================================================> */
 
+#include <float.h>
+
 #include "ferox.h"
 #include "greatest.h"
 
+/* Macros =================================================================> */
+
+#define BOX_COUNT          8
+#define ROW_COUNT          16
+#define SLIDING_ROW_COUNT  3
+#define STEP_COUNT         240
+#define RAY_COUNT          64
+
 /* Constants ==============================================================> */
 
-/* TODO: ... */
+static const frMaterial MATERIAL_BOX = { .density = 1.0f, .friction = 0.5f };
+
+static const float CELL_SIZE = 2.0f, DELTA_TIME = 1.0f / 60.0f;
+
+/* Private Variables ======================================================> */
+
+static float minDistance;
 
 /* Private Function Prototypes ============================================> */
 
-/* TODO: ... */
+TEST utBroadPhaseTypes(void);
+
+TEST utWorldRaycast(void);
+
+TEST utWorldRaycastDeferred(void);
+
+TEST utWorldRaycastBatch(void);
+
+TEST utWorldSleeping(void);
+
+TEST utWorldThreads(void);
+
+TEST utWorldGraphColoring(void);
+
+TEST utWorldFriction(void);
+
+TEST utWorldWideSolver(void);
+
+TEST utWorldBodyStorage(void);
+
+TEST utWorldBatchRemove(void);
+
+TEST utWorldCapacity(void);
+
+TEST utWorldBatchAdd(void);
+
+TEST utWorldStats(void);
+
+TEST utWorldBullets(void);
+
+TEST utWorldSpeculativeContacts(void);
+
+TEST utWorldSoftStep(void);
+
+TEST utWorldSolverParams(void);
+
+static frWorld *CreateBoxStack(frBroadPhaseType type, int boxCount);
+
+static frWorld *CreateBoxPyramid(frSolverType type, int threadCount);
+
+static frWorld *CreateBoxOnSlope(float angle, float friction);
+
+static frWorld *CreateSlidingPyramid(frSolverType type, int rowCount);
+
+static void OnRaycastQuery(frRaycastHit raycastHit, void *ctx);
 
 /* Public Functions =======================================================> */
 
 SUITE(world) {
-    /* TODO: ... */
+    RUN_TEST(utBroadPhaseTypes);
+    RUN_TEST(utWorldRaycast);
+    RUN_TEST(utWorldRaycastDeferred);
+    RUN_TEST(utWorldRaycastBatch);
+    RUN_TEST(utWorldSleeping);
+    RUN_TEST(utWorldThreads);
+    RUN_TEST(utWorldGraphColoring);
+    RUN_TEST(utWorldFriction);
+    RUN_TEST(utWorldWideSolver);
+    RUN_TEST(utWorldBodyStorage);
+    RUN_TEST(utWorldBatchRemove);
+    RUN_TEST(utWorldCapacity);
+    RUN_TEST(utWorldBatchAdd);
+    RUN_TEST(utWorldStats);
+    RUN_TEST(utWorldBullets);
+    RUN_TEST(utWorldSpeculativeContacts);
+    RUN_TEST(utWorldSoftStep);
+    RUN_TEST(utWorldSolverParams);
+}
+
+TEST utWorldBullets(void) {
+    const frBroadPhaseType types[] = { FR_BROAD_PHASE_SPATIAL_HASH,
+                                       FR_BROAD_PHASE_DYNAMIC_TREE,
+                                       FR_BROAD_PHASE_SWEEP_AND_PRUNE };
+
+    // NOTE: Each body moves 10 meters per step, much farther than its size
+    const frVector2 velocity = { .x = 600.0f };
+
+    for (int i = 0, j = (sizeof types / sizeof *types); i < j; i++) {
+        frWorld *world = frCreateWorld(frStructZero(frVector2), CELL_SIZE);
+
+        frSetWorldBroadPhaseType(world, types[i]);
+
+        frBody *wall = frCreateBodyFromShape(
+            FR_BODY_STATIC,
+            (frVector2) { .x = 15.0f },
+            frCreateRectangle(MATERIAL_BOX, 0.1f, 8.0f));
+
+        frBody *bullets[] = {
+            frCreateBodyFromShape(FR_BODY_DYNAMIC,
+                                  (frVector2) { .y = -2.0f },
+                                  frCreateRectangle(MATERIAL_BOX,
+                                                    0.25f,
+                                                    0.25f)),
+            frCreateBodyFromShape(FR_BODY_DYNAMIC,
+                                  frStructZero(frVector2),
+                                  frCreateCircle(MATERIAL_BOX, 0.125f)),
+            frCreateBodyFromShape(FR_BODY_DYNAMIC,
+                                  (frVector2) { .y = 2.0f },
+                                  frCreateRectangle(MATERIAL_BOX,
+                                                    0.25f,
+                                                    0.25f))
+        };
+
+        const int bulletCount = sizeof bullets / sizeof *bullets;
+
+        ASSERT(frAddBodyToWorld(world, wall));
+
+        for (int k = 0; k < bulletCount; k++) {
+            // NOTE: The last body is not a 'bullet' body
+            if (k < bulletCount - 1) frSetBodyFlags(bullets[k], FR_FLAG_BULLET);
+
+            frSetBodyVelocity(bullets[k], velocity);
+
+            ASSERT(frAddBodyToWorld(world, bullets[k]));
+        }
+
+        for (int k = 0; k < 30; k++)
+            frStepWorld(world, DELTA_TIME);
+
+        for (int k = 0; k < bulletCount - 1; k++) {
+            frVector2 position = frGetBodyPosition(bullets[k]);
+
+            ASSERT_LT(position.x, 15.0f);
+            ASSERT_GT(position.x, 14.5f);
+        }
+
+        // NOTE: Only the 'bullet' bodies should be stopped by the wall
+        ASSERT_GT(frGetBodyPosition(bullets[bulletCount - 1]).x, 15.0f);
+
+        for (int k = 0; k < frGetBodyCountInWorld(world); k++)
+            frReleaseShape(frGetBodyShape(frGetBodyInWorld(world, k)));
+
+        frReleaseWorld(world);
+    }
+
+    PASS();
+}
+
+TEST utWorldSpeculativeContacts(void) {
+    // NOTE: Each body moves 1.67 meters per step, much farther than its size
+    const frVector2 velocity = { .y = 50.0f };
+
+    const float deltaTime = 1.0f / 30.0f;
+
+    for (int i = 0; i < 2; i++) {
+        frWorld *world = frCreateWorld(FR_WORLD_DEFAULT_GRAVITY, CELL_SIZE);
+
+        frSetWorldSpeculativeContacts(world, i > 0);
+
+        ASSERT_EQ(i > 0, frGetWorldSpeculativeContacts(world));
+
+        frBody *ground = frCreateBodyFromShape(
+            FR_BODY_STATIC,
+            (frVector2) { .x = 20.0f, .y = 10.0f },
+            frCreateRectangle(MATERIAL_BOX, 48.0f, 0.2f));
+
+        ASSERT(frAddBodyToWorld(world, ground));
+
+        for (int k = 0; k < ROW_COUNT; k++) {
+            frVector2 position = { .x = 2.5f * k, .y = -0.37f * k };
+
+            frShape *s = (k & 1) ? frCreateCircle(MATERIAL_BOX, 0.25f)
+                                 : frCreateRectangle(MATERIAL_BOX,
+                                                     0.5f,
+                                                     0.5f);
+
+            frBody *b = frCreateBodyFromShape(FR_BODY_DYNAMIC, position, s);
+
+            frSetBodyVelocity(b, velocity);
+
+            ASSERT(frAddBodyToWorld(world, b));
+        }
+
+        for (int k = 0; k < STEP_COUNT; k++)
+            frStepWorld(world, deltaTime);
+
+        int tunneledCount = 0;
+
+        for (int k = 0; k < frGetBodyCountInWorld(world); k++) {
+            frBody *b = frGetBodyInWorld(world, k);
+
+            if (frGetBodyPosition(b).y > 10.0f) tunneledCount++;
+        }
+
+        // NOTE: No body should pass through the ground
+        if (i > 0) ASSERT_EQ(0, tunneledCount);
+        else ASSERT_GT(tunneledCount, 0);
+
+        for (int k = 0; k < frGetBodyCountInWorld(world); k++)
+            frReleaseShape(frGetBodyShape(frGetBodyInWorld(world, k)));
+
+        frReleaseWorld(world);
+    }
+
+    PASS();
+}
+
+TEST utWorldSoftStep(void) {
+    frWorld *world = CreateBoxPyramid(FR_SOLVER_SOFT_STEP, 1);
+
+    ASSERT_EQ(FR_SOLVER_SOFT_STEP, frGetWorldSolverType(world));
+
+    frSetWorldSubstepCount(world, 0);
+
+    ASSERT_EQ(FR_WORLD_SUBSTEP_COUNT, frGetWorldSubstepCount(world));
+
+    frVector2 positions[ROW_COUNT * (ROW_COUNT + 1) / 2 + 1];
+
+    for (int k = 0; k < frGetBodyCountInWorld(world); k++)
+        positions[k] = frGetBodyPosition(frGetBodyInWorld(world, k));
+
+    for (int k = 0; k < STEP_COUNT; k++)
+        frStepWorld(world, DELTA_TIME);
+
+    // NOTE: The pyramid must neither fall apart nor sink into itself
+    for (int k = 0; k < frGetBodyCountInWorld(world); k++) {
+        frVector2 position = frGetBodyPosition(frGetBodyInWorld(world, k));
+
+        ASSERT_IN_RANGE(positions[k].x, position.x, 0.1f);
+        ASSERT_IN_RANGE(positions[k].y, position.y, 0.25f);
+    }
+
+    frMaterial material = MATERIAL_BOX;
+
+    material.restitution = 0.5f;
+
+    frBody *platform = frCreateBodyFromShape(
+        FR_BODY_STATIC,
+        (frVector2) { .x = 30.0f, .y = 10.5f },
+        frCreateRectangle(material, 4.0f, 1.0f));
+
+    frBody *ball = frCreateBodyFromShape(
+        FR_BODY_DYNAMIC,
+        (frVector2) { .x = 30.0f, .y = 4.0f },
+        frCreateCircle(material, 0.5f));
+
+    ASSERT(frAddBodyToWorld(world, platform));
+    ASSERT(frAddBodyToWorld(world, ball));
+
+    bool bounced = false;
+
+    for (int k = 0; k < STEP_COUNT && !bounced; k++) {
+        frStepWorld(world, DELTA_TIME);
+
+        bounced = (frGetBodyVelocity(ball).y < -1.0f);
+    }
+
+    // NOTE: The restitution must still be applied after all sub-steps
+    ASSERT(bounced);
+
+    for (int k = 0; k < frGetBodyCountInWorld(world); k++)
+        frReleaseShape(frGetBodyShape(frGetBodyInWorld(world, k)));
+
+    frReleaseWorld(world);
+
+    PASS();
+}
+
+TEST utWorldSolverParams(void) {
+    const frSolverType types[] = { FR_SOLVER_SEQUENTIAL,
+                                   FR_SOLVER_GRAPH_COLORING,
+                                   FR_SOLVER_WIDE };
+
+    for (int i = 0, j = (sizeof types / sizeof *types); i < j; i++) {
+        frWorld *world1 = CreateBoxPyramid(types[i], 1);
+        frWorld *world2 = CreateBoxPyramid(types[i], 1);
+
+        ASSERT_EQ(FR_WORLD_ITERATION_COUNT, frGetWorldIterationCount(world1));
+        ASSERT_EQ(0.0f, frGetWorldConvergenceThreshold(world1));
+
+        frSetWorldIterationCount(world1, 0);
+        frSetWorldConvergenceThreshold(world1, -1.0f);
+
+        ASSERT_EQ(FR_WORLD_ITERATION_COUNT, frGetWorldIterationCount(world1));
+        ASSERT_EQ(0.0f, frGetWorldConvergenceThreshold(world1));
+
+        // NOTE: The solver must stop after the first iteration
+        frSetWorldConvergenceThreshold(world1, FLT_MAX);
+        frSetWorldIterationCount(world2, 1);
+
+        for (int k = 0; k < STEP_COUNT; k++) {
+            frStepWorld(world1, DELTA_TIME);
+            frStepWorld(world2, DELTA_TIME);
+
+#if FR_WORLD_ENABLE_PROFILING
+            ASSERT_EQ(1, frGetWorldStats(world1).solverIterationCount);
+#endif
+        }
+
+        for (int k = 0; k < frGetBodyCountInWorld(world1); k++) {
+            frVector2 position1 = frGetBodyPosition(
+                frGetBodyInWorld(world1, k));
+            frVector2 position2 = frGetBodyPosition(
+                frGetBodyInWorld(world2, k));
+
+            ASSERT_EQ(position1.x, position2.x);
+            ASSERT_EQ(position1.y, position2.y);
+        }
+
+        for (int k = 0; k < frGetBodyCountInWorld(world1); k++) {
+            frReleaseShape(frGetBodyShape(frGetBodyInWorld(world1, k)));
+            frReleaseShape(frGetBodyShape(frGetBodyInWorld(world2, k)));
+        }
+
+        frReleaseWorld(world1), frReleaseWorld(world2);
+    }
+
+    {
+        frWorld *world1 = CreateBoxPyramid(FR_SOLVER_SEQUENTIAL, 1);
+        frWorld *world2 = CreateBoxPyramid(FR_SOLVER_SEQUENTIAL, 1);
+
+        ASSERT_EQ(FR_WORLD_BAUMGARTE_FACTOR,
+                  frGetWorldBaumgarteFactor(world1));
+        ASSERT_EQ(FR_WORLD_BAUMGARTE_SLOP, frGetWorldBaumgarteSlop(world1));
+
+        frSetWorldBaumgarteFactor(world2, 2.0f);
+        frSetWorldBaumgarteSlop(world2, -1.0f);
+
+        ASSERT_EQ(FR_WORLD_BAUMGARTE_FACTOR,
+                  frGetWorldBaumgarteFactor(world2));
+        ASSERT_EQ(FR_WORLD_BAUMGARTE_SLOP, frGetWorldBaumgarteSlop(world2));
+
+        frSetWorldBaumgarteFactor(world2, 0.0f);
+
+        for (int k = 0; k < STEP_COUNT; k++) {
+            frStepWorld(world1, DELTA_TIME);
+            frStepWorld(world2, DELTA_TIME);
+        }
+
+        // NOTE: The boxes must sink into each other without the bias
+        frVector2 position1 = frGetBodyPosition(frGetBodyInWorld(world1, 1));
+        frVector2 position2 = frGetBodyPosition(frGetBodyInWorld(world2, 1));
+
+        ASSERT_GT(position2.y, position1.y + 0.1f);
+
+        for (int k = 0; k < frGetBodyCountInWorld(world1); k++) {
+            frReleaseShape(frGetBodyShape(frGetBodyInWorld(world1, k)));
+            frReleaseShape(frGetBodyShape(frGetBodyInWorld(world2, k)));
+        }
+
+        frReleaseWorld(world1), frReleaseWorld(world2);
+    }
+
+    PASS();
 }
 
 /* Private Functions ======================================================> */
 
-/* TODO: ... */
+TEST utBroadPhaseTypes(void) {
+    const frBroadPhaseType types[] = { FR_BROAD_PHASE_SPATIAL_HASH,
+                                       FR_BROAD_PHASE_DYNAMIC_TREE,
+                                       FR_BROAD_PHASE_SWEEP_AND_PRUNE };
+
+    for (int i = 0, j = (sizeof types / sizeof *types); i < j; i++) {
+        frWorld *world = CreateBoxStack(types[i], BOX_COUNT);
+
+        ASSERT_EQ(types[i], frGetWorldBroadPhaseType(world));
+
+        for (int k = 0; k < STEP_COUNT; k++)
+            frStepWorld(world, DELTA_TIME);
+
+        ASSERT_EQ(BOX_COUNT + 1, frGetBodyCountInWorld(world));
+
+        for (int k = 0; k < frGetBodyCountInWorld(world); k++) {
+            frBody *body = frGetBodyInWorld(world, k);
+
+            if (frGetBodyType(body) != FR_BODY_DYNAMIC) continue;
+
+            // NOTE: No box should fall through the ground (or each other)
+            ASSERT_LT(frGetBodyPosition(body).y, 10.0f);
+            ASSERT_GT(frGetBodyPosition(body).y, 10.0f - (BOX_COUNT + 1));
+        }
+
+        for (int k = 0; k < frGetBodyCountInWorld(world); k++)
+            frReleaseShape(frGetBodyShape(frGetBodyInWorld(world, k)));
+
+        frReleaseWorld(world);
+    }
+
+    PASS();
+}
+
+TEST utWorldRaycast(void) {
+    const frBroadPhaseType types[] = { FR_BROAD_PHASE_SPATIAL_HASH,
+                                       FR_BROAD_PHASE_DYNAMIC_TREE,
+                                       FR_BROAD_PHASE_SWEEP_AND_PRUNE };
+
+    const frRay ray = { .origin = { .x = 8.0f, .y = -4.0f },
+                        .direction = { .y = 1.0f },
+                        .maxDistance = 16.0f };
+
+    for (int i = 0, j = (sizeof types / sizeof *types); i < j; i++) {
+        frWorld *world1 = CreateBoxStack(types[i], BOX_COUNT);
+        frWorld *world2 = CreateBoxStack(types[i], BOX_COUNT);
+
+        for (int k = 0; k < STEP_COUNT; k++) {
+            int hitCount = 0;
+
+            minDistance = FLT_MAX;
+
+            frComputeWorldRaycast(world2, ray, OnRaycastQuery, &hitCount);
+
+            ASSERT_EQ(BOX_COUNT + 1, hitCount);
+
+            frRaycastHit raycastHit = { .distance = 0.0f };
+
+            ASSERT(frComputeWorldRaycastClosest(world2, ray, &raycastHit));
+            ASSERT_EQ(minDistance, raycastHit.distance);
+
+            ASSERT(frComputeWorldRaycastAny(world2, ray, &raycastHit));
+
+            frStepWorld(world1, DELTA_TIME);
+            frStepWorld(world2, DELTA_TIME);
+        }
+
+        // NOTE: Raycasts must not change the outcome of the simulation
+        for (int k = 0; k < frGetBodyCountInWorld(world1); k++) {
+            frVector2 position1 = frGetBodyPosition(
+                frGetBodyInWorld(world1, k));
+            frVector2 position2 = frGetBodyPosition(
+                frGetBodyInWorld(world2, k));
+
+            ASSERT_EQ(position1.x, position2.x);
+            ASSERT_EQ(position1.y, position2.y);
+        }
+
+        for (int k = 0; k < frGetBodyCountInWorld(world1); k++) {
+            frReleaseShape(frGetBodyShape(frGetBodyInWorld(world1, k)));
+            frReleaseShape(frGetBodyShape(frGetBodyInWorld(world2, k)));
+        }
+
+        frReleaseWorld(world1), frReleaseWorld(world2);
+    }
+
+    PASS();
+}
+
+TEST utWorldRaycastDeferred(void) {
+    const frBroadPhaseType types[] = { FR_BROAD_PHASE_SPATIAL_HASH,
+                                       FR_BROAD_PHASE_DYNAMIC_TREE,
+                                       FR_BROAD_PHASE_SWEEP_AND_PRUNE };
+
+    const frRay ray = { .origin = { .x = 24.0f, .y = -4.0f },
+                        .direction = { .y = 1.0f },
+                        .maxDistance = 16.0f };
+
+    for (int i = 0, j = (sizeof types / sizeof *types); i < j; i++) {
+        frWorld *world = CreateBoxStack(types[i], BOX_COUNT);
+
+        frSetBodyPosition(frGetBodyInWorld(world, 1),
+                          (frVector2) { .x = 24.0f, .y = 0.0f });
+
+        frAddBodyToWorld(world,
+                         frCreateBodyFromShape(
+                             FR_BODY_STATIC,
+                             (frVector2) { .x = 24.0f, .y = 4.0f },
+                             frCreateRectangle(MATERIAL_BOX, 1.0f, 1.0f)));
+
+        int hitCount = 0;
+
+        // NOTE: Moved or new bodies are only found after the next step
+        frComputeWorldRaycast(world, ray, OnRaycastQuery, &hitCount);
+
+        ASSERT_EQ(0, hitCount);
+
+        frStepWorld(world, DELTA_TIME);
+
+        frComputeWorldRaycast(world, ray, OnRaycastQuery, &hitCount);
+
+        ASSERT_EQ(2, hitCount);
+
+        for (int k = 0; k < frGetBodyCountInWorld(world); k++)
+            frReleaseShape(frGetBodyShape(frGetBodyInWorld(world, k)));
+
+        frReleaseWorld(world);
+    }
+
+    PASS();
+}
+
+TEST utWorldRaycastBatch(void) {
+    const frBroadPhaseType types[] = { FR_BROAD_PHASE_SPATIAL_HASH,
+                                       FR_BROAD_PHASE_DYNAMIC_TREE,
+                                       FR_BROAD_PHASE_SWEEP_AND_PRUNE };
+
+    const int threadCounts[] = { 1, 4 };
+
+    frRay rays[RAY_COUNT];
+
+    // NOTE: Some of these rays will miss all of the boxes
+    for (int i = 0; i < RAY_COUNT; i++) {
+        float angle = (2.0f * M_PI * i) / RAY_COUNT;
+
+        rays[i] = (frRay) { .origin = { .x = 8.0f + 0.25f * (i % 8),
+                                        .y = 4.0f },
+                            .direction = { .x = cosf(angle),
+                                           .y = sinf(angle) },
+                            .maxDistance = 8.0f };
+
+        // NOTE: The other half of the rays are short and start in many cells
+        if (i >= RAY_COUNT / 2) {
+            rays[i].origin = (frVector2) { .x = 6.0f + 0.5f * (i % 8),
+                                           .y = 2.0f + 2.0f * ((i / 8) % 4) };
+
+            rays[i].maxDistance = 1.5f;
+        }
+    }
+
+    for (int i = 0, j = 2 * (sizeof types / sizeof *types); i < j; i++) {
+        frWorld *world = CreateBoxStack(types[i / 2], BOX_COUNT);
+
+        frSetWorldThreadCount(world, threadCounts[i % 2]);
+
+        for (int k = 0; k < STEP_COUNT; k += 8) {
+            frRaycastHit raycastHits[RAY_COUNT];
+
+            int hitCount = frComputeWorldRaycastBatch(world,
+                                                      rays,
+                                                      raycastHits,
+                                                      RAY_COUNT);
+
+            for (int l = 0; l < RAY_COUNT; l++) {
+                frRaycastHit raycastHit = { .distance = 0.0f };
+
+                if (frComputeWorldRaycastClosest(world, rays[l], &raycastHit)) {
+                    ASSERT_EQ(raycastHit.body, raycastHits[l].body);
+                    ASSERT_EQ(raycastHit.distance, raycastHits[l].distance);
+
+                    hitCount--;
+                } else {
+                    ASSERT_EQ(NULL, raycastHits[l].body);
+                }
+            }
+
+            ASSERT_EQ(0, hitCount);
+
+            for (int l = 0; l < 8; l++)
+                frStepWorld(world, DELTA_TIME);
+        }
+
+        for (int k = 0; k < frGetBodyCountInWorld(world); k++)
+            frReleaseShape(frGetBodyShape(frGetBodyInWorld(world, k)));
+
+        frReleaseWorld(world);
+    }
+
+    PASS();
+}
+
+TEST utWorldSleeping(void) {
+    const frBroadPhaseType types[] = { FR_BROAD_PHASE_SPATIAL_HASH,
+                                       FR_BROAD_PHASE_DYNAMIC_TREE,
+                                       FR_BROAD_PHASE_SWEEP_AND_PRUNE };
+
+    for (int i = 0, j = (sizeof types / sizeof *types); i < j; i++) {
+        // NOTE: A tall stack of boxes keeps wobbling for a long time
+        frWorld *world = CreateBoxStack(types[i], BOX_COUNT / 2);
+
+        for (int k = 0; k < 4 * STEP_COUNT; k++)
+            frStepWorld(world, DELTA_TIME);
+
+        ASSERT_FALSE(frIsBodySleeping(frGetBodyInWorld(world, 0)));
+
+        for (int k = 1; k < frGetBodyCountInWorld(world); k++)
+            ASSERT(frIsBodySleeping(frGetBodyInWorld(world, k)));
+
+        frVector2 position = frGetBodyPosition(frGetBodyInWorld(world, 1));
+
+        frStepWorld(world, DELTA_TIME);
+
+        // NOTE: Sleeping bodies must not move at all
+        ASSERT_EQ(position.x, frGetBodyPosition(frGetBodyInWorld(world, 1)).x);
+        ASSERT_EQ(position.y, frGetBodyPosition(frGetBodyInWorld(world, 1)).y);
+
+        frBody *top = frGetBodyInWorld(world, BOX_COUNT / 2);
+
+        frApplyImpulseToBody(top,
+                             frGetBodyPosition(top),
+                             (frVector2) { .x = 0.5f });
+
+        ASSERT_FALSE(frIsBodySleeping(top));
+
+        frStepWorld(world, DELTA_TIME);
+
+        // NOTE: The whole stack must wake up, since it is a single island
+        for (int k = 1; k < frGetBodyCountInWorld(world); k++)
+            ASSERT_FALSE(frIsBodySleeping(frGetBodyInWorld(world, k)));
+
+        for (int k = 0; k < frGetBodyCountInWorld(world); k++)
+            frReleaseShape(frGetBodyShape(frGetBodyInWorld(world, k)));
+
+        frReleaseWorld(world);
+    }
+
+    PASS();
+}
+
+TEST utWorldThreads(void) {
+    const frBroadPhaseType types[] = { FR_BROAD_PHASE_SPATIAL_HASH,
+                                       FR_BROAD_PHASE_DYNAMIC_TREE,
+                                       FR_BROAD_PHASE_SWEEP_AND_PRUNE };
+
+    for (int i = 0, j = (sizeof types / sizeof *types); i < j; i++) {
+        frWorld *world1 = CreateBoxStack(types[i], BOX_COUNT);
+        frWorld *world2 = CreateBoxStack(types[i], BOX_COUNT);
+
+        frSetWorldThreadCount(world2, 4);
+
+        ASSERT_EQ(1, frGetWorldThreadCount(world1));
+
+        for (int k = 0; k < STEP_COUNT; k++) {
+            frStepWorld(world1, DELTA_TIME);
+            frStepWorld(world2, DELTA_TIME);
+        }
+
+        // NOTE: The number of threads must not change the outcome
+        for (int k = 0; k < frGetBodyCountInWorld(world1); k++) {
+            frVector2 position1 = frGetBodyPosition(
+                frGetBodyInWorld(world1, k));
+            frVector2 position2 = frGetBodyPosition(
+                frGetBodyInWorld(world2, k));
+
+            ASSERT_EQ(position1.x, position2.x);
+            ASSERT_EQ(position1.y, position2.y);
+        }
+
+        for (int k = 0; k < frGetBodyCountInWorld(world1); k++) {
+            frReleaseShape(frGetBodyShape(frGetBodyInWorld(world1, k)));
+            frReleaseShape(frGetBodyShape(frGetBodyInWorld(world2, k)));
+        }
+
+        frReleaseWorld(world1), frReleaseWorld(world2);
+    }
+
+    PASS();
+}
+
+TEST utWorldGraphColoring(void) {
+    frWorld *world1 = CreateBoxPyramid(FR_SOLVER_GRAPH_COLORING, 1);
+    frWorld *world2 = CreateBoxPyramid(FR_SOLVER_GRAPH_COLORING, 4);
+
+    ASSERT_EQ(FR_SOLVER_GRAPH_COLORING, frGetWorldSolverType(world1));
+
+    for (int k = 0; k < STEP_COUNT; k++) {
+        frStepWorld(world1, DELTA_TIME);
+        frStepWorld(world2, DELTA_TIME);
+    }
+
+    for (int k = 0; k < frGetBodyCountInWorld(world1); k++) {
+        frBody *body1 = frGetBodyInWorld(world1, k);
+        frBody *body2 = frGetBodyInWorld(world2, k);
+
+        frVector2 position1 = frGetBodyPosition(body1);
+        frVector2 position2 = frGetBodyPosition(body2);
+
+        // NOTE: The number of threads must not change the outcome
+        ASSERT_EQ(position1.x, position2.x);
+        ASSERT_EQ(position1.y, position2.y);
+
+        if (frGetBodyType(body1) != FR_BODY_DYNAMIC) continue;
+
+        ASSERT_LT(position1.y, 10.0f);
+        ASSERT_GT(position1.y, 10.0f - (ROW_COUNT + 1));
+    }
+
+    for (int k = 0; k < frGetBodyCountInWorld(world1); k++) {
+        frReleaseShape(frGetBodyShape(frGetBodyInWorld(world1, k)));
+        frReleaseShape(frGetBodyShape(frGetBodyInWorld(world2, k)));
+    }
+
+    frReleaseWorld(world1), frReleaseWorld(world2);
+
+    PASS();
+}
+
+TEST utWorldFriction(void) {
+    {
+        const float angle = 25.0f * (M_PI / 180.0f);
+
+        frWorld *world = CreateBoxOnSlope(angle, 0.5f);
+
+        frBody *box = frGetBodyInWorld(world, 1);
+
+        frVector2 position = frGetBodyPosition(box);
+
+        for (int k = 0; k < STEP_COUNT; k++)
+            frStepWorld(world, DELTA_TIME);
+
+        frVector2 delta = frVector2Subtract(frGetBodyPosition(box), position);
+
+        // NOTE: Static friction must hold the box without tipping it over
+        ASSERT_LT(frVector2Magnitude(delta), 0.005f);
+        ASSERT_IN_RANGE(0.0f, sinf(frGetBodyAngle(box) - angle), 1e-4f);
+
+        for (int k = 0; k < frGetBodyCountInWorld(world); k++)
+            frReleaseShape(frGetBodyShape(frGetBodyInWorld(world, k)));
+
+        frReleaseWorld(world);
+    }
+
+    {
+        const float angle = 20.0f * (M_PI / 180.0f), friction = 0.2f;
+
+        frWorld *world = CreateBoxOnSlope(angle, friction);
+
+        frBody *box = frGetBodyInWorld(world, 1);
+
+        for (int k = 0; k < STEP_COUNT / 4; k++)
+            frStepWorld(world, DELTA_TIME);
+
+        frVector2 velocity = frGetBodyVelocity(box);
+
+        float acceleration = FR_WORLD_DEFAULT_GRAVITY.y
+                             * (sinf(angle) - friction * cosf(angle));
+
+        // NOTE: Kinetic friction must slow the box down as expected
+        ASSERT_IN_RANGE(acceleration * (STEP_COUNT / 4) * DELTA_TIME,
+                        velocity.x * cosf(angle) + velocity.y * sinf(angle),
+                        0.05f);
+
+        for (int k = 0; k < frGetBodyCountInWorld(world); k++)
+            frReleaseShape(frGetBodyShape(frGetBodyInWorld(world, k)));
+
+        frReleaseWorld(world);
+    }
+
+    PASS();
+}
+
+TEST utWorldWideSolver(void) {
+    frWorld *world1 = CreateBoxPyramid(FR_SOLVER_GRAPH_COLORING, 1);
+    frWorld *world2 = CreateBoxPyramid(FR_SOLVER_WIDE, 1);
+
+    ASSERT_EQ(FR_SOLVER_WIDE, frGetWorldSolverType(world2));
+
+    for (int k = 0; k < STEP_COUNT; k++) {
+        frStepWorld(world1, DELTA_TIME);
+        frStepWorld(world2, DELTA_TIME);
+    }
+
+    // NOTE: Both solvers must resolve the same pairs in the same order
+    for (int k = 0; k < frGetBodyCountInWorld(world1); k++) {
+        frVector2 position1 = frGetBodyPosition(frGetBodyInWorld(world1, k));
+        frVector2 position2 = frGetBodyPosition(frGetBodyInWorld(world2, k));
+
+        ASSERT_IN_RANGE(position1.x, position2.x, 0.01f);
+        ASSERT_IN_RANGE(position1.y, position2.y, 0.01f);
+    }
+
+    for (int k = 0; k < frGetBodyCountInWorld(world1); k++) {
+        frReleaseShape(frGetBodyShape(frGetBodyInWorld(world1, k)));
+        frReleaseShape(frGetBodyShape(frGetBodyInWorld(world2, k)));
+    }
+
+    frReleaseWorld(world1), frReleaseWorld(world2);
+
+    // NOTE: The friction of the wide solver must match the scalar path
+    world1 = CreateSlidingPyramid(FR_SOLVER_SEQUENTIAL, SLIDING_ROW_COUNT);
+    world2 = CreateSlidingPyramid(FR_SOLVER_WIDE, SLIDING_ROW_COUNT);
+
+    for (int k = 0; k < STEP_COUNT; k++) {
+        frStepWorld(world1, DELTA_TIME);
+        frStepWorld(world2, DELTA_TIME);
+    }
+
+    for (int k = 0; k < frGetBodyCountInWorld(world1); k++) {
+        frVector2 position1 = frGetBodyPosition(frGetBodyInWorld(world1, k));
+        frVector2 position2 = frGetBodyPosition(frGetBodyInWorld(world2, k));
+
+        ASSERT_IN_RANGE(position1.x, position2.x, 0.05f);
+        ASSERT_IN_RANGE(position1.y, position2.y, 0.05f);
+
+        frVector2 velocity = frGetBodyVelocity(frGetBodyInWorld(world2, k));
+
+        ASSERT_IN_RANGE(0.0f, velocity.x, 0.01f);
+    }
+
+    for (int k = 0; k < frGetBodyCountInWorld(world1); k++) {
+        frReleaseShape(frGetBodyShape(frGetBodyInWorld(world1, k)));
+        frReleaseShape(frGetBodyShape(frGetBodyInWorld(world2, k)));
+    }
+
+    frReleaseWorld(world1), frReleaseWorld(world2);
+
+    PASS();
+}
+
+TEST utWorldBodyStorage(void) {
+    frWorld *world1 = frCreateWorld(frStructZero(frVector2), CELL_SIZE);
+    frWorld *world2 = frCreateWorld(frStructZero(frVector2), CELL_SIZE);
+
+    frBody *bodies[BOX_COUNT];
+
+    for (int i = 0; i < BOX_COUNT; i++) {
+        bodies[i] = frCreateBodyFromShape(
+            FR_BODY_DYNAMIC,
+            (frVector2) { .x = 4.0f * i },
+            frCreateRectangle(MATERIAL_BOX, 1.0f, 1.0f));
+
+        frSetBodyVelocity(bodies[i], (frVector2) { .y = 1.0f + i });
+
+        frAddBodyToWorld(world1, bodies[i]);
+    }
+
+    frStepWorld(world1, DELTA_TIME);
+
+    // NOTE: A body cannot be in more than one world at a time
+    frAddBodyToWorld(world2, bodies[0]);
+
+    frStepWorld(world2, DELTA_TIME);
+
+    ASSERT_EQ(0, frGetBodyCountInWorld(world2));
+
+    frRemoveBodyFromWorld(world1, bodies[0]);
+
+    frStepWorld(world1, DELTA_TIME);
+
+    ASSERT_EQ(BOX_COUNT - 1, frGetBodyCountInWorld(world1));
+
+    frVector2 position = frGetBodyPosition(bodies[0]);
+
+    // NOTE: A removed body must keep its data, but not move anymore
+    ASSERT_EQ(1.0f, frGetBodyVelocity(bodies[0]).y);
+
+    for (int k = 0; k < STEP_COUNT; k++)
+        frStepWorld(world1, DELTA_TIME);
+
+    ASSERT_EQ(position.y, frGetBodyPosition(bodies[0]).y);
+
+    for (int i = 1; i < BOX_COUNT; i++) {
+        frVector2 velocity = frGetBodyVelocity(bodies[i]);
+
+        ASSERT_EQ(1.0f + i, velocity.y);
+
+        ASSERT_IN_RANGE((1.0f + i) * (STEP_COUNT + 1) * DELTA_TIME,
+                        frGetBodyPosition(bodies[i]).y,
+                        0.01f);
+    }
+
+    frClearWorld(world1);
+
+    ASSERT_EQ(0, frGetBodyCountInWorld(world1));
+
+    // NOTE: Bodies must be able to move to another world after clearing
+    for (int i = 0; i < BOX_COUNT; i++)
+        frAddBodyToWorld(world2, bodies[i]);
+
+    frStepWorld(world2, DELTA_TIME);
+
+    ASSERT_EQ(BOX_COUNT, frGetBodyCountInWorld(world2));
+
+    for (int i = 0; i < BOX_COUNT; i++)
+        frReleaseShape(frGetBodyShape(bodies[i]));
+
+    frReleaseWorld(world1), frReleaseWorld(world2);
+
+    PASS();
+}
+
+TEST utWorldBatchRemove(void) {
+    const frBroadPhaseType types[] = { FR_BROAD_PHASE_SPATIAL_HASH,
+                                       FR_BROAD_PHASE_DYNAMIC_TREE,
+                                       FR_BROAD_PHASE_SWEEP_AND_PRUNE };
+
+    for (int i = 0, j = (sizeof types / sizeof *types); i < j; i++) {
+        frWorld *world = CreateBoxStack(types[i], BOX_COUNT);
+
+        for (int k = 0; k < STEP_COUNT / 4; k++)
+            frStepWorld(world, DELTA_TIME);
+
+        frBody *bodies[BOX_COUNT + 1], *removedBodies[BOX_COUNT];
+
+        for (int k = 0; k <= BOX_COUNT; k++)
+            bodies[k] = frGetBodyInWorld(world, k);
+
+        for (int k = 0; k < BOX_COUNT / 2; k++)
+            removedBodies[k] = bodies[2 * k + 1];
+
+        // NOTE: Removing the same body twice must not remove another body
+        for (int k = BOX_COUNT / 2; k < BOX_COUNT; k++)
+            removedBodies[k] = bodies[1];
+
+        ASSERT_EQ(BOX_COUNT,
+                  frRemoveBodiesFromWorld(world, removedBodies, BOX_COUNT));
+
+        frStepWorld(world, DELTA_TIME);
+
+        ASSERT_EQ(BOX_COUNT / 2 + 1, frGetBodyCountInWorld(world));
+
+        for (int k = 0; k <= BOX_COUNT; k++) {
+            if (k % 2 == 1) {
+                ASSERT_FALSE(frIsBodyInWorld(world, bodies[k]));
+
+                continue;
+            }
+
+            ASSERT(frIsBodyInWorld(world, bodies[k]));
+
+            int index = frGetBodyStorageIndex(bodies[k]);
+
+            ASSERT_EQ(bodies[k], frGetBodyInWorld(world, index));
+        }
+
+        // NOTE: The remaining boxes must still rest on each other
+        for (int k = 0; k < STEP_COUNT; k++)
+            frStepWorld(world, DELTA_TIME);
+
+        for (int k = 2; k <= BOX_COUNT; k += 2)
+            ASSERT_LT(frGetBodyPosition(bodies[k]).y, 10.0f);
+
+        for (int k = 0; k <= BOX_COUNT; k++) {
+            frReleaseShape(frGetBodyShape(bodies[k]));
+
+            if (k % 2 == 1) frReleaseBody(bodies[k]);
+        }
+
+        frReleaseWorld(world);
+    }
+
+    PASS();
+}
+
+TEST utWorldCapacity(void) {
+    const int bodyCount = (FR_WORLD_DEFAULT_CAPACITY << 1) + 1;
+
+    frWorld *world = frCreateWorldWithCapacity(frStructZero(frVector2), 
+                                               CELL_SIZE,
+                                               BOX_COUNT);
+
+    frShape *s = frCreateRectangle(MATERIAL_BOX, 1.0f, 1.0f);
+
+    // NOTE: There is no upper limit on the number of bodies in a world
+    for (int i = 0; i < bodyCount; i++) {
+        frBody *b = frCreateBodyFromShape(
+            FR_BODY_DYNAMIC,
+            (frVector2) { .x = 2.0f * (i % 64), .y = 2.0f * (i / 64) },
+            s);
+
+        ASSERT(frAddBodyToWorld(world, b));
+    }
+
+    frStepWorld(world, DELTA_TIME);
+
+    ASSERT_EQ(bodyCount, frGetBodyCountInWorld(world));
+
+    frReserveWorld(world, bodyCount << 1);
+
+    ASSERT_EQ(bodyCount, frGetBodyCountInWorld(world));
+
+    for (int i = 0; i < bodyCount; i++)
+        ASSERT_EQ(i, frGetBodyStorageIndex(frGetBodyInWorld(world, i)));
+
+    frReleaseWorld(world);
+
+    frReleaseShape(s);
+
+    PASS();
+}
+
+TEST utWorldBatchAdd(void) {
+    const frBroadPhaseType types[] = { FR_BROAD_PHASE_SPATIAL_HASH,
+                                       FR_BROAD_PHASE_DYNAMIC_TREE,
+                                       FR_BROAD_PHASE_SWEEP_AND_PRUNE };
+
+    const int bodyCount = ROW_COUNT * ROW_COUNT;
+
+    frShape *s = frCreateRectangle(MATERIAL_BOX, 1.0f, 1.0f);
+
+    for (int i = 0, j = (sizeof types / sizeof *types); i < j; i++) {
+        frWorld *world = frCreateWorld(frStructZero(frVector2), CELL_SIZE);
+
+        frSetWorldBroadPhaseType(world, types[i]);
+
+        frBody *bodies[ROW_COUNT * ROW_COUNT];
+
+        // NOTE: Every box overlaps the boxes next to it
+        for (int k = 0; k < bodyCount; k++)
+            bodies[k] = frCreateBodyFromShape(
+                FR_BODY_DYNAMIC,
+                (frVector2) { .x = 0.9f * (k % ROW_COUNT),
+                              .y = 0.9f * (k / ROW_COUNT) },
+                s);
+
+        ASSERT_EQ(bodyCount - 1,
+                  frAddBodiesToWorld(world, bodies + 1, bodyCount - 1));
+
+        frAddBodyToWorld(world, bodies[0]);
+
+        // NOTE: The bodies added in bulk must be found before the next step
+        ASSERT_EQ(bodyCount - 1, frGetBodyCountInWorld(world));
+
+        ASSERT_FALSE(frIsBodyInWorld(world, bodies[0]));
+
+        const frRay ray = { .origin = { .x = -4.0f, .y = 0.9f * BOX_COUNT },
+                            .direction = { .x = 1.0f },
+                            .maxDistance = 4.0f * ROW_COUNT };
+
+        int hitCount = 0;
+
+        frComputeWorldRaycast(world, ray, OnRaycastQuery, &hitCount);
+
+        ASSERT_EQ(ROW_COUNT, hitCount);
+
+        frStepWorld(world, DELTA_TIME);
+
+        ASSERT_EQ(bodyCount, frGetBodyCountInWorld(world));
+
+        for (int k = 0; k < bodyCount; k++)
+            ASSERT(frIsBodyInWorld(world, bodies[k]));
+
+        frStepWorld(world, DELTA_TIME);
+
+        // NOTE: The overlapping boxes must have been pushed apart
+        for (int k = 0; k < bodyCount; k++) {
+            frVector2 velocity = frGetBodyVelocity(bodies[k]);
+
+            if (k % ROW_COUNT == 0) ASSERT_LT(velocity.x, 0.0f);
+            if (k / ROW_COUNT == 0) ASSERT_LT(velocity.y, 0.0f);
+        }
+
+        frReleaseWorld(world);
+    }
+
+    frReleaseShape(s);
+
+    PASS();
+}
+
+TEST utWorldStats(void) {
+    frWorld *world = CreateBoxStack(FR_BROAD_PHASE_SPATIAL_HASH, BOX_COUNT);
+
+    for (int i = 0; i < STEP_COUNT / 4; i++)
+        frStepWorld(world, DELTA_TIME);
+
+    frWorldStats stats = frGetWorldStats(world);
+
+#if FR_WORLD_ENABLE_PROFILING
+    ASSERT_LT(0, stats.candidatePairCount);
+    ASSERT_LT(0, stats.contactCount);
+    ASSERT_LT(0, stats.hashCellCount);
+
+    ASSERT_GTE(stats.candidatePairCount, stats.narrowPhaseTestCount);
+
+    ASSERT_GTE(stats.stepTime,
+               stats.broadPhaseTime + stats.narrowPhaseTime
+                   + stats.solverTime);
+#else
+    // NOTE: The profiling code must compile to nothing when disabled
+    ASSERT_EQ(0, stats.candidatePairCount);
+    ASSERT_EQ(0, stats.contactCount);
+
+    ASSERT_EQ(0.0f, stats.stepTime);
+#endif
+
+    for (int i = 0; i < frGetBodyCountInWorld(world); i++)
+        frReleaseShape(frGetBodyShape(frGetBodyInWorld(world, i)));
+
+    frReleaseWorld(world);
+
+    PASS();
+}
+
+static frWorld *CreateBoxStack(frBroadPhaseType type, int boxCount) {
+    frWorld *world = frCreateWorld(FR_WORLD_DEFAULT_GRAVITY, CELL_SIZE);
+
+    frSetWorldBroadPhaseType(world, type);
+
+    frBody *ground = frCreateBodyFromShape(
+        FR_BODY_STATIC,
+        (frVector2) { .x = 8.0f, .y = 10.5f },
+        frCreateRectangle(MATERIAL_BOX, 16.0f, 1.0f));
+
+    frAddBodyToWorld(world, ground);
+
+    for (int i = 0; i < boxCount; i++) {
+        frBody *box = frCreateBodyFromShape(
+            FR_BODY_DYNAMIC,
+            (frVector2) { .x = 8.0f, .y = 9.5f - (1.0f * i) },
+            frCreateRectangle(MATERIAL_BOX, 1.0f, 1.0f));
+
+        frAddBodyToWorld(world, box);
+    }
+
+    // NOTE: Bodies will be added to `world` at the end of the first step
+    frStepWorld(world, DELTA_TIME);
+
+    return world;
+}
+
+static frWorld *CreateBoxPyramid(frSolverType type, int threadCount) {
+    frWorld *world = frCreateWorld(FR_WORLD_DEFAULT_GRAVITY, CELL_SIZE);
+
+    frSetWorldSolverType(world, type);
+    frSetWorldThreadCount(world, threadCount);
+
+    frBody *ground = frCreateBodyFromShape(
+        FR_BODY_STATIC,
+        (frVector2) { .x = 8.0f, .y = 10.5f },
+        frCreateRectangle(MATERIAL_BOX, 2.0f * ROW_COUNT, 1.0f));
+
+    frAddBodyToWorld(world, ground);
+
+    for (int i = 0; i < ROW_COUNT; i++) {
+        for (int j = 0; j <= i; j++) {
+            frBody *box = frCreateBodyFromShape(
+                FR_BODY_DYNAMIC,
+                (frVector2) { .x = 8.0f - (0.5f * i) + j,
+                              .y = 9.5f - (ROW_COUNT - i - 1) },
+                frCreateRectangle(MATERIAL_BOX, 1.0f, 1.0f));
+
+            frAddBodyToWorld(world, box);
+        }
+    }
+
+    frStepWorld(world, DELTA_TIME);
+
+    return world;
+}
+
+static frWorld *CreateBoxOnSlope(float angle, float friction) {
+    frWorld *world = frCreateWorld(FR_WORLD_DEFAULT_GRAVITY, CELL_SIZE);
+
+    const frMaterial material = { .density = 1.0f, .friction = friction };
+
+    frBody *slope = frCreateBodyFromShape(
+        FR_BODY_STATIC,
+        (frVector2) { .x = 0.0f, .y = 0.0f },
+        frCreateRectangle(material, 4.0f * ROW_COUNT, 1.0f));
+
+    frSetBodyAngle(slope, angle);
+
+    frAddBodyToWorld(world, slope);
+
+    // NOTE: The box starts on the slope, resting on one of its faces
+    frBody *box = frCreateBodyFromShape(
+        FR_BODY_DYNAMIC,
+        (frVector2) { .x = sinf(angle), .y = -cosf(angle) },
+        frCreateRectangle(material, 1.0f, 1.0f));
+
+    frSetBodyAngle(box, angle);
+
+    frAddBodyToWorld(world, box);
+
+    frStepWorld(world, DELTA_TIME);
+
+    return world;
+}
+
+static frWorld *CreateSlidingPyramid(frSolverType type, int rowCount) {
+    frWorld *world = frCreateWorld(FR_WORLD_DEFAULT_GRAVITY, CELL_SIZE);
+
+    frSetWorldSolverType(world, type);
+
+    frBody *ground = frCreateBodyFromShape(
+        FR_BODY_STATIC,
+        (frVector2) { .x = 8.0f, .y = 10.5f },
+        frCreateRectangle(MATERIAL_BOX, 32.0f, 1.0f));
+
+    frAddBodyToWorld(world, ground);
+
+    for (int i = 0; i < rowCount; i++) {
+        for (int j = 0; j <= i; j++) {
+            frBody *box = frCreateBodyFromShape(
+                FR_BODY_DYNAMIC,
+                (frVector2) { .x = 8.0f - (0.5f * i) + j,
+                              .y = 9.5f - (rowCount - i - 1) },
+                frCreateRectangle(MATERIAL_BOX, 1.0f, 1.0f));
+
+            frAddBodyToWorld(world, box);
+        }
+    }
+
+    frStepWorld(world, DELTA_TIME);
+
+    // NOTE: The whole pyramid slides along the ground until friction stops it
+    for (int i = 1; i < frGetBodyCountInWorld(world); i++)
+        frSetBodyVelocity(frGetBodyInWorld(world, i),
+                          (frVector2) { .x = 3.0f });
+
+    return world;
+}
+
+static void OnRaycastQuery(frRaycastHit raycastHit, void *ctx) {
+    int *hitCount = ctx;
+
+    (*hitCount)++;
+
+    if (minDistance > raycastHit.distance) minDistance = raycastHit.distance;
+}